@@ -0,0 +1,124 @@
+// v AutosaveScheduler.cpp
+#include "AutosaveScheduler.h"
+#include <algorithm>
+#include <utility>
+
+void AutosaveScheduler::SetSettings(const AutosaveSettings& settings) {
+    m_settings = settings;
+    m_settings.slotCount = std::max(m_settings.slotCount, 1u);
+    if (!m_settings.enabled) {
+        m_pending = 0;
+        m_waited = 0.0;
+    }
+}
+
+void AutosaveScheduler::OnDayChanged() {
+    if (m_settings.enabled && m_settings.dayInterval > 0 && ++m_dayChanges >= m_settings.dayInterval) {
+        m_dayChanges = 0;
+        Request(DayChanged);
+    }
+}
+
+void AutosaveScheduler::OnHourChanged() {
+    if (m_settings.enabled && m_settings.hourInterval > 0 && ++m_hourChanges >= m_settings.hourInterval) {
+        m_hourChanges = 0;
+        Request(HourChanged);
+    }
+}
+
+void AutosaveScheduler::OnQuestCompleted() {
+    if (m_settings.onQuestCompleted) {
+        Request(QuestCompleted);
+    }
+}
+
+void AutosaveScheduler::Request(Reason reason) {
+    if (m_settings.enabled) {
+        m_pending |= reason;
+    }
+}
+
+uint32_t AutosaveScheduler::Update(float deltaTime, bool busy) {
+    if (m_frameTimes.size() < FrameHistorySize) {
+        m_frameTimes.push_back(deltaTime);
+    } else {
+        m_frameTimes[m_nextFrame] = deltaTime;
+    }
+    m_nextFrame = (m_nextFrame + 1) % FrameHistorySize;
+    m_sinceLastSave += deltaTime;
+    
+    if (!m_settings.enabled) {
+        return 0;
+    }
+    if (m_settings.interval > 0.0 && m_sinceLastSave >= m_settings.interval) {
+        m_pending |= Interval;
+    }
+    if (m_pending == 0 || m_sinceLastSave < m_settings.minSpacing) {
+        return 0;
+    }
+    
+    // Due; wait for a quiet frame, but not forever
+    if (busy || (m_waited < m_settings.maxDelay && !IsQuietFrame())) {
+        m_waited += deltaTime;
+        return 0;
+    }
+    
+    uint32_t reasons = m_pending;
+    m_pending = 0;
+    m_waited = 0.0;
+    m_sinceLastSave = 0.0;
+    m_slotName = m_settings.slotName + std::to_string(m_nextSlot);
+    m_nextSlot = (m_nextSlot + 1) % m_settings.slotCount;
+    return reasons;
+}
+
+void AutosaveScheduler::Reset() {
+    m_pending = 0;
+    m_dayChanges = 0;
+    m_hourChanges = 0;
+    m_sinceLastSave = 0.0;
+    m_waited = 0.0;
+}
+
+std::string AutosaveScheduler::DescribeReasons(uint32_t reasons) {
+    static const std::pair<uint32_t, const char*> names[] = {
+        { DayChanged, "day" },
+        { HourChanged, "hour" },
+        { QuestCompleted, "quest" },
+        { Interval, "interval" },
+        { Manual, "manual" }
+    };
+    
+    std::string description;
+    for (const auto& name : names) {
+        if (reasons & name.first) {
+            if (!description.empty()) {
+                description += ", ";
+            }
+            description += name.second;
+        }
+    }
+    return description;
+}
+
+bool AutosaveScheduler::IsQuietFrame() {
+    size_t quietFrames = std::max<size_t>(m_settings.quietFrames, 1);
+    if (m_frameTimes.size() < quietFrames) {
+        return false;
+    }
+    
+    m_sortScratch.assign(m_frameTimes.begin(), m_frameTimes.end());
+    auto middle = m_sortScratch.begin() + m_sortScratch.size() / 2;
+    std::nth_element(m_sortScratch.begin(), middle, m_sortScratch.end());
+    float limit = *middle * m_settings.spikeRatio;
+    
+    // The most recent frames, newest first
+    for (size_t i = 1; i <= quietFrames; ++i) {
+        size_t index = (m_nextFrame + FrameHistorySize - i) % FrameHistorySize;
+        if (m_frameTimes[index] > limit) {
+            return false;
+        }
+    }
+    return true;
+}
+// ^ AutosaveScheduler.cpp
\ No newline at end of file
@@ -0,0 +1,81 @@
+// v AutosaveScheduler.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+struct AutosaveSettings {
+    bool enabled = false;
+    int dayInterval = 1;          // Autosave every this many day changes, 0 to ignore them
+    int hourInterval = 0;         // Autosave every this many hour changes, 0 to ignore them
+    bool onQuestCompleted = true;
+    double interval = 600.0;      // Seconds of real time without an autosave, 0 to disable
+    double minSpacing = 60.0;     // Seconds between two autosaves, whatever asked for them
+    double maxDelay = 30.0;       // Seconds a due autosave waits for a quiet frame at most
+    float spikeRatio = 1.25f;     // Frames slower than this times the median frame are busy
+    uint32_t quietFrames = 10;    // Frames in a row that must not be busy before saving
+    std::string slotName = "autosave";
+    uint32_t slotCount = 3;       // Autosaves rotate through slotName0 .. slotName<N-1>
+};
+
+// Decides when autosaves happen; SaveLoadSystem feeds it events and frame times and
+// performs the saves. Requests are merged until the autosave starts, and it only starts
+// 'minSpacing' after the previous one, once the last 'quietFrames' frames all stayed
+// close to the median of the recent frame history, so the save's snapshot doesn't add to
+// a frame that is already slow. An autosave kept waiting for 'maxDelay' by a busy
+// stretch starts anyway. Game thread only.
+class AutosaveScheduler {
+public:
+    enum Reason : uint32_t {
+        DayChanged = 1 << 0,
+        HourChanged = 1 << 1,
+        QuestCompleted = 1 << 2,
+        Interval = 1 << 3,
+        Manual = 1 << 4
+    };
+    
+    void SetSettings(const AutosaveSettings& settings);
+    const AutosaveSettings& GetSettings() const { return m_settings; }
+    
+    // Event hooks; they request an autosave when the configured cadence is reached
+    void OnDayChanged();
+    void OnHourChanged();
+    void OnQuestCompleted();
+    void Request(Reason reason);
+    uint32_t GetPendingReasons() const { return m_pending; }
+    
+    // Called once per frame with its duration. Returns the reasons of the autosave to
+    // start this frame, or 0. While 'busy' (a save or load already running), due
+    // autosaves keep waiting.
+    uint32_t Update(float deltaTime, bool busy);
+    
+    // Slot of the autosave Update() last started
+    const std::string& GetSlotName() const { return m_slotName; }
+    
+    // Forgets pending requests and cadence counts, and restarts the spacing clock
+    void Reset();
+    
+    static std::string DescribeReasons(uint32_t reasons);
+
+private:
+    static constexpr size_t FrameHistorySize = 120;
+    
+    bool IsQuietFrame();
+    
+    AutosaveSettings m_settings;
+    uint32_t m_pending = 0;
+    int m_dayChanges = 0;
+    int m_hourChanges = 0;
+    double m_sinceLastSave = 0.0;
+    double m_waited = 0.0;        // Time a due autosave has been held back by load
+    
+    // Ring buffer of recent frame times
+    std::vector<float> m_frameTimes;
+    std::vector<float> m_sortScratch;
+    size_t m_nextFrame = 0;
+    
+    uint32_t m_nextSlot = 0;
+    std::string m_slotName;
+};
+// ^ AutosaveScheduler.h
\ No newline at end of file
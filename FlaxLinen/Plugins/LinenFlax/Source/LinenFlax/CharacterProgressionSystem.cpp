@@ -3,6 +3,7 @@
 #include "QuestEvents.h"
 #include "LinenFlax.h"
 #include "Engine/Core/Log.h"
+#include "json.hpp"
 
 Skill::Skill(const std::string& id, const std::string& name, const std::string& description)
     : m_id(id)
@@ -11,36 +12,29 @@ Skill::Skill(const std::string& id, const std::string& name, const std::string&
     , m_level(0)
 {
 }
-// Skill binary serialization
+// Skill serialization, generated from Skill::Fields()
 void Skill::Serialize(BinaryWriter& writer) const {
-    writer.Write(m_id);
-    writer.Write(m_name);
-    writer.Write(m_description);
-    writer.Write(m_level);
+    FieldSerializer::WriteBinary(writer, *this);
 }
 
-// Skill binary deserialization
 void Skill::Deserialize(BinaryReader& reader) {
-    reader.Read(m_id);
-    reader.Read(m_name);
-    reader.Read(m_description);
-    reader.Read(m_level);
+    FieldSerializer::ReadBinary(reader, *this);
 }
 
-// Skill text serialization
 void Skill::SerializeToText(TextWriter& writer) const {
-    writer.Write("skillId", m_id);
-    writer.Write("skillName", m_name);
-    writer.Write("skillDescription", m_description);
-    writer.Write("skillLevel", m_level);
+    FieldSerializer::WriteText(writer, *this);
 }
 
-// Skill text deserialization
 void Skill::DeserializeFromText(TextReader& reader) {
-    reader.Read("skillId", m_id);
-    reader.Read("skillName", m_name);
-    reader.Read("skillDescription", m_description);
-    reader.Read("skillLevel", m_level);
+    FieldSerializer::ReadText(reader, *this);
+}
+
+void Skill::SerializeToJson(JsonWriter& writer) const {
+    FieldSerializer::WriteJson(writer, *this);
+}
+
+void Skill::DeserializeFromJson(const nlohmann::json& value) {
+    FieldSerializer::ReadJsonObject(*this, value);
 }
 
 CharacterProgressionSystem::CharacterProgressionSystem() {
@@ -67,6 +61,8 @@ void CharacterProgressionSystem::Initialize() {
 void CharacterProgressionSystem::Shutdown() {
     m_skills.clear();
     m_skillLevels.clear();
+    m_skillsRevision++;
+    ClearDirty();
     LOG(Info, "Character Progression System Shutdown.");
 }
 
@@ -80,26 +76,40 @@ bool CharacterProgressionSystem::AddSkill(const std::string& id, const std::stri
         return false;
     }
     
-    auto skill = std::make_unique<Skill>(id, name, description);
-    m_skills[id] = std::move(skill);
+    m_skills[id] = Skill(id, name, description);
     m_skillLevels[id] = 0;
+    m_dirtySkills.insert(id);
+    
+    SkillLevelChangedEvent event;
+    event.skillId = id;
+    event.added = true;
+    m_plugin->GetEventSystem().PublishImmediate(event);
     
     LOG(Info, "Added skill: {0}", String(name.c_str()));
     return true;
 }
 
 bool CharacterProgressionSystem::IncreaseSkill(const std::string& id, int amount) {    
-    auto it = m_skills.find(id);
-    if (it == m_skills.end()) {
+    Skill* skill = m_skills.Edit(id);
+    if (!skill) {
         LOG(Warning, "Skill not found: {0}", String(id.c_str()));
         return false;
     }
     
-    it->second->IncreaseLevel(amount);
-    m_skillLevels[id] = it->second->GetLevel();
+    int oldLevel = skill->GetLevel();
+    skill->IncreaseLevel(amount);
+    int newLevel = skill->GetLevel();
+    m_skillLevels[id] = newLevel;
+    m_dirtySkills.insert(id);
+    
+    SkillLevelChangedEvent event;
+    event.skillId = id;
+    event.oldLevel = oldLevel;
+    event.newLevel = newLevel;
+    m_plugin->GetEventSystem().PublishImmediate(event);
     
     LOG(Info, "Increased skill {0} by {1} to level {2}", 
-        String(id.c_str()), amount, it->second->GetLevel());
+        String(id.c_str()), amount, newLevel);
     return true;
 }
 
@@ -108,12 +118,13 @@ int CharacterProgressionSystem::GetSkillLevel(const std::string& id) const {
     if (it == m_skills.end()) {
         return 0;
     }    
-    return it->second->GetLevel();
+    return it->second.GetLevel();
 }
 
 void CharacterProgressionSystem::GainExperience(int amount) {
     int oldLevel = m_level;
     m_experience += amount;
+    m_progressDirty = true;
     
     // Simple level up formula: level = sqrt(experience / 100)
     m_level = 1 + static_cast<int>(sqrt(m_experience / 100.0));
@@ -133,7 +144,7 @@ int CharacterProgressionSystem::GetLevel() const {
     return m_level;
 }
 
-const std::unordered_map<std::string, int>& CharacterProgressionSystem::GetSkills() const {
+const SnapshotMap<int>& CharacterProgressionSystem::GetSkills() const {
     return m_skillLevels;
 }
 
@@ -146,159 +157,118 @@ void CharacterProgressionSystem::HandleQuestCompleted(const QuestCompletedEvent&
 }
 
 void CharacterProgressionSystem::Serialize(BinaryWriter& writer) const {
-    // Write basic character data
-    writer.Write(m_experience);
-    writer.Write(m_level);
-    
-    // Write skills
-    writer.Write(static_cast<uint32_t>(m_skills.size()));
-    for (const auto& pair : m_skills) {
-        writer.Write(pair.first);  // Skill ID
-        writer.Write(pair.second->GetId());
-        writer.Write(pair.second->GetName());
-        writer.Write(pair.second->GetDescription());
-        writer.Write(pair.second->GetLevel());
+    FieldSerializer::WriteBinary(writer, *this);
+    LOG(Info, "CharacterProgressionSystem serialized");
+}
+
+void CharacterProgressionSystem::Deserialize(BinaryReader& reader) {
+    ClearDirty();
+    FieldSerializer::ReadBinary(reader, *this);
+    m_skillsRevision++;
+    LOG(Info, "CharacterProgressionSystem deserialized");
+}
+
+std::function<void()> CharacterProgressionSystem::DecodeDeferred(BinaryReader& reader) {
+    auto values = std::make_shared<FieldSerializer::FieldValues<CharacterProgressionSystem>>();
+    FieldSerializer::ReadBinaryValues<CharacterProgressionSystem>(reader, *values);
+    return [this, values]() {
+        ClearDirty();
+        FieldSerializer::AssignValues(*this, *values);
+        m_skillsRevision++;
+        LOG(Info, "CharacterProgressionSystem deserialized");
+    };
+}
+
+std::function<void(BinaryWriter&)> CharacterProgressionSystem::SnapshotState() const {
+    return [values = FieldSerializer::SnapshotValues(*this)](BinaryWriter& writer) {
+        FieldSerializer::WriteBinaryValues(writer, values);
+        LOG(Info, "CharacterProgressionSystem serialized");
+    };
+}
+
+void CharacterProgressionSystem::SerializeDelta(BinaryWriter& writer) const {
+    writer.Write(m_progressDirty);
+    if (m_progressDirty) {
+        FieldSerializer::WriteBinary<ProgressGroup>(writer, *this);
     }
     
-    // Write skill levels cache
-    writer.Write(static_cast<uint32_t>(m_skillLevels.size()));
-    for (const auto& pair : m_skillLevels) {
-        writer.Write(pair.first);  // Skill ID
-        writer.Write(pair.second); // Skill level
+    writer.Write(static_cast<uint32_t>(m_dirtySkills.size()));
+    for (const auto& skillId : m_dirtySkills) {
+        writer.Write(skillId);
+        
+        auto it = m_skills.find(skillId);
+        bool exists = it != m_skills.end();
+        writer.Write(exists);
+        if (exists) {
+            it->second.Serialize(writer);
+        }
     }
     
-    LOG(Info, "CharacterProgressionSystem serialized");
+    LOG(Info, "CharacterProgressionSystem delta serialized: {0} skills", static_cast<int>(m_dirtySkills.size()));
 }
 
-// CharacterProgressionSystem binary deserialization
-void CharacterProgressionSystem::Deserialize(BinaryReader& reader) {
-    // Clear existing data
-    m_skills.clear();
-    m_skillLevels.clear();
-    
-    // Read basic character data
-    reader.Read(m_experience);
-    reader.Read(m_level);
+void CharacterProgressionSystem::DeserializeDelta(BinaryReader& reader) {
+    bool progressChanged = false;
+    reader.Read(progressChanged);
+    if (progressChanged) {
+        FieldSerializer::ReadBinary<ProgressGroup>(reader, *this);
+    }
     
-    // Read skills
     uint32_t skillCount = 0;
     reader.Read(skillCount);
     
-    for (uint32_t i = 0; i < skillCount; ++i) {
+    for (uint32_t i = 0; i < skillCount && !reader.HasFailed(); ++i) {
         std::string skillId;
+        bool exists = false;
         reader.Read(skillId);
+        reader.Read(exists);
         
-        std::string id, name, description;
-        int level;
-        reader.Read(id);
-        reader.Read(name);
-        reader.Read(description);
-        reader.Read(level);
-        
-        auto skill = std::make_unique<Skill>(id, name, description);
-        skill->SetLevel(level);
-        
-        m_skills[skillId] = std::move(skill);
-    }
-    
-    // Read skill levels cache
-    uint32_t levelCount = 0;
-    reader.Read(levelCount);
-    
-    for (uint32_t i = 0; i < levelCount; ++i) {
-        std::string skillId;
-        int level = 0;
-        reader.Read(skillId);
-        reader.Read(level);
-        m_skillLevels[skillId] = level;
+        if (exists) {
+            Skill skill;
+            skill.Deserialize(reader);
+            m_skillLevels[skillId] = skill.GetLevel();
+            m_skills[skillId] = std::move(skill);
+        } else {
+            m_skills.erase(skillId);
+            m_skillLevels.erase(skillId);
+        }
     }
     
-    LOG(Info, "CharacterProgressionSystem deserialized");
+    m_skillsRevision++;
+    LOG(Info, "CharacterProgressionSystem delta deserialized: {0} skills", static_cast<int>(skillCount));
 }
 
-// CharacterProgressionSystem text serialization
 void CharacterProgressionSystem::SerializeToText(TextWriter& writer) const {
-    // Write basic character data
-    writer.Write("characterExperience", m_experience);
-    writer.Write("characterLevel", m_level);
-    
-    // Write skill count
-    writer.Write("skillCount", static_cast<int>(m_skills.size()));
-    
-    // Write each skill
-    int index = 0;
-    for (const auto& pair : m_skills) {
-        std::string prefix = "skill" + std::to_string(index) + "_";
-        writer.Write(prefix + "id", pair.first);
-        writer.Write(prefix + "name", pair.second->GetName());
-        writer.Write(prefix + "description", pair.second->GetDescription());
-        writer.Write(prefix + "level", pair.second->GetLevel());
-        index++;
-    }
-    
-    // Write skill levels count
-    writer.Write("skillLevelsCount", static_cast<int>(m_skillLevels.size()));
-    
-    // Write skill levels
-    index = 0;
-    for (const auto& pair : m_skillLevels) {
-        std::string prefix = "skillLevel" + std::to_string(index) + "_";
-        writer.Write(prefix + "id", pair.first);
-        writer.Write(prefix + "level", pair.second);
-        index++;
-    }
-    
+    FieldSerializer::WriteText(writer, *this);
     LOG(Info, "CharacterProgressionSystem serialized to text");
 }
 
 void CharacterProgressionSystem::DeserializeFromText(TextReader& reader) {
-    // Clear existing data
     m_skills.clear();
     m_skillLevels.clear();
+    ClearDirty();
     
-    // Read basic character data
-    reader.Read("characterExperience", m_experience);
-    reader.Read("characterLevel", m_level);
-    
-    // Read skill count
-    int skillCount = 0;
-    reader.Read("skillCount", skillCount);
-    
-    // Read each skill
-    for (int i = 0; i < skillCount; i++) {
-        std::string prefix = "skill" + std::to_string(i) + "_";
-        
-        std::string id, name, description;
-        int level = 0;
-        
-        reader.Read(prefix + "id", id);
-        reader.Read(prefix + "name", name);
-        reader.Read(prefix + "description", description);
-        reader.Read(prefix + "level", level);
-        
-        auto skill = std::make_unique<Skill>(id, name, description);
-        skill->SetLevel(level);
-        
-        m_skills[id] = std::move(skill);
-    }
-    
-    // Read skill levels count
-    int skillLevelsCount = 0;
-    reader.Read("skillLevelsCount", skillLevelsCount);
-    
-    // Read skill levels
-    for (int i = 0; i < skillLevelsCount; i++) {
-        std::string prefix = "skillLevel" + std::to_string(i) + "_";
-        
-        std::string id;
-        int level = 0;
-        
-        reader.Read(prefix + "id", id);
-        reader.Read(prefix + "level", level);
-        
-        m_skillLevels[id] = level;
-    }
-    
+    FieldSerializer::ReadText(reader, *this);
+    m_skillsRevision++;
     LOG(Info, "CharacterProgressionSystem deserialized from text");
 }
+
+void CharacterProgressionSystem::SerializeToJson(JsonWriter& writer) const {
+    FieldSerializer::WriteJson(writer, *this);
+}
+
+void CharacterProgressionSystem::BeginJsonLoad() {
+    FieldSerializer::ClearContainers(*this);
+}
+
+void CharacterProgressionSystem::DeserializeJsonField(const std::string& field, const nlohmann::json& value) {
+    // Skills arrive one object per call
+    FieldSerializer::ReadJsonField(*this, field, value);
+}
+
+void CharacterProgressionSystem::EndJsonLoad() {
+    ClearDirty();
+    m_skillsRevision++;
+    LOG(Info, "CharacterProgressionSystem deserialized from JSON: {0} skills", static_cast<int>(m_skills.size()));
+}
 // ^ CharacterProgressionSystem.cpp
\ No newline at end of file
@@ -3,15 +3,28 @@
 
 #include "RPGSystem.h"
 #include "QuestEvents.h"
-#include "Serialization.h"
+#include "Reflection.h"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <vector>
 #include <memory>
 
+// Fired immediately, not queued, when a skill is added or changes level, so systems that
+// follow skill levels are up to date within the same call. Loads replace the skills without
+// firing it; see CharacterProgressionSystem::GetSkillsRevision.
+class SkillLevelChangedEvent : public EventType<SkillLevelChangedEvent> {
+public:
+    std::string skillId;
+    int oldLevel = 0;
+    int newLevel = 0;
+    bool added = false;
+};
+
 class Skill {
 public:
+    Skill() = default;
     Skill(const std::string& id, const std::string& name, const std::string& description);
     
     std::string GetId() const { return m_id; }
@@ -26,6 +39,17 @@ public:
     void Deserialize(BinaryReader& reader);
     void SerializeToText(TextWriter& writer) const;
     void DeserializeFromText(TextReader& reader);
+    void SerializeToJson(JsonWriter& writer) const;
+    void DeserializeFromJson(const nlohmann::json& value);
+    
+    // Serialized fields, in save order
+    static constexpr auto Fields() {
+        return std::make_tuple(
+            MakeField("id", &Skill::m_id),
+            MakeField("name", &Skill::m_name),
+            MakeField("description", &Skill::m_description),
+            MakeField("level", &Skill::m_level));
+    }
 
 private:
     std::string m_id;
@@ -60,8 +84,9 @@ public:
     bool IncreaseSkill(const std::string& id, int amount = 1);
     int GetSkillLevel(const std::string& id) const;
     
-    // Requirements checking
-    const std::unordered_map<std::string, int>& GetSkills() const;
+    // Requirements checking. The revision changes whenever a load replaces the skills.
+    const SnapshotMap<int>& GetSkills() const;
+    uint32_t GetSkillsRevision() const { return m_skillsRevision; }
 
     // Experience management
     void GainExperience(int amount);
@@ -73,6 +98,27 @@ public:
     void Deserialize(BinaryReader& reader) override;
     void SerializeToText(TextWriter& writer) const;
     void DeserializeFromText(TextReader& reader);
+    void SerializeToJson(JsonWriter& writer) const override;
+    void BeginJsonLoad() override;
+    void DeserializeJsonField(const std::string& field, const nlohmann::json& value) override;
+    void EndJsonLoad() override;
+    
+    // Incremental saves only write changed skills and experience
+    bool IsDirty() const override { return m_progressDirty || !m_dirtySkills.empty(); }
+    void ClearDirty() override { m_progressDirty = false; m_dirtySkills.clear(); }
+    void SerializeDelta(BinaryWriter& writer) const override;
+    void DeserializeDelta(BinaryReader& reader) override;
+    std::function<void()> DecodeDeferred(BinaryReader& reader) override;
+    std::function<void(BinaryWriter&)> SnapshotState() const override;
+    
+    // Serialized fields, in save order. Experience and level form the delta progress block.
+    static constexpr auto Fields() {
+        return std::make_tuple(
+            MakeField<ProgressGroup>("experience", &CharacterProgressionSystem::m_experience),
+            MakeField<ProgressGroup>("level", &CharacterProgressionSystem::m_level),
+            MakeField<SkillGroup>("skills", &CharacterProgressionSystem::m_skills),
+            MakeField<SkillGroup>("skillLevels", &CharacterProgressionSystem::m_skillLevels));
+    }
     
     // Cleanup method
     static void Destroy() {
@@ -93,7 +139,19 @@ private:
     // Character data
     int m_experience = 0;
     int m_level = 1;
-    std::unordered_map<std::string, std::unique_ptr<Skill>> m_skills;
-    std::unordered_map<std::string, int> m_skillLevels; // Cache for requirements checking
+    // Copy-on-write, so saves can snapshot them without stopping the game
+    SnapshotMap<Skill> m_skills;
+    SnapshotMap<int> m_skillLevels; // Cache for requirements checking
+    uint32_t m_skillsRevision = 0;
+    
+    // Field groups
+    enum FieldGroup : uint32_t {
+        ProgressGroup = 1 << 0, // Experience and level
+        SkillGroup = 1 << 1     // Skills and the level cache
+    };
+    
+    // Changes since the last incremental save
+    bool m_progressDirty = false;
+    std::unordered_set<std::string> m_dirtySkills;
 };
 // ^ CharacterProgressionSystem.h
\ No newline at end of file
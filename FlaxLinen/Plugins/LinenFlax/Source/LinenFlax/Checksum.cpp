@@ -0,0 +1,234 @@
+// v Checksum.cpp
+#include "Checksum.h"
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #define LINEN_CRC32C_X86 1
+    #include <nmmintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+    #define LINEN_CRC32C_ARM 1
+    #include <arm_acle.h>
+#endif
+
+namespace {
+
+// Reflected CRC32C polynomial
+constexpr uint32_t Crc32cPolynomial = 0x82F63B78u;
+
+struct Crc32cTables {
+    uint32_t table[8][256];
+};
+
+// Slicing-by-8 lookup tables, built at compile time
+constexpr Crc32cTables BuildCrc32cTables() {
+    Crc32cTables tables{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ Crc32cPolynomial : (crc >> 1);
+        }
+        tables.table[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+        for (int slice = 1; slice < 8; ++slice) {
+            uint32_t previous = tables.table[slice - 1][i];
+            tables.table[slice][i] = (previous >> 8) ^ tables.table[0][previous & 0xFF];
+        }
+    }
+    return tables;
+}
+
+constexpr Crc32cTables s_crcTables = BuildCrc32cTables();
+
+uint32_t Crc32cSoftware(const uint8_t* data, size_t size, uint32_t crc) {
+    const auto& t = s_crcTables.table;
+
+    // Consume 8 bytes per step
+    while (size >= 8) {
+        uint32_t low;
+        uint32_t high;
+        std::memcpy(&low, data, 4);
+        std::memcpy(&high, data + 4, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        low = __builtin_bswap32(low);
+        high = __builtin_bswap32(high);
+#endif
+        low ^= crc;
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^
+              t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+              t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^
+              t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+        data += 8;
+        size -= 8;
+    }
+
+    // Tail
+    while (size-- > 0) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(LINEN_CRC32C_X86)
+
+bool DetectSse42() {
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (ecx & bit_SSE4_2) != 0;
+#endif
+}
+
+#if !defined(_MSC_VER)
+__attribute__((target("sse4.2")))
+#endif
+uint32_t Crc32cHardware(const uint8_t* data, size_t size, uint32_t crc) {
+    uint64_t crc64 = crc;
+    while (size >= 8) {
+        uint64_t value;
+        std::memcpy(&value, data, 8);
+        crc64 = _mm_crc32_u64(crc64, value);
+        data += 8;
+        size -= 8;
+    }
+    crc = static_cast<uint32_t>(crc64);
+    while (size-- > 0) {
+        crc = _mm_crc32_u8(crc, *data++);
+    }
+    return crc;
+}
+
+const bool s_hasHardwareCrc = DetectSse42();
+
+#elif defined(LINEN_CRC32C_ARM)
+
+uint32_t Crc32cHardware(const uint8_t* data, size_t size, uint32_t crc) {
+    while (size >= 8) {
+        uint64_t value;
+        std::memcpy(&value, data, 8);
+        crc = __crc32cd(crc, value);
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0) {
+        crc = __crc32cb(crc, *data++);
+    }
+    return crc;
+}
+
+const bool s_hasHardwareCrc = true;
+
+#else
+
+const bool s_hasHardwareCrc = false;
+
+#endif
+
+} // namespace
+
+uint32_t ComputeCrc32c(const void* data, size_t size, uint32_t crc) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+
+#if defined(LINEN_CRC32C_X86) || defined(LINEN_CRC32C_ARM)
+    if (s_hasHardwareCrc) {
+        return ~Crc32cHardware(bytes, size, crc);
+    }
+#endif
+
+    return ~Crc32cSoftware(bytes, size, crc);
+}
+
+bool HasHardwareCrc32c() {
+    return s_hasHardwareCrc;
+}
+
+namespace {
+
+constexpr uint64_t MurmurC1 = 0x87C37B91114253D5ull;
+constexpr uint64_t MurmurC2 = 0x4CF5AD432745937Full;
+
+inline uint64_t RotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// Assembled byte by byte so the hash doesn't depend on the host's byte order
+inline uint64_t LoadLittleEndian64(const uint8_t* bytes) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+inline uint64_t FinalMix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+} // namespace
+
+ContentHash ComputeContentHash(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t h1 = 0;
+    uint64_t h2 = 0;
+
+    size_t blockCount = size / 16;
+    for (size_t i = 0; i < blockCount; ++i) {
+        uint64_t k1 = LoadLittleEndian64(bytes + i * 16);
+        uint64_t k2 = LoadLittleEndian64(bytes + i * 16 + 8);
+
+        h1 ^= RotateLeft(k1 * MurmurC1, 31) * MurmurC2;
+        h1 = (RotateLeft(h1, 27) + h2) * 5 + 0x52DCE729;
+        h2 ^= RotateLeft(k2 * MurmurC2, 33) * MurmurC1;
+        h2 = (RotateLeft(h2, 31) + h1) * 5 + 0x38495AB5;
+    }
+
+    // Up to 15 trailing bytes: the first 8 go in k1, the rest in k2
+    const uint8_t* tail = bytes + blockCount * 16;
+    size_t tailSize = size & 15;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    for (size_t i = tailSize; i > 8; --i) {
+        k2 = (k2 << 8) | tail[i - 1];
+    }
+    for (size_t i = tailSize < 8 ? tailSize : 8; i > 0; --i) {
+        k1 = (k1 << 8) | tail[i - 1];
+    }
+    if (tailSize > 8) {
+        h2 ^= RotateLeft(k2 * MurmurC2, 33) * MurmurC1;
+    }
+    if (tailSize > 0) {
+        h1 ^= RotateLeft(k1 * MurmurC1, 31) * MurmurC2;
+    }
+
+    h1 ^= size;
+    h2 ^= size;
+    h1 += h2;
+    h2 += h1;
+    h1 = FinalMix(h1);
+    h2 = FinalMix(h2);
+    h1 += h2;
+    h2 += h1;
+
+    ContentHash hash;
+    hash.low = h1;
+    hash.high = h2;
+    return hash;
+}
+// ^ Checksum.cpp
\ No newline at end of file
@@ -0,0 +1,31 @@
+// v Checksum.h
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// CRC32C (Castagnoli) checksum used to verify save file chunks.
+// Pass the previous result as 'crc' to checksum data in several pieces.
+uint32_t ComputeCrc32c(const void* data, size_t size, uint32_t crc = 0);
+
+// True when ComputeCrc32c runs on the CPU's CRC32 instructions (SSE4.2 / ARMv8)
+// rather than the slicing-by-8 table fallback
+bool HasHardwareCrc32c();
+
+// 128-bit hash identifying stored data by its content (MurmurHash3 x64_128). Fast and
+// well distributed, but not cryptographic. The same bytes hash the same on every platform.
+struct ContentHash {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const ContentHash& other) const { return low == other.low && high == other.high; }
+    bool operator!=(const ContentHash& other) const { return !(*this == other); }
+};
+
+// For unordered containers keyed by ContentHash
+struct ContentHashHasher {
+    size_t operator()(const ContentHash& hash) const { return static_cast<size_t>(hash.low); }
+};
+
+ContentHash ComputeContentHash(const void* data, size_t size);
+// ^ Checksum.h
\ No newline at end of file
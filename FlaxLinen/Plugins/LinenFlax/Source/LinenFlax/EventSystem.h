@@ -8,6 +8,7 @@
 #include <typeindex>
 #include <memory>
 #include <queue>
+#include <cstdint>
 
 // Event Priority enum class
 enum class EventPriority {
@@ -90,7 +91,7 @@ public:
 
         // Queue the event
         std::type_index type = std::type_index(typeid(T));
-        m_eventQueue.push(QueuedEvent(eventPtr, type, filter));
+        m_eventQueue.push(QueuedEvent(eventPtr, type, filter, m_nextSequence++));
     }
 
     template <typename T>
@@ -154,16 +155,21 @@ private:
         std::shared_ptr<Event> event;
         std::type_index type;
         std::string filter;
+        uint64_t sequence;
 
         // Constructor to capture priority from the event
-        QueuedEvent(std::shared_ptr<Event> e, std::type_index t, const std::string& f)
-            : event(e), type(t), filter(f) {
+        QueuedEvent(std::shared_ptr<Event> e, std::type_index t, const std::string& f, uint64_t s)
+            : event(e), type(t), filter(f), sequence(s) {
         }
 
         // Comparison operator for priority queue
         bool operator<(const QueuedEvent& other) const {
-            // Higher priority value means higher actual priority in std::priority_queue
-            return event->GetPriority() < other.event->GetPriority();
+            // Higher priority value means higher actual priority in std::priority_queue;
+            // events of equal priority go out in the order they were published
+            if (event->GetPriority() != other.event->GetPriority()) {
+                return event->GetPriority() < other.event->GetPriority();
+            }
+            return sequence > other.sequence;
         }
     };
 
@@ -173,6 +179,7 @@ private:
 
     // Priority queue for event processing
     std::priority_queue<QueuedEvent> m_eventQueue;
+    uint64_t m_nextSequence = 0;
 };
 
 /*
@@ -0,0 +1,187 @@
+// v JsonSerialization.cpp
+#include "JsonSerialization.h"
+#include "json.hpp"
+
+namespace {
+
+using json = nlohmann::json;
+
+// SAX handler that walks the fixed save layout (root -> section -> field -> element)
+// itself and only builds a json value for one record at a time
+class JsonSaveSaxHandler : public nlohmann::json_sax<json> {
+public:
+    explicit JsonSaveSaxHandler(const JsonSaveHandlers& handlers) : m_handlers(handlers) {}
+    
+    const std::string& GetError() const { return m_error; }
+    
+    bool null() override { return Value(json(nullptr)); }
+    bool boolean(bool value) override { return Value(json(value)); }
+    bool number_integer(number_integer_t value) override { return Value(json(value)); }
+    bool number_unsigned(number_unsigned_t value) override { return Value(json(value)); }
+    bool number_float(number_float_t value, const string_t&) override { return Value(json(value)); }
+    bool string(string_t& value) override { return Value(json(std::move(value))); }
+    bool binary(binary_t& value) override { return Value(json(std::move(value))); }
+    
+    bool start_object(std::size_t) override { return Open(json::value_t::object); }
+    bool start_array(std::size_t) override { return Open(json::value_t::array); }
+    bool end_object() override { return Close(); }
+    bool end_array() override { return Close(); }
+    
+    bool key(string_t& value) override {
+        if (!m_record.empty()) {
+            m_recordKey = std::move(value);
+        } else if (m_depth == Root) {
+            m_rootKey = std::move(value);
+        } else if (m_depth == Section) {
+            m_field = std::move(value);
+        }
+        return true;
+    }
+    
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override {
+        m_error = e.what();
+        return false;
+    }
+    
+private:
+    // Containers open outside of a record
+    enum Depth {
+        Outside = 0,
+        Root,
+        Section,
+        FieldArray
+    };
+    
+    bool Value(json&& value) {
+        if (!m_record.empty()) {
+            AddToRecord(std::move(value));
+            return true;
+        }
+        
+        switch (m_depth) {
+            case Root:
+                if (m_handlers.onHeader) {
+                    m_handlers.onHeader(m_rootKey, value);
+                }
+                return true;
+            case Section:
+            case FieldArray:
+                if (m_handlers.onField) {
+                    m_handlers.onField(m_section, m_field, value);
+                }
+                return true;
+            default:
+                m_error = "save root must be an object";
+                return false;
+        }
+    }
+    
+    bool Open(json::value_t type) {
+        if (!m_record.empty()) {
+            m_record.push_back(AddToRecord(json(type)));
+            return true;
+        }
+        
+        bool isObject = type == json::value_t::object;
+        switch (m_depth) {
+            case Outside:
+                if (!isObject) {
+                    m_error = "save root must be an object";
+                    return false;
+                }
+                m_depth = Root;
+                return true;
+            case Root:
+                if (isObject) {
+                    m_section = m_rootKey;
+                    m_depth = Section;
+                    if (m_handlers.onSectionBegin) {
+                        m_handlers.onSectionBegin(m_section);
+                    }
+                    return true;
+                }
+                break;
+            case Section:
+                if (!isObject) {
+                    m_depth = FieldArray;
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+        
+        // Everything else is a record: build it, then hand it over on close
+        m_current = json(type);
+        m_record.push_back(&m_current);
+        return true;
+    }
+    
+    bool Close() {
+        if (!m_record.empty()) {
+            m_record.pop_back();
+            if (m_record.empty()) {
+                json record = std::move(m_current);
+                m_current = json();
+                return Value(std::move(record));
+            }
+            return true;
+        }
+        
+        switch (m_depth) {
+            case FieldArray:
+                m_depth = Section;
+                break;
+            case Section:
+                m_depth = Root;
+                if (m_handlers.onSectionEnd) {
+                    m_handlers.onSectionEnd(m_section);
+                }
+                break;
+            default:
+                m_depth = Outside;
+                break;
+        }
+        return true;
+    }
+    
+    json* AddToRecord(json&& value) {
+        json& parent = *m_record.back();
+        if (parent.is_object()) {
+            json& slot = parent[m_recordKey];
+            slot = std::move(value);
+            return &slot;
+        }
+        parent.push_back(std::move(value));
+        return &parent.back();
+    }
+    
+    const JsonSaveHandlers& m_handlers;
+    Depth m_depth = Outside;
+    std::string m_rootKey;
+    std::string m_section;
+    std::string m_field;
+    
+    // Record currently being built, and the path to its innermost open container
+    json m_current;
+    std::vector<json*> m_record;
+    std::string m_recordKey;
+    
+    std::string m_error;
+};
+
+} // namespace
+
+bool ReadJsonSave(std::istream& input, const JsonSaveHandlers& handlers, std::string& error) {
+    JsonSaveSaxHandler handler(handlers);
+    if (!json::sax_parse(input, &handler)) {
+        error = handler.GetError().empty() ? "malformed JSON" : handler.GetError();
+        return false;
+    }
+    return true;
+}
+
+bool ValidateJson(std::istream& input) {
+    return json::accept(input);
+}
+// ^ JsonSerialization.cpp
\ No newline at end of file
@@ -0,0 +1,172 @@
+// v JsonSerialization.h
+#pragma once
+
+#include "json_fwd.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <istream>
+#include <charconv>
+#include <cmath>
+#include <type_traits>
+#include "Serialization.h"
+
+// Streaming JSON writer. Output goes straight into one buffer as values are written,
+// no document tree is built. Indented two spaces per level so saves stay diffable.
+class JsonWriter {
+public:
+    JsonWriter() {}
+    
+    void Reserve(size_t bytes) { m_buffer.reserve(bytes); }
+    
+    // Containers as array elements (or the root value)
+    void BeginObject() { BeginValue(); Open('{'); }
+    void BeginArray() { BeginValue(); Open('['); }
+    
+    // Containers as object members
+    void BeginObject(std::string_view key) { WriteKey(key); Open('{'); }
+    void BeginArray(std::string_view key) { WriteKey(key); Open('['); }
+    
+    void EndObject() { Close('}'); }
+    void EndArray() { Close(']'); }
+    
+    // Object member
+    template<typename T>
+    void Write(std::string_view key, const T& value) {
+        WriteKey(key);
+        AppendValue(value);
+    }
+    
+    // Array element
+    template<typename T>
+    void WriteValue(const T& value) {
+        BeginValue();
+        AppendValue(value);
+    }
+    
+    // Writes a string-keyed map as an object, sorted by key
+    template<typename Map>
+    void WriteMap(std::string_view key, const Map& map) {
+        BeginObject(key);
+        for (const auto* pair : SortedByKey(map)) {
+            Write(pair->first, pair->second);
+        }
+        EndObject();
+    }
+    
+    const std::string& GetBuffer() const { return m_buffer; }
+    
+private:
+    void BeginValue() {
+        if (m_hasElements.empty()) {
+            return;
+        }
+        if (m_hasElements.back()) {
+            m_buffer.push_back(',');
+        }
+        m_hasElements.back() = true;
+        NewLine();
+    }
+    
+    void WriteKey(std::string_view key) {
+        BeginValue();
+        AppendString(key);
+        m_buffer.append(": ");
+    }
+    
+    void Open(char bracket) {
+        m_buffer.push_back(bracket);
+        m_hasElements.push_back(false);
+    }
+    
+    void Close(char bracket) {
+        bool hadElements = m_hasElements.back();
+        m_hasElements.pop_back();
+        if (hadElements) {
+            NewLine();
+        }
+        m_buffer.push_back(bracket);
+        if (m_hasElements.empty()) {
+            m_buffer.push_back('\n');
+        }
+    }
+    
+    void NewLine() {
+        m_buffer.push_back('\n');
+        m_buffer.append(m_hasElements.size() * 2, ' ');
+    }
+    
+    template<typename T>
+    void AppendValue(const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            m_buffer.append(value ? "true" : "false");
+        } else if constexpr (std::is_floating_point_v<T>) {
+            // JSON has no representation for NaN or infinity
+            if (!std::isfinite(value)) {
+                m_buffer.append("null");
+                return;
+            }
+            AppendNumber(value);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            AppendNumber(value);
+        } else if constexpr (std::is_enum_v<T>) {
+            AppendNumber(static_cast<std::underlying_type_t<T>>(value));
+        } else {
+            AppendString(std::string_view(value));
+        }
+    }
+    
+    template<typename T>
+    void AppendNumber(T value) {
+        char digits[64];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        m_buffer.append(digits, result.ptr);
+    }
+    
+    void AppendString(std::string_view text) {
+        static const char* hex = "0123456789abcdef";
+        m_buffer.push_back('"');
+        for (char c : text) {
+            switch (c) {
+                case '"': m_buffer.append("\\\""); break;
+                case '\\': m_buffer.append("\\\\"); break;
+                case '\n': m_buffer.append("\\n"); break;
+                case '\r': m_buffer.append("\\r"); break;
+                case '\t': m_buffer.append("\\t"); break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        m_buffer.append("\\u00");
+                        m_buffer.push_back(hex[(c >> 4) & 0xF]);
+                        m_buffer.push_back(hex[c & 0xF]);
+                    } else {
+                        m_buffer.push_back(c);
+                    }
+                    break;
+            }
+        }
+        m_buffer.push_back('"');
+    }
+    
+    std::string m_buffer;
+    std::vector<bool> m_hasElements;
+};
+
+// Callbacks for ReadJsonSave. A save is a root object whose object-valued members are
+// sections (one per system). Section members arrive one at a time through onField;
+// array members arrive once per element, so only one record is in memory at a time.
+struct JsonSaveHandlers {
+    std::function<void(const std::string& key, const nlohmann::json& value)> onHeader;
+    std::function<void(const std::string& section)> onSectionBegin;
+    std::function<void(const std::string& section, const std::string& field, const nlohmann::json& value)> onField;
+    std::function<void(const std::string& section)> onSectionEnd;
+};
+
+// Streams a JSON save through the SAX parser. Returns false and fills 'error' if the
+// input is malformed; callbacks already made for earlier records are not undone.
+bool ReadJsonSave(std::istream& input, const JsonSaveHandlers& handlers, std::string& error);
+
+// Checks that the input is well-formed JSON without building anything
+bool ValidateJson(std::istream& input);
+// ^ JsonSerialization.h
\ No newline at end of file
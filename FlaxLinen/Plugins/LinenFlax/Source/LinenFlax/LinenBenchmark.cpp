@@ -0,0 +1,508 @@
+// v LinenBenchmark.cpp
+#include "LinenBenchmark.h"
+#include "LinenFlax.h"
+#include "LinenSystemIncludes.h"
+#include "SaveFileIO.h"
+#include "Engine/Core/Log.h"
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <filesystem>
+
+namespace {
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+double ElapsedMs(BenchmarkClock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(BenchmarkClock::now() - start).count();
+}
+
+} // namespace
+
+LinenBenchmark::LinenBenchmark(const SpawnParams& params)
+    : Script(params)
+{
+}
+
+void LinenBenchmark::OnEnable()
+{
+    try {
+        LOG(Info, "LinenBenchmark::OnEnable : Starting benchmarks");
+        
+        BenchmarkTextParse(1000000);
+        for (int questCount : { 1000, 10000, 100000, 1000000 }) {
+            BenchmarkSnapshot(questCount);
+        }
+        for (int questCount : { 1000, 100000, 1000000 }) {
+            BenchmarkQuestStates(questCount);
+            BenchmarkRequirements(questCount);
+            BenchmarkPrerequisites(questCount);
+            BenchmarkTimers(questCount);
+}
+        BenchmarkQuestContent(100000);
+    }
+    catch (const std::exception& e) {
+        LOG(Error, "LinenBenchmark::OnEnable : Exception during benchmarks: {0}", String(e.what()));
+    }
+    
+    LOG(Info, "LinenBenchmark::OnEnable completed");
+}
+
+void LinenBenchmark::BenchmarkTextParse(int keyCount)
+{
+    // Same shape as a text save: scoped entity keys with string, int and float values
+    TextWriter writer;
+    writer.Reserve(static_cast<size_t>(keyCount) * 32);
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < keyCount / 4; i++) {
+        writer.BeginScope("entity", i);
+        writer.Write("id", "entity_name");
+        writer.Write("level", i);
+        writer.Write("x", i * 0.25f);
+        writer.Write("y", i * -1.5);
+        writer.EndScope();
+    }
+    double writeMs = ElapsedMs(start);
+    
+    std::string text = writer.GetBuffer();
+    double megabytes = text.size() / (1024.0 * 1024.0);
+    
+    TextReader reader;
+    start = BenchmarkClock::now();
+    reader.LoadFromString(std::move(text));
+    double indexMs = ElapsedMs(start);
+    
+    start = BenchmarkClock::now();
+    int64_t checksum = 0;
+    int missing = 0;
+    for (int i = 0; i < keyCount / 4; i++) {
+        std::string id;
+        int level = 0;
+        float x = 0.0f;
+        double y = 0.0;
+        reader.BeginScope("entity", i);
+        if (!reader.Read("id", id) || !reader.Read("level", level) || !reader.Read("x", x) || !reader.Read("y", y)) {
+            missing++;
+        }
+        reader.EndScope();
+        checksum += level + static_cast<int64_t>(x) + static_cast<int64_t>(y);
+    }
+    double readMs = ElapsedMs(start);
+    
+    LOG(Info, "Text parse benchmark: {0} keys, {1} MB", static_cast<int>(reader.GetKeyCount()), megabytes);
+    LOG(Info, "  write {0} ms, index {1} ms ({2} MB/s), read {3} ms ({4} keys/s)",
+        writeMs, indexMs, megabytes / (indexMs / 1000.0), readMs, keyCount / (readMs / 1000.0));
+    if (missing > 0) {
+        LOG(Error, "Text parse benchmark: {0} entities failed to read back (checksum {1})", missing, checksum);
+    }
+}
+
+void LinenBenchmark::BenchmarkSnapshot(int questCount)
+{
+    // Quest storage as QuestSystem holds it, kept apart from the live system
+    SnapshotMap<Quest> quests;
+    quests.reserve(questCount);
+    for (int i = 0; i < questCount; i++) {
+        std::string id = "quest_" + std::to_string(i);
+        quests[id] = Quest(id, "Quest title", "Quest description");
+    }
+    
+    const int rounds = 1000;
+    size_t visible = 0;
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < rounds; i++) {
+        visible += quests.Snapshot().size();
+    }
+    double snapshotUs = ElapsedMs(start) * 1000.0 / rounds;
+    
+    // The first change after a snapshot copies the page directory and one page
+    auto view = quests.Snapshot();
+    start = BenchmarkClock::now();
+    quests.Edit("quest_0")->SetState(QuestState::Active);
+    double firstEditUs = ElapsedMs(start) * 1000.0;
+    start = BenchmarkClock::now();
+    quests.Edit("quest_1")->SetState(QuestState::Active);
+    double nextEditUs = ElapsedMs(start) * 1000.0;
+    
+    // What the save thread does with the frozen view
+    start = BenchmarkClock::now();
+    BinaryWriter writer;
+    FieldSerializer::WriteBinaryValues(writer, std::make_tuple(view));
+    double serializeMs = ElapsedMs(start);
+    
+    // What freezing the same state by deep copy would cost the game thread
+    start = BenchmarkClock::now();
+    std::unordered_map<std::string, Quest> copy(view.begin(), view.end());
+    double copyMs = ElapsedMs(start);
+    
+    LOG(Info, "Snapshot benchmark: {0} quests", questCount);
+    LOG(Info, "  snapshot {0} us, first edit after snapshot {1} us, next edit {2} us",
+        snapshotUs, firstEditUs, nextEditUs);
+    LOG(Info, "  background serialize {0} ms ({1} MB), deep copy instead {2} ms",
+        serializeMs, writer.GetSize() / (1024.0 * 1024.0), copyMs);
+    if (visible != static_cast<size_t>(questCount) * rounds || copy.size() != view.size()) {
+        LOG(Error, "Snapshot benchmark: snapshots saw {0} quests", static_cast<int64_t>(visible / rounds));
+    }
+}
+
+void LinenBenchmark::BenchmarkQuestStates(int questCount)
+{
+    // Quest storage and table as QuestSystem holds them; a few quests are active
+    SnapshotMap<Quest> quests;
+    QuestTable states;
+    quests.reserve(questCount);
+    states.Reserve(questCount);
+    int activeCount = std::max(questCount / 100, 1);
+    for (int i = 0; i < questCount; i++) {
+        std::string id = "quest_" + std::to_string(i);
+        Quest quest(id, "Quest title", "Quest description");
+        quest.SetState(i % 100 == 0 ? QuestState::Active : QuestState::Available);
+        quests[id] = quest;
+        states.Add(quest.GetState());
+    }
+    
+    // GetActiveQuests before the index: a walk over every quest into a new vector
+    const int rounds = 100;
+    size_t scanned = 0;
+    auto start = BenchmarkClock::now();
+    for (int i = 0; i < rounds; i++) {
+        std::vector<const Quest*> active;
+        for (const auto& pair : quests) {
+            if (pair.second.GetState() == QuestState::Active) {
+                active.push_back(&pair.second);
+            }
+        }
+        scanned += active.size();
+    }
+    double scanUs = ElapsedMs(start) * 1000.0 / rounds;
+    
+    // GetQuestsInState: only the active group is read
+    size_t indexed = 0;
+    start = BenchmarkClock::now();
+    for (int i = 0; i < rounds; i++) {
+        for (const Quest& quest : QuestRange(states.GetGroup(QuestState::Active), quests)) {
+            indexed += quest.GetExperienceReward() + 1;
+        }
+    }
+    double rangeUs = ElapsedMs(start) * 1000.0 / rounds;
+    
+    // Complete every active quest, then make them active again
+    std::vector<uint32_t> activeIndices = states.GetGroup(QuestState::Active);
+    start = BenchmarkClock::now();
+    for (uint32_t index : activeIndices) {
+        states.SetState(index, QuestState::Completed);
+    }
+    for (uint32_t index : activeIndices) {
+        states.SetState(index, QuestState::Active);
+    }
+    double changeNs = ElapsedMs(start) * 1000000.0 / (activeIndices.size() * 2);
+    
+    // Finding the active quests again by id, as the id API does, and by handle
+    std::vector<std::string> activeIds;
+    std::vector<QuestHandle> activeHandles;
+    for (uint32_t index : activeIndices) {
+        activeIds.push_back(quests.GetEntry(index).first);
+        activeHandles.push_back(states.GetHandle(index));
+    }
+    size_t byId = 0;
+    start = BenchmarkClock::now();
+    for (const std::string& id : activeIds) {
+        byId += quests.find(id).GetIndex();
+    }
+    double idNs = ElapsedMs(start) * 1000000.0 / activeIds.size();
+    size_t byHandle = 0;
+    start = BenchmarkClock::now();
+    for (QuestHandle handle : activeHandles) {
+        byHandle += states.Find(handle);
+    }
+    double handleNs = ElapsedMs(start) * 1000000.0 / activeHandles.size();
+    
+    LOG(Info, "Quest state benchmark: {0} quests, {1} active", questCount, activeCount);
+    LOG(Info, "  active quests by scan {0} us, by state range {1} us, state change {2} ns",
+        scanUs, rangeUs, changeNs);
+    LOG(Info, "  quest lookup by id {0} ns, by handle {1} ns", idNs, handleNs);
+    if (byId != byHandle) {
+        LOG(Error, "Quest state benchmark: ids and handles found different quests");
+    }
+    if (scanned != indexed || states.GetGroup(QuestState::Active).size() != static_cast<size_t>(activeCount)) {
+        LOG(Error, "Quest state benchmark: scan found {0} quests, state range {1}",
+            static_cast<int64_t>(scanned / rounds), static_cast<int64_t>(indexed / rounds));
+    }
+}
+
+void LinenBenchmark::BenchmarkRequirements(int questCount)
+{
+    // Every quest needs one of 100 skills at a level from 1 to 10
+    const int skillCount = 100;
+    SnapshotMap<int> skills;
+    for (int i = 0; i < skillCount; i++) {
+        skills["skill_" + std::to_string(i)] = 0;
+    }
+    std::vector<Quest> quests;
+    quests.reserve(questCount);
+    for (int i = 0; i < questCount; i++) {
+        quests.emplace_back("quest_" + std::to_string(i), "Quest title", "Quest description");
+        quests.back().AddSkillRequirement("skill_" + std::to_string(i % skillCount), 1 + (i / skillCount) % 10);
+    }
+    
+    QuestRequirementIndex index;
+    QuestRequirementIndex::SkillLookup lookup = [&skills](const std::string& skillId, int& level) {
+        auto it = skills.find(skillId);
+        if (it == skills.end()) {
+            return false;
+        }
+        level = it->second;
+        return true;
+    };
+    auto start = BenchmarkClock::now();
+    index.Reserve(questCount);
+    for (const Quest& quest : quests) {
+        index.AddQuest(quest.GetSkillRequirements(), lookup);
+    }
+    double buildMs = ElapsedMs(start);
+    
+    // Raise one skill to 10, a level at a time; only the quests needing it are visited
+    const std::string raised = "skill_0";
+    std::vector<uint32_t> unlocked;
+    start = BenchmarkClock::now();
+    for (int level = 1; level <= 10; level++) {
+        index.SetSkillLevel(raised, level, unlocked);
+    }
+    double indexUs = ElapsedMs(start) * 1000.0 / 10;
+    
+    // The same without the index: re-check every quest after each change
+    size_t rechecked = 0;
+    start = BenchmarkClock::now();
+    for (int level = 1; level <= 10; level++) {
+        skills[raised] = level;
+        for (const Quest& quest : quests) {
+            rechecked += quest.CheckRequirements(skills) ? 1 : 0;
+        }
+    }
+    double recheckUs = ElapsedMs(start) * 1000.0 / 10;
+    
+    LOG(Info, "Requirement benchmark: {0} quests, index built in {1} ms", questCount, buildMs);
+    LOG(Info, "  skill change through index {0} us ({1} quests unlocked), re-checking every quest {2} us",
+        indexUs, static_cast<int64_t>(unlocked.size()), recheckUs);
+    size_t dependents = (questCount + skillCount - 1) / skillCount;
+    if (unlocked.size() != dependents) {
+        LOG(Error, "Requirement benchmark: expected {0} unlocked quests", static_cast<int64_t>(dependents));
+    }
+}
+
+void LinenBenchmark::BenchmarkPrerequisites(int questCount)
+{
+    // A binary tree: every quest but the root needs its parent completed, and every
+    // fourth one may instead follow its grandparent failing
+    std::vector<std::string> ids;
+    ids.reserve(questCount);
+    for (int i = 0; i < questCount; i++) {
+        ids.push_back("quest_" + std::to_string(i));
+    }
+    QuestGraph graph;
+    for (int i = 1; i < questCount; i++) {
+        graph.AddPrerequisite(ids[i], ids[(i - 1) / 2], QuestPrerequisite::Completed);
+        if (i % 4 == 0 && i > 2) {
+            graph.AddPrerequisite(ids[i], ids[((i - 1) / 2 - 1) / 2], QuestPrerequisite::Failed);
+            graph.SetMode(ids[i], PrerequisiteMode::AnyOf);
+        }
+    }
+    
+    auto start = BenchmarkClock::now();
+    bool built = graph.Build();
+    double buildMs = ElapsedMs(start);
+    
+    std::unordered_map<std::string, uint32_t> indices;
+    indices.reserve(questCount);
+    for (int i = 0; i < questCount; i++) {
+        indices.emplace(ids[i], static_cast<uint32_t>(i));
+    }
+    std::vector<QuestState> states(questCount, QuestState::Available);
+    QuestGraph::IndexOf indexOf = [&indices](const std::string& questId) {
+        auto it = indices.find(questId);
+        return it == indices.end() ? QuestGraph::InvalidIndex : it->second;
+    };
+    QuestGraph::StateOf stateOf = [&states](uint32_t index) { return states[index]; };
+    start = BenchmarkClock::now();
+    graph.Bind(states.size(), indexOf, stateOf);
+    double bindMs = ElapsedMs(start);
+    
+    // Complete the first 1000 quests one at a time; each visits only its own children
+    const int finished = std::min(questCount, 1000);
+    std::vector<uint32_t> unlocked;
+    start = BenchmarkClock::now();
+    for (int i = 0; i < finished; i++) {
+        states[i] = QuestState::Completed;
+        graph.QuestFinished(static_cast<uint32_t>(i), QuestState::Completed, unlocked);
+    }
+    double propagateUs = ElapsedMs(start) * 1000.0 / finished;
+    
+    // The same without propagation: count every quest's prerequisites again after a change
+    start = BenchmarkClock::now();
+    graph.Bind(states.size(), indexOf, stateOf);
+    double rebindUs = ElapsedMs(start) * 1000.0;
+    
+    LOG(Info, "Prerequisite benchmark: {0} quests, {1} edges, built and ordered in {2} ms, bound in {3} ms",
+        questCount, static_cast<int64_t>(graph.GetEdgeCount()), buildMs, bindMs);
+    LOG(Info, "  quest finished with propagation {0} us ({1} quests unlocked), recounting every quest {2} us",
+        propagateUs, static_cast<int64_t>(unlocked.size()), rebindUs);
+    size_t children = std::min<size_t>(questCount - 1, 2 * static_cast<size_t>(finished));
+    if (!built || unlocked.size() != children) {
+        LOG(Error, "Prerequisite benchmark: expected {0} unlocked quests", static_cast<int64_t>(children));
+    }
+}
+
+void LinenBenchmark::BenchmarkTimers(int questCount)
+{
+    // Deadlines spread over a game year, checked once per game minute for a day, then
+    // a jump of 30 days
+    const int64_t minutesPerDay = 24 * 60;
+    std::vector<int64_t> deadlines(questCount);
+    for (int i = 0; i < questCount; i++) {
+        deadlines[i] = 1 + (static_cast<int64_t>(i) * 7919) % (120 * minutesPerDay);
+    }
+    
+    QuestTimers timers;
+    auto start = BenchmarkClock::now();
+    timers.Reserve(questCount);
+    for (int i = 0; i < questCount; i++) {
+        QuestTimers::Times times;
+        times.deadline = deadlines[i];
+        timers.AddQuest(times, 0);
+    }
+    double scheduleMs = ElapsedMs(start);
+    
+    std::vector<QuestTimers::Expired> expired;
+    start = BenchmarkClock::now();
+    for (int64_t minute = 1; minute <= minutesPerDay; minute++) {
+        timers.TakeExpired(minute, expired);
+    }
+    double tickUs = ElapsedMs(start) * 1000.0 / minutesPerDay;
+    size_t firstDay = expired.size();
+    
+    start = BenchmarkClock::now();
+    timers.TakeExpired(31 * minutesPerDay, expired);
+    double jumpMs = ElapsedMs(start);
+    
+    // The same without the heap: every update polls every quest
+    size_t polled = 0;
+    start = BenchmarkClock::now();
+    for (int64_t minute = 1; minute <= 60; minute++) {
+        for (int64_t deadline : deadlines) {
+            polled += deadline == minute ? 1 : 0;
+        }
+    }
+    double pollUs = ElapsedMs(start) * 1000.0 / 60;
+    
+    LOG(Info, "Timer benchmark: {0} quests scheduled in {1} ms", questCount, scheduleMs);
+    LOG(Info, "  per-minute update {0} us ({1} expired in a day), polling every quest {2} us",
+        tickUs, static_cast<int64_t>(firstDay), pollUs);
+    LOG(Info, "  30 day jump {0} ms ({1} expired)", jumpMs, static_cast<int64_t>(expired.size() - firstDay));
+    for (size_t i = 1; i < expired.size(); i++) {
+        if (expired[i].minute < expired[i - 1].minute) {
+            LOG(Error, "Timer benchmark: expirations out of order");
+            break;
+        }
+    }
+}
+
+void LinenBenchmark::BenchmarkQuestContent(int questCount)
+{
+    // Content shaped like authored quests: a skill requirement each and a chain of
+    // prerequisites, written as JSON and compiled into temporary files
+    std::string json = "[";
+    std::vector<QuestDefinition> written(questCount);
+    for (int i = 0; i < questCount; i++) {
+        QuestDefinition& definition = written[i];
+        definition.id = "quest_" + std::to_string(i);
+        definition.title = "Quest title " + std::to_string(i);
+        definition.description = "A longer quest description, as content usually has one";
+        definition.experienceReward = 10 + i % 100;
+        definition.skillRequirements["skill_" + std::to_string(i % 32)] = 1 + i % 10;
+        if (i % 4 != 0) {
+            definition.requiresCompleted.push_back("quest_" + std::to_string(i - 1));
+        }
+        
+        json += i > 0 ? ",\n" : "\n";
+        json += "{\"id\": \"" + definition.id + "\", \"title\": \"" + definition.title
+            + "\", \"description\": \"" + definition.description
+            + "\", \"experienceReward\": " + std::to_string(definition.experienceReward)
+            + ", \"skillRequirements\": {\"skill_" + std::to_string(i % 32) + "\": " + std::to_string(1 + i % 10) + "}";
+        if (i % 4 != 0) {
+            json += ", \"requiresCompleted\": [\"" + definition.requiresCompleted[0] + "\"]";
+        }
+        json += "}";
+    }
+    json += "\n]\n";
+    
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+    std::string jsonFilename = (directory / "LinenBenchmarkQuests.json").string();
+    std::string compiledFilename = (directory / "LinenBenchmarkQuests.bin").string();
+    if (!WriteFileAtomic(jsonFilename, json.data(), json.size()) || !WriteQuestContentCompiled(compiledFilename, written)) {
+        LOG(Error, "Quest content benchmark: failed to write the content files");
+        return;
+    }
+    
+    std::vector<QuestDefinition> definitions;
+    auto start = BenchmarkClock::now();
+    bool read = ReadQuestContentJson(jsonFilename, definitions, false);
+    double jsonSerialMs = ElapsedMs(start);
+    start = BenchmarkClock::now();
+    read = ReadQuestContentJson(jsonFilename, definitions, true) && read;
+    double jsonParallelMs = ElapsedMs(start);
+    start = BenchmarkClock::now();
+    read = ReadQuestContentCompiled(compiledFilename, definitions, false) && read;
+    double compiledSerialMs = ElapsedMs(start);
+    start = BenchmarkClock::now();
+    read = ReadQuestContentCompiled(compiledFilename, definitions, true) && read;
+    double compiledParallelMs = ElapsedMs(start);
+    
+    // Inserting into quest storage as QuestSystem::AddQuests does, kept apart from the
+    // live system, against growing it one quest at a time as AddQuest does
+    start = BenchmarkClock::now();
+    SnapshotMap<Quest> batch;
+    QuestTable batchTable;
+    batch.reserve(definitions.size());
+    batchTable.Reserve(definitions.size());
+    for (const QuestDefinition& definition : definitions) {
+        Quest quest(definition.id, definition.title, definition.description);
+        quest.SetExperienceReward(definition.experienceReward);
+        for (const auto& requirement : definition.skillRequirements) {
+            quest.AddSkillRequirement(requirement.first, requirement.second);
+        }
+        if (batch.insert(definition.id, std::move(quest))) {
+            batchTable.Add(QuestState::Available);
+        }
+    }
+    double batchMs = ElapsedMs(start);
+    
+    start = BenchmarkClock::now();
+    SnapshotMap<Quest> single;
+    QuestTable singleTable;
+    for (const QuestDefinition& definition : definitions) {
+        if (single.find(definition.id) != single.end()) {
+            continue;
+        }
+        single[definition.id] = Quest(definition.id, definition.title, definition.description);
+        single.Edit(definition.id)->SetExperienceReward(definition.experienceReward);
+        for (const auto& requirement : definition.skillRequirements) {
+            single.Edit(definition.id)->AddSkillRequirement(requirement.first, requirement.second);
+        }
+        singleTable.Add(QuestState::Available);
+    }
+    double singleMs = ElapsedMs(start);
+    
+    std::error_code error;
+    std::filesystem::remove(jsonFilename, error);
+    std::filesystem::remove(compiledFilename, error);
+    
+    LOG(Info, "Quest content benchmark: {0} quests, {1} MB of JSON", questCount, json.size() / (1024.0 * 1024.0));
+    LOG(Info, "  JSON read {0} ms serial, {1} ms parallel; compiled read {2} ms serial, {3} ms parallel",
+        jsonSerialMs, jsonParallelMs, compiledSerialMs, compiledParallelMs);
+    LOG(Info, "  batch insert {0} ms, one at a time {1} ms", batchMs, singleMs);
+    if (!read || definitions.size() != written.size() || batch.size() != written.size()) {
+        LOG(Error, "Quest content benchmark: read {0} quests", static_cast<int64_t>(definitions.size()));
+    }
+}
+// ^ LinenBenchmark.cpp
\ No newline at end of file
@@ -0,0 +1,22 @@
+// v LinenBenchmark.h
+#pragma once
+#include "Engine/Scripting/Script.h"
+
+// Attach to an actor to log throughput numbers for the Linen systems once on enable
+API_CLASS() class LINENFLAX_API LinenBenchmark : public Script
+{
+API_AUTO_SERIALIZATION();
+DECLARE_SCRIPTING_TYPE(LinenBenchmark);
+
+    void OnEnable() override;
+
+private:
+    void BenchmarkTextParse(int keyCount);
+    void BenchmarkSnapshot(int questCount);
+    void BenchmarkQuestStates(int questCount);
+    void BenchmarkRequirements(int questCount);
+    void BenchmarkPrerequisites(int questCount);
+    void BenchmarkTimers(int questCount);
+    void BenchmarkQuestContent(int questCount);
+};
+// ^ LinenBenchmark.h
\ No newline at end of file
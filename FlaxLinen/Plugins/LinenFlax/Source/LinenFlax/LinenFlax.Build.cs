@@ -1,4 +1,5 @@
 // v LinenFlax.Build.cs
+using System.IO;
 using Flax.Build;
 using Flax.Build.NativeCpp;
 
@@ -13,6 +14,9 @@ public class LinenFlax : GameModule
         options.CompileEnv.CppVersion = CppVersion.Cpp17;
         options.PublicDependencies.Add("Core");
         options.PublicDependencies.Add("Engine");
+
+        // json.hpp and json_fwd.hpp live in the plugin root
+        options.PublicIncludePaths.Add(Path.Combine(FolderPath, "..", ".."));
     }
 }
 // ^ LinenFlax.Build.cs
\ No newline at end of file
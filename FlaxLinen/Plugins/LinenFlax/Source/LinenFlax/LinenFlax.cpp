@@ -2,6 +2,7 @@
 #include "LinenFlax.h"
 #include "LinenSystemIncludes.h" // Include all systems
 #include "Engine/Core/Log.h"
+#include "json.hpp"
 
 LinenFlax::LinenFlax(const SpawnParams& params) : GamePlugin(params)
 {
@@ -132,4 +133,11 @@ void LinenFlax::VisitSystem(const std::string& systemName,
     visited.insert(systemName);
     m_initializationOrder.push_back(systemName);
 }
+
+void TestSystem::DeserializeJsonField(const std::string& field, const nlohmann::json& value) {
+    if (field == "testValue") {
+        _testValue = value.get<int>();
+        LOG(Info, "TestSystem deserialized from JSON with value: {0}", _testValue);
+    }
+}
 // ^ LinenFlax.cpp
\ No newline at end of file
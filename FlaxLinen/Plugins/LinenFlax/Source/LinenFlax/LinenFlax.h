@@ -20,6 +20,7 @@ class TestSystem;
 class CharacterProgressionSystem;
 class QuestSystem;
 class SaveLoadSystem;
+class TimeSystem;
 
 class BinaryReader;
 class BinaryWriter;
@@ -76,6 +77,12 @@ public:
         LOG(Info, "TestSystem deserialized from text with value: {0}", _testValue);
     }
     
+    void SerializeToJson(JsonWriter& writer) const override {
+        writer.Write("testValue", _testValue);
+    }
+    
+    void DeserializeJsonField(const std::string& field, const nlohmann::json& value) override;
+    
     // GetInstance method
     static TestSystem* GetInstance() {
         // Thread-safe in C++11 and beyond
@@ -170,21 +177,22 @@ private:
 // Template implementations
 template <typename T>
 T* LinenFlax::GetSystem() {
-    // C++17 compatible implementation
+    // C++17 compatible implementation. Going through T keeps the calls dependent, so
+    // GCC and Clang only need the system's definition where GetSystem is instantiated.
     if constexpr (std::is_same<T, TestSystem>::value) {
-        return TestSystem::GetInstance();
+        return T::GetInstance();
     }
     else if constexpr (std::is_same<T, CharacterProgressionSystem>::value) {
-        return CharacterProgressionSystem::GetInstance();
+        return T::GetInstance();
     }
     else if constexpr (std::is_same<T, QuestSystem>::value) {
-        return QuestSystem::GetInstance();
+        return T::GetInstance();
     }
     else if constexpr (std::is_same<T, SaveLoadSystem>::value) {
-        return SaveLoadSystem::GetInstance();
+        return T::GetInstance();
     }
     else if constexpr (std::is_same<T, TimeSystem>::value) {
-        return TimeSystem::GetInstance();
+        return T::GetInstance();
     }
     
     LOG(Warning, "LinenFlax::GetSystem : No matching system found for type {0}", String(typeid(T).name()));
@@ -1,7 +1,9 @@
 // v LinenSystem.h
 #pragma once
 #include <string>
+#include <functional>
 #include "Serialization.h"
+#include "JsonSerialization.h"
 
 // Simple base system class
 class LinenSystem {
@@ -12,11 +14,47 @@ public:
     virtual void Update(float deltaTime) {}
     virtual std::string GetName() const = 0;
     
-    // Serialization methods
+    // Serialization methods. Binary Serialize/Deserialize (and the delta variants) may
+    // run on a worker thread alongside other systems, so they must only touch this
+    // system's own state and must not publish events.
     virtual void Serialize(BinaryWriter& writer) const { /* Default empty implementation */ }
     virtual void Deserialize(BinaryReader& reader) { /* Default empty implementation */ }
     virtual void SerializeToText(TextWriter& writer) const { /* Default empty implementation */ }
     virtual void DeserializeFromText(TextReader& reader) { /* Default empty implementation */ }
+    
+    // Version of the binary layout Serialize writes, stored with every chunk. Bump it
+    // when the layout changes and register an upgrade from the previous version with
+    // SaveLoadSystem::RegisterChunkUpgrade, so older saves keep loading.
+    virtual uint32_t GetSchemaVersion() const { return 1; }
+    
+    // JSON serialization. SerializeToJson writes members into an object the caller has
+    // opened. Loading is streamed: BeginJsonLoad, then DeserializeJsonField once per
+    // member (once per element for arrays), then EndJsonLoad.
+    virtual void SerializeToJson(JsonWriter& writer) const { /* Default empty implementation */ }
+    virtual void BeginJsonLoad() {}
+    virtual void DeserializeJsonField(const std::string& field, const nlohmann::json& value) {}
+    virtual void EndJsonLoad() {}
+    
+    // Incremental save support. Systems that track their own changes override these to
+    // write only what changed since ClearDirty(); the defaults treat the whole system as
+    // one dirty block and fall back to full serialization.
+    virtual bool IsDirty() const { return true; }
+    virtual void ClearDirty() {}
+    virtual void SerializeDelta(BinaryWriter& writer) const { Serialize(writer); }
+    virtual void DeserializeDelta(BinaryReader& reader) { Deserialize(reader); }
+    
+    // Deferred loading. DecodeDeferred runs on a worker thread while the game keeps using
+    // the system, so it must decode into state of its own and leave live state alone. It
+    // returns a function that installs the decoded state, called later on the game thread.
+    // The default returns nothing, and the loader calls Deserialize on the game thread.
+    virtual std::function<void()> DecodeDeferred(BinaryReader& reader) { return nullptr; }
+    
+    // Background saves. Systems that keep their state in copy-on-write containers (see
+    // SnapshotMap) return a function that writes the state as of this call, exactly as
+    // Serialize would. It runs later on the save thread while the game keeps changing
+    // the system, so taking it must be cheap. The default returns nothing, and the saver
+    // calls Serialize on the game thread.
+    virtual std::function<void(BinaryWriter&)> SnapshotState() const { return nullptr; }
 
 };
 // ^ LinenSystem.h
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include "LinenSystemIncludes.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Scripting/Plugins/PluginManager.h"
+#include <cstdio>
+#include <algorithm>
+#include <memory>
 
 LinenTest::LinenTest(const SpawnParams& params)
     : Script(params)
@@ -66,10 +69,10 @@ void LinenTest::OnEnable()
                 questSystem->ActivateQuest("test_quest_query");
                 Quest* quest = questSystem->GetQuest("test_quest_query");
                 
-                std::vector<Quest*> availableQuests = questSystem->GetAvailableQuests();
-                std::vector<Quest*> activeQuests = questSystem->GetActiveQuests();
-                std::vector<Quest*> completedQuests = questSystem->GetCompletedQuests();
-                std::vector<Quest*> failedQuests = questSystem->GetFailedQuests();
+                std::vector<const Quest*> availableQuests = questSystem->GetAvailableQuests();
+                std::vector<const Quest*> activeQuests = questSystem->GetActiveQuests();
+                std::vector<const Quest*> completedQuests = questSystem->GetCompletedQuests();
+                std::vector<const Quest*> failedQuests = questSystem->GetFailedQuests();
 
                 // Log just the sizes
                 LOG(Info, "LinenTest::OnEnable : questSystem Retrieved Available Quests: {0}", availableQuests.size());
@@ -116,7 +119,131 @@ void LinenTest::OnEnable()
                 LOG(Info, "LinenTest::OnEnable : questSystem Retrieved Failed Quests: {0} [{1}]", 
                     failedQuests.size(), 
                     failedQuestIds);
+                
+                // Quest prerequisites
+                questSystem->AddQuest("test_quest_prerequisite", "Test Quest Prerequisite", "A test quest prerequisite.");
+                questSystem->AddQuest("test_quest_follow_up", "Test Quest Follow Up", "A test quest follow up.");
+                questSystem->AddQuestPrerequisite("test_quest_follow_up", "test_quest_prerequisite");
+                questSystem->BuildQuestGraph();
+                if (questSystem->ActivateQuest("test_quest_follow_up") != QuestResult::PrerequisitesNotMet) {
+                    LOG(Error, "LinenTest::OnEnable : questSystem Activated a quest before its prerequisite");
+                }
+                questSystem->ActivateQuest("test_quest_prerequisite");
+                questSystem->CompleteQuest("test_quest_prerequisite");
+                if (questSystem->ActivateQuest("test_quest_follow_up") != QuestResult::Success) {
+                    LOG(Error, "LinenTest::OnEnable : questSystem Refused a quest whose prerequisite is complete");
+                }
+                
+                // Quest deadlines
+                auto* deadlineTimeSystem = plugin->GetSystem<TimeSystem>();
+                if (deadlineTimeSystem) {
+                    questSystem->AddQuest("test_quest_deadline", "Test Quest Deadline", "A test quest deadline.");
+                    questSystem->ActivateQuest("test_quest_deadline");
+                    questSystem->SetQuestDeadline("test_quest_deadline", deadlineTimeSystem->GetTotalMinutes() + 60);
+                    deadlineTimeSystem->AdvanceTimeHours(2);
+                    questSystem->Update(0.0f);
+                    Quest* deadlineQuest = questSystem->GetQuest("test_quest_deadline");
+                    if (!deadlineQuest || deadlineQuest->GetState() != QuestState::Failed) {
+                        LOG(Error, "LinenTest::OnEnable : questSystem Quest did not fail at its deadline");
+                    }
+                    questSystem->AddQuest("test_quest_late", "Test Quest Late", "A test quest past its deadline.");
+                    questSystem->SetQuestDeadline("test_quest_late", deadlineTimeSystem->GetTotalMinutes());
+                    if (questSystem->ActivateQuest("test_quest_late") != QuestResult::OutsideTimeWindow) {
+                        LOG(Error, "LinenTest::OnEnable : questSystem Activated a quest after its deadline");
+                    }
+                    LOG(Info, "LinenTest::OnEnable : questSystem Checked prerequisites and deadlines");
+                }
 
+                // Quest handles and state groups
+                questSystem->AddQuest("test_quest_handle", "Test Quest Handle", "A test quest found by handle.");
+                QuestHandle handle = questSystem->FindQuest("test_quest_handle");
+                questSystem->ActivateQuest(handle);
+                questSystem->CompleteQuest(handle);
+                Quest* failedByPointer = questSystem->GetQuest("test_quest_query_2");
+                if (failedByPointer) failedByPointer->SetState(QuestState::Failed);
+                bool groupsMatch = true;
+                int handleQuestSeen = 0;
+                for (QuestState state : { QuestState::Available, QuestState::Active, QuestState::Completed, QuestState::Failed }) {
+                    for (const Quest& groupQuest : questSystem->GetQuestsInState(state)) {
+                        if (groupQuest.GetState() != state) groupsMatch = false;
+                        if (groupQuest.GetId() == "test_quest_handle") handleQuestSeen++;
+                    }
+                }
+                if (!groupsMatch || handleQuestSeen != 1 || questSystem->GetQuestState(handle) != QuestState::Completed) {
+                    LOG(Error, "LinenTest::OnEnable : questSystem State groups disagree with quest states");
+                }
+                auto* handleSaveLoadSystem = plugin->GetSystem<SaveLoadSystem>();
+                if (handleSaveLoadSystem) {
+                    handleSaveLoadSystem->SaveGame("TestHandles.bin", SerializationFormat::Binary);
+                    handleSaveLoadSystem->LoadGame("TestHandles.bin", SerializationFormat::Binary);
+                    if (questSystem->GetQuest(handle) || !questSystem->FindQuest("test_quest_handle")) {
+                        LOG(Error, "LinenTest::OnEnable : questSystem A quest handle outlived a reload");
+                    }
+                }
+                
+                // Quest unlocks, collected by a handler that outlives this call
+                auto unlockedQuestIds = std::make_shared<std::vector<std::string>>();
+                plugin->GetEventSystem().Subscribe<QuestUnlockedEvent>(
+                    [unlockedQuestIds](const QuestUnlockedEvent& event) {
+                        unlockedQuestIds->push_back(event.questId);
+                    });
+                auto unlockCount = [&](const std::string& questId) {
+                    plugin->GetEventSystem().ProcessEvents();
+                    return std::count(unlockedQuestIds->begin(), unlockedQuestIds->end(), questId);
+                };
+                
+                // The skill requirement index unlocks a quest once its last requirement is met
+                auto* unlockProgressionSystem = plugin->GetSystem<CharacterProgressionSystem>();
+                if (unlockProgressionSystem) {
+                    unlockProgressionSystem->AddSkill("test_skill_first", "Test Skill First", "A first test skill.");
+                    unlockProgressionSystem->AddSkill("test_skill_second", "Test Skill Second", "A second test skill.");
+                    questSystem->AddQuest("test_quest_skills", "Test Quest Skills", "A test quest needing two skills.");
+                    Quest* skillQuest = questSystem->GetQuest("test_quest_skills");
+                    if (skillQuest) {
+                        skillQuest->AddSkillRequirement("test_skill_first", 2);
+                        skillQuest->AddSkillRequirement("test_skill_second", 1);
+                    }
+                    unlockProgressionSystem->IncreaseSkill("test_skill_first", 2);
+                    if (unlockCount("test_quest_skills") != 0 || questSystem->AreRequirementsMet(questSystem->FindQuest("test_quest_skills"))) {
+                        LOG(Error, "LinenTest::OnEnable : questSystem Unlocked a quest with a skill requirement left");
+                    }
+                    unlockProgressionSystem->IncreaseSkill("test_skill_second", 1);
+                    unlockProgressionSystem->IncreaseSkill("test_skill_first", 1);
+                    if (unlockCount("test_quest_skills") != 1 || !questSystem->AreRequirementsMet(questSystem->FindQuest("test_quest_skills"))) {
+                        LOG(Error, "LinenTest::OnEnable : questSystem Did not unlock a quest exactly once when its last skill requirement was met");
+                    }
+                }
+                
+                // The prerequisite graph unlocks a quest once its last prerequisite completes
+                questSystem->AddQuest("test_quest_chain_first", "Test Quest Chain First", "A first test quest in a chain.");
+                questSystem->AddQuest("test_quest_chain_second", "Test Quest Chain Second", "A second test quest in a chain.");
+                questSystem->AddQuest("test_quest_chain_end", "Test Quest Chain End", "A test quest ending a chain.");
+                questSystem->AddQuestPrerequisite("test_quest_chain_end", "test_quest_chain_first");
+                questSystem->AddQuestPrerequisite("test_quest_chain_end", "test_quest_chain_second");
+                if (!questSystem->BuildQuestGraph()) {
+                    LOG(Error, "LinenTest::OnEnable : questSystem Rejected prerequisites without a cycle");
+                }
+                QuestHandle chainEnd = questSystem->FindQuest("test_quest_chain_end");
+                questSystem->ActivateQuest("test_quest_chain_first");
+                questSystem->ActivateQuest("test_quest_chain_second");
+                questSystem->CompleteQuest("test_quest_chain_first");
+                if (unlockCount("test_quest_chain_end") != 0 || questSystem->ArePrerequisitesMet(chainEnd)) {
+                    LOG(Error, "LinenTest::OnEnable : questSystem Unlocked a quest with a prerequisite left");
+                }
+                questSystem->CompleteQuest("test_quest_chain_second");
+                if (unlockCount("test_quest_chain_end") != 1 || !questSystem->ArePrerequisitesMet(chainEnd)) {
+                    LOG(Error, "LinenTest::OnEnable : questSystem Did not unlock a quest exactly once when its last prerequisite completed");
+                }
+                
+                // A cycle is rejected and its declarations dropped, so the graph stays usable
+                questSystem->AddQuestPrerequisite("test_quest_chain_first", "test_quest_chain_end");
+                if (questSystem->BuildQuestGraph()) {
+                    LOG(Error, "LinenTest::OnEnable : questSystem Accepted a prerequisite cycle");
+                }
+                if (!questSystem->BuildQuestGraph() || !questSystem->ArePrerequisitesMet(chainEnd)) {
+                    LOG(Error, "LinenTest::OnEnable : questSystem Kept a rejected prerequisite cycle");
+                }
+            
             } else {
                 LOG(Error, "Quest System not found!");
             }
@@ -261,6 +388,242 @@ void LinenTest::OnEnable()
                 // Test text serialization
                 saveLoadSystem->SaveGame("TestSave.txt", SerializationFormat::Text);
                 saveLoadSystem->LoadGame("TestSave.txt", SerializationFormat::Text);
+                
+                // Everything a save holds, to compare states before and after loading
+                auto captureState = [saveLoadSystem]() {
+                    BinaryWriter writer;
+                    for (const std::string& systemName : saveLoadSystem->GetSerializableSystems()) {
+                        RPGSystem* system = saveLoadSystem->GetSystemByName(systemName);
+                        if (system) system->Serialize(writer);
+                    }
+                    return writer.GetBuffer();
+                };
+                
+                // Test incremental saves: the base plus the changes journaled after it
+                auto* journalTimeSystem = plugin->GetSystem<TimeSystem>();
+                auto* journalQuestSystem = plugin->GetSystem<QuestSystem>();
+                if (journalTimeSystem && journalQuestSystem) {
+                    std::remove("TestIncremental.bin");
+                    std::remove("TestIncremental.delta");
+                    saveLoadSystem->SaveGameIncremental("TestIncremental");
+                    journalTimeSystem->AdvanceTimeMinutes(42);
+                    journalQuestSystem->AddQuest("test_quest_journal", "Test Quest Journal", "A test quest journaled.");
+                    saveLoadSystem->SaveGameIncremental("TestIncremental");
+                    // Compared with a full save of the same state, as loading may change the
+                    // order of unordered containers and so their serialized bytes
+                    saveLoadSystem->SaveGame("TestIncrementalFull.bin", SerializationFormat::Binary);
+                    saveLoadSystem->LoadGame("TestIncrementalFull.bin", SerializationFormat::Binary);
+                    std::vector<uint8_t> journaledState = captureState();
+                    std::FILE* journal = std::fopen("TestIncremental.delta", "rb");
+                    if (journal) {
+                        std::fclose(journal);
+                    } else {
+                        LOG(Error, "LinenTest::OnEnable : saveLoadSystem Wrote no journal for an incremental save");
+                    }
+                    journalTimeSystem->AdvanceTimeHours(3);
+                    journalQuestSystem->ActivateQuest("test_quest_journal");
+                    if (!saveLoadSystem->LoadGame("TestIncremental", SerializationFormat::Binary) || captureState() != journaledState) {
+                        LOG(Error, "LinenTest::OnEnable : saveLoadSystem Replaying the journal gave a different state");
+                    }
+                    
+                    // Damaged and cut short saves are rejected and leave the game as it was
+                    saveLoadSystem->SaveGame("TestDamaged.bin", SerializationFormat::Binary);
+                    std::vector<uint8_t> saveBytes;
+                    std::FILE* saveFile = std::fopen("TestDamaged.bin", "rb");
+                    if (saveFile) {
+                        uint8_t buffer[4096];
+                        size_t read = 0;
+                        while ((read = std::fread(buffer, 1, sizeof(buffer), saveFile)) > 0) {
+                            saveBytes.insert(saveBytes.end(), buffer, buffer + read);
+                        }
+                        std::fclose(saveFile);
+                    }
+                    journalTimeSystem->AdvanceTimeHours(1);
+                    std::vector<uint8_t> liveState = captureState();
+                    for (int damage = 0; damage < 2 && !saveBytes.empty(); damage++) {
+                        std::vector<uint8_t> damagedBytes = saveBytes;
+                        if (damage == 0) {
+                            damagedBytes[damagedBytes.size() - 3] ^= 0x5A;
+                        } else {
+                            damagedBytes.resize(damagedBytes.size() / 2);
+                        }
+                        saveFile = std::fopen("TestDamaged.bin", "wb");
+                        if (saveFile) {
+                            std::fwrite(damagedBytes.data(), 1, damagedBytes.size(), saveFile);
+                            std::fclose(saveFile);
+                        }
+                        if (saveLoadSystem->LoadGame("TestDamaged.bin", SerializationFormat::Binary) || captureState() != liveState) {
+                            LOG(Error, "LinenTest::OnEnable : saveLoadSystem Loaded a {0} save", String(damage == 0 ? "damaged" : "truncated"));
+                        }
+                    }
+                    if (saveBytes.empty()) {
+                        LOG(Error, "LinenTest::OnEnable : saveLoadSystem Could not read back TestDamaged.bin");
+                    }
+                }
+                
+                // Test partial loads: time right away, quests later, progression not at all
+                auto* partialTimeSystem = plugin->GetSystem<TimeSystem>();
+                auto* partialQuestSystem = plugin->GetSystem<QuestSystem>();
+                auto* partialProgressionSystem = plugin->GetSystem<CharacterProgressionSystem>();
+                if (partialTimeSystem && partialQuestSystem && partialProgressionSystem) {
+                    saveLoadSystem->SaveGame("TestPartial.bin", SerializationFormat::Binary);
+                    int savedHour = partialTimeSystem->GetHour();
+                    partialTimeSystem->AdvanceTimeHours(5);
+                    partialQuestSystem->AddQuest("test_quest_partial", "Test Quest Partial", "A test quest not in the save.");
+                    partialProgressionSystem->IncreaseSkill("strength", 1);
+                    int changedSkillLevel = partialProgressionSystem->GetSkillLevel("strength");
+                    saveLoadSystem->LoadGamePartial("TestPartial.bin", { "TimeSystem" }, { "QuestSystem" });
+                    if (partialTimeSystem->GetHour() != savedHour) {
+                        LOG(Error, "LinenTest::OnEnable : saveLoadSystem Partial load did not restore an immediate system");
+                    }
+                    if (!saveLoadSystem->IsLoadInProgress() || !partialQuestSystem->GetQuest("test_quest_partial")) {
+                        LOG(Error, "LinenTest::OnEnable : saveLoadSystem Partial load applied a deferred system too early");
+                    }
+                    saveLoadSystem->FinishDeferredLoads();
+                    if (saveLoadSystem->IsLoadInProgress() || partialQuestSystem->GetQuest("test_quest_partial")) {
+                        LOG(Error, "LinenTest::OnEnable : saveLoadSystem Partial load did not restore a deferred system");
+                    }
+                    if (partialProgressionSystem->GetSkillLevel("strength") != changedSkillLevel) {
+                        LOG(Error, "LinenTest::OnEnable : saveLoadSystem Partial load restored a system it was not asked for");
+                    }
+                }
+                
+                // Test schema upgrades: a TestSystem chunk marked as schema 0 is upgraded as it loads
+                auto* upgradeTestSystem = plugin->GetSystem<TestSystem>();
+                SaveSlotInfo upgradeInfo;
+                if (upgradeTestSystem && saveLoadSystem->SaveGame("TestUpgrade.bin", SerializationFormat::Binary) &&
+                    ReadSaveSlotInfo("TestUpgrade.bin", upgradeInfo)) {
+                    int savedValue = upgradeTestSystem->GetValue();
+                    bool marked = false;
+                    std::FILE* upgradeFile = std::fopen("TestUpgrade.bin", "r+b");
+                    if (upgradeFile && std::fseek(upgradeFile, static_cast<long>(upgradeInfo.headerSize), SEEK_SET) == 0) {
+                        // Chunk headers: name length, name, payload size, checksum, schema version
+                        for (uint32_t i = 0; i < upgradeInfo.chunkCount && !marked; i++) {
+                            uint32_t nameLength = 0;
+                            uint32_t payloadSize = 0;
+                            uint32_t checksum = 0;
+                            std::string systemName;
+                            if (std::fread(&nameLength, sizeof(nameLength), 1, upgradeFile) != 1 || nameLength > 256) break;
+                            systemName.resize(nameLength);
+                            if (std::fread(&systemName[0], 1, nameLength, upgradeFile) != nameLength ||
+                                std::fread(&payloadSize, sizeof(payloadSize), 1, upgradeFile) != 1 ||
+                                std::fread(&checksum, sizeof(checksum), 1, upgradeFile) != 1) break;
+                            if (systemName == "TestSystem") {
+                                uint32_t oldSchema = 0;
+                                std::fseek(upgradeFile, 0, SEEK_CUR); // Needed between a read and a write
+                                marked = std::fwrite(&oldSchema, sizeof(oldSchema), 1, upgradeFile) == 1;
+                            } else {
+                                std::fseek(upgradeFile, static_cast<long>(sizeof(uint32_t) + payloadSize), SEEK_CUR);
+                            }
+                        }
+                    }
+                    if (upgradeFile) std::fclose(upgradeFile);
+                    
+                    // Schema 0 stored the value less 1000
+                    int upgrades = 0;
+                    saveLoadSystem->RegisterChunkUpgrade("TestSystem", 0, [&upgrades](BinaryReader& reader, BinaryWriter& writer) {
+                        int value = 0;
+                        reader.Read(value);
+                        writer.Write(value + 1000);
+                        upgrades++;
+                        return !reader.HasFailed();
+                    });
+                    if (!marked || !saveLoadSystem->LoadGame("TestUpgrade.bin", SerializationFormat::Binary) ||
+                        upgrades != 1 || upgradeTestSystem->GetValue() != savedValue + 1000) {
+                        LOG(Error, "LinenTest::OnEnable : saveLoadSystem Did not upgrade an older TestSystem chunk");
+                    }
+                    upgradeTestSystem->AddValue(savedValue);
+                }
+                
+                // Text saves of version 1.0.0 have their keys renamed before any system reads them
+                auto* upgradeProgressionSystem = plugin->GetSystem<CharacterProgressionSystem>();
+                std::FILE* oldTextFile = std::fopen("TestUpgrade.txt", "wb");
+                if (upgradeProgressionSystem && oldTextFile) {
+                    std::fputs("version=1.0.0\nsystemCount=1\nsystem0=CharacterProgressionSystem\n"
+                        "characterExperience=123\ncharacterLevel=1\nskillCount=0\nskillLevelsCount=0\n", oldTextFile);
+                    std::fclose(oldTextFile);
+                    oldTextFile = nullptr;
+                    if (!saveLoadSystem->LoadGame("TestUpgrade.txt", SerializationFormat::Text) ||
+                        upgradeProgressionSystem->GetExperience() != 123) {
+                        LOG(Error, "LinenTest::OnEnable : saveLoadSystem Did not upgrade a version 1.0.0 text save");
+                    }
+                }
+                if (oldTextFile) std::fclose(oldTextFile);
+                
+                // Test the save store
+                auto sameChunks = [](const std::vector<SaveStoreChunk>& a, const std::vector<SaveStoreChunk>& b) {
+                    if (a.size() != b.size()) return false;
+                    for (size_t i = 0; i < a.size(); i++) {
+                        if (a[i].systemName != b[i].systemName || a[i].data != b[i].data || a[i].schemaVersion != b[i].schemaVersion) return false;
+                    }
+                    return true;
+                };
+                std::remove("TestStore.store");
+                SaveStore store;
+                if (store.Open("TestStore.store")) {
+                    std::vector<SaveStoreChunk> storeChunks(2);
+                    storeChunks[0].systemName = "TestStoreFirst";
+                    storeChunks[0].data.assign(5000, 7);
+                    storeChunks[1].systemName = "TestStoreSecond";
+                    for (int i = 0; i < 300; i++) storeChunks[1].data.push_back(static_cast<uint8_t>(i * 31));
+                    storeChunks[1].schemaVersion = 2;
+                    std::vector<SaveStoreChunk> otherChunks(1);
+                    otherChunks[0].systemName = "TestStoreOther";
+                    otherChunks[0].data.assign(3000, 9);
+                    SaveSlotInfo slotInfo;
+                    slotInfo.gameHour = 7;
+                    store.WriteSlot("test_slot", slotInfo, storeChunks);
+                    store.WriteSlot("test_slot_other", slotInfo, otherChunks);
+                    
+                    std::vector<SaveStoreChunk> readChunks;
+                    SaveSlotInfo readInfo;
+                    if (!store.ReadSlot("test_slot", readChunks, &readInfo) || !sameChunks(readChunks, storeChunks) || readInfo.gameHour != 7) {
+                        LOG(Error, "LinenTest::OnEnable : saveStore Read back a slot different from the one written");
+                    }
+                    
+                    // Compaction drops the deleted slot and keeps the others readable
+                    uint64_t storeSize = store.GetFileSize();
+                    store.DeleteSlot("test_slot_other");
+                    store.Compact();
+                    if (store.HasSlot("test_slot_other") || store.GetFileSize() >= storeSize) {
+                        LOG(Error, "LinenTest::OnEnable : saveStore Compaction kept a deleted slot");
+                    }
+                    if (!store.ReadSlot("test_slot", readChunks) || !sameChunks(readChunks, storeChunks)) {
+                        LOG(Error, "LinenTest::OnEnable : saveStore Lost a slot while compacting");
+                    }
+                    
+                    // Identical data is stored once and outlives any one slot using it
+                    size_t blobCount = store.GetBlobCount();
+                    store.WriteSlot("test_slot_copy", slotInfo, storeChunks);
+                    if (store.GetBlobCount() != blobCount) {
+                        LOG(Error, "LinenTest::OnEnable : saveStore Stored identical data twice");
+                    }
+                    store.DeleteSlot("test_slot");
+                    if (store.GetBlobCount() != blobCount || !store.ReadSlot("test_slot_copy", readChunks) || !sameChunks(readChunks, storeChunks)) {
+                        LOG(Error, "LinenTest::OnEnable : saveStore Dropped data still used by another slot");
+                    }
+                    LOG(Info, "LinenTest::OnEnable : saveStore Checked {0} blobs in {1} bytes", store.GetBlobCount(), store.GetFileSize());
+                    std::vector<uint8_t> storeBytes(static_cast<size_t>(store.GetFileSize()));
+                    store.Close();
+                    
+                    // A damaged record is caught by its checksum on read
+                    std::FILE* storeFile = std::fopen("TestStore.store", "r+b");
+                    if (storeFile) {
+                        storeBytes.resize(std::fread(storeBytes.data(), 1, storeBytes.size(), storeFile));
+                        auto damaged = std::search(storeBytes.begin(), storeBytes.end(), storeChunks[1].data.begin(), storeChunks[1].data.end());
+                        if (damaged != storeBytes.end()) {
+                            std::fseek(storeFile, static_cast<long>(damaged - storeBytes.begin()), SEEK_SET);
+                            std::fputc(*damaged ^ 0xFF, storeFile);
+                        }
+                        std::fclose(storeFile);
+                    }
+                    if (store.Open("TestStore.store") && store.ReadSlot("test_slot_copy", readChunks)) {
+                        LOG(Error, "LinenTest::OnEnable : saveStore Read a slot with a damaged record");
+                    }
+                    store.Close();
+                } else {
+                    LOG(Error, "LinenTest::OnEnable : saveStore Could not open TestStore.store");
+                }
             }
             else {
                 LOG(Warning, "LinenTest::OnEnable : Save Load System not found");
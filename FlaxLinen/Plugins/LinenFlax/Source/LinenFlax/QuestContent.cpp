@@ -0,0 +1,264 @@
+// v QuestContent.cpp
+#include "QuestContent.h"
+#include "SaveFileIO.h"
+#include "Engine/Core/Log.h"
+#include "json.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Below this many quests a shard costs more in thread start-up than it saves
+constexpr size_t MinQuestsPerShard = 2048;
+
+constexpr const char* JsonWhitespace = " \t\r\n";
+
+// Offsets of one quest in the content data, [begin, end)
+using QuestBounds = std::pair<size_t, size_t>;
+
+bool ReadWholeFile(const std::string& filename, std::string& data) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::streamoff size = file.tellg();
+    if (size < 0) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(size));
+    file.seekg(0, std::ios::beg);
+    if (size > 0) {
+        file.read(&data[0], size);
+    }
+    return file.good();
+}
+
+// Finds each element of a top-level JSON array without parsing it, only following
+// strings and nesting. Malformed elements are left for the parser to report.
+bool SplitJsonArray(const std::string& text, std::vector<QuestBounds>& elements) {
+    size_t i = text.find_first_not_of(JsonWhitespace);
+    if (i == std::string::npos || text[i] != '[') {
+        return false;
+    }
+    i = text.find_first_not_of(JsonWhitespace, i + 1);
+    if (i != std::string::npos && text[i] == ']') {
+        return true;
+    }
+    
+    size_t begin = i;
+    int depth = 0;
+    for (; i < text.size(); ++i) {
+        char c = text[i];
+        if (c == '"') {
+            for (++i; i < text.size() && text[i] != '"'; ++i) {
+                if (text[i] == '\\') {
+                    ++i;
+                }
+            }
+        } else if (c == '{' || c == '[') {
+            depth++;
+        } else if (depth > 0 && (c == '}' || c == ']')) {
+            depth--;
+        } else if (depth == 0 && (c == ',' || c == ']')) {
+            elements.emplace_back(begin, i);
+            if (c == ']') {
+                return true;
+            }
+            begin = i + 1;
+        }
+    }
+    return false;
+}
+
+// Splits the quests below 'count' into contiguous shards, one per thread, and calls
+// parse(begin, end, error) on each. The earliest failed shard's error is returned.
+template<typename Parse>
+bool ParseShards(size_t count, bool parallel, const Parse& parse, std::string& error) {
+    size_t shardCount = 1;
+    if (parallel) {
+        size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        shardCount = std::min(hardwareThreads, count / MinQuestsPerShard + 1);
+    }
+    
+    std::vector<std::string> errors(shardCount);
+    auto parseShard = [&](size_t shard) {
+        parse(count * shard / shardCount, count * (shard + 1) / shardCount, errors[shard]);
+    };
+    
+    std::vector<std::thread> workers;
+    for (size_t shard = 1; shard < shardCount; ++shard) {
+        workers.emplace_back(parseShard, shard);
+    }
+    parseShard(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    for (const std::string& shardError : errors) {
+        if (!shardError.empty()) {
+            error = shardError;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CheckDefinition(size_t index, const QuestDefinition& definition, std::string& error) {
+    if (definition.id.empty()) {
+        error = "quest " + std::to_string(index) + " has no id";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool ReadQuestContentJson(const std::string& filename, std::vector<QuestDefinition>& definitions, bool parallel) {
+    std::string text;
+    if (!ReadWholeFile(filename, text)) {
+        LOG(Error, "Failed to open quest content: {0}", String(filename.c_str()));
+        return false;
+    }
+    
+    std::vector<QuestBounds> elements;
+    if (!SplitJsonArray(text, elements)) {
+        LOG(Error, "Quest content is not a complete JSON array: {0}", String(filename.c_str()));
+        return false;
+    }
+    
+    definitions.clear();
+    definitions.resize(elements.size());
+    std::string error;
+    bool parsed = ParseShards(elements.size(), parallel, [&](size_t begin, size_t end, std::string& shardError) {
+        const char* data = text.data();
+        for (size_t index = begin; index < end; ++index) {
+            try {
+                nlohmann::json json = nlohmann::json::parse(data + elements[index].first, data + elements[index].second);
+                if (!json.is_object()) {
+                    shardError = "quest " + std::to_string(index) + " is not an object";
+                    return;
+                }
+                FieldSerializer::ReadJsonObject(definitions[index], json);
+            }
+            catch (const std::exception& e) {
+                shardError = "quest " + std::to_string(index) + ": " + e.what();
+                return;
+            }
+            if (!CheckDefinition(index, definitions[index], shardError)) {
+                return;
+            }
+        }
+    }, error);
+    
+    if (!parsed) {
+        LOG(Error, "Failed to read quest content: {0}. Error: {1}", String(filename.c_str()), String(error.c_str()));
+        definitions.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ReadQuestContentCompiled(const std::string& filename, std::vector<QuestDefinition>& definitions, bool parallel) {
+    std::string data;
+    if (!ReadWholeFile(filename, data)) {
+        LOG(Error, "Failed to open quest content: {0}", String(filename.c_str()));
+        return false;
+    }
+    
+    BinaryReader reader(data.data(), data.size());
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t questCount = 0;
+    reader.Read(magic);
+    reader.Read(version);
+    reader.Read(questCount);
+    if (reader.HasFailed() || magic != QuestContentMagic) {
+        LOG(Error, "Not a compiled quest content file: {0}", String(filename.c_str()));
+        return false;
+    }
+    if (version != QuestContentVersion) {
+        LOG(Error, "Unsupported quest content version {0}: {1}", static_cast<int>(version), String(filename.c_str()));
+        return false;
+    }
+    
+    // Record bounds first, so that shards can start anywhere
+    std::vector<QuestBounds> records;
+    records.reserve(std::min<size_t>(questCount, reader.GetRemaining() / sizeof(uint32_t)));
+    for (uint32_t i = 0; i < questCount && !reader.HasFailed(); ++i) {
+        uint32_t size = 0;
+        reader.Read(size);
+        size_t begin = data.size() - reader.GetRemaining();
+        reader.Skip(size);
+        records.emplace_back(begin, begin + size);
+    }
+    if (reader.HasFailed()) {
+        LOG(Error, "Quest content is truncated: {0}", String(filename.c_str()));
+        return false;
+    }
+    
+    definitions.clear();
+    definitions.resize(records.size());
+    std::string error;
+    bool parsed = ParseShards(records.size(), parallel, [&](size_t begin, size_t end, std::string& shardError) {
+        if (begin == end) {
+            return;
+        }
+        // One reader over the shard; each record must end where the next size begins
+        size_t shardBegin = records[begin].first;
+        BinaryReader shard(data.data() + shardBegin, records[end - 1].second - shardBegin);
+        for (size_t index = begin; index < end; ++index) {
+            FieldSerializer::ReadBinary(shard, definitions[index]);
+            size_t position = records[end - 1].second - shard.GetRemaining();
+            if (shard.HasFailed() || position != records[index].second) {
+                shardError = "quest " + std::to_string(index) + " is malformed";
+                return;
+            }
+            if (!CheckDefinition(index, definitions[index], shardError)) {
+                return;
+            }
+            if (index + 1 < end) {
+                shard.Skip(sizeof(uint32_t));
+            }
+        }
+    }, error);
+    
+    if (!parsed) {
+        LOG(Error, "Failed to read quest content: {0}. Error: {1}", String(filename.c_str()), String(error.c_str()));
+        definitions.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ReadQuestContent(const std::string& filename, std::vector<QuestDefinition>& definitions, bool parallel) {
+    if (fs::path(filename).extension() == ".json") {
+        return ReadQuestContentJson(filename, definitions, parallel);
+    }
+    return ReadQuestContentCompiled(filename, definitions, parallel);
+}
+
+bool WriteQuestContentCompiled(const std::string& filename, const std::vector<QuestDefinition>& definitions) {
+    BinaryWriter writer;
+    writer.Write(QuestContentMagic);
+    writer.Write(QuestContentVersion);
+    writer.Write(static_cast<uint32_t>(definitions.size()));
+    for (const QuestDefinition& definition : definitions) {
+        BinaryWriter record;
+        FieldSerializer::WriteBinary(record, definition);
+        writer.Write(static_cast<uint32_t>(record.GetSize()));
+        writer.Write(record.GetBuffer().data(), record.GetSize());
+    }
+    
+    if (!WriteFileAtomic(filename, writer.GetBuffer().data(), writer.GetSize())) {
+        LOG(Error, "Failed to write quest content: {0}", String(filename.c_str()));
+        return false;
+    }
+    return true;
+}
+// ^ QuestContent.cpp
\ No newline at end of file
@@ -0,0 +1,62 @@
+// v QuestContent.h
+#pragma once
+
+#include "Reflection.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// Compiled quest content: magic and version, the quest count, then each quest as a
+// size-prefixed binary record so a reader can find every record without decoding it
+constexpr uint32_t QuestContentMagic = 0x43514E4C; // "LNQC"
+constexpr uint32_t QuestContentVersion = 1;
+
+// One quest as authored. JSON content files are an array of these as objects with the
+// field names below; missing fields keep their defaults.
+struct QuestDefinition {
+    std::string id;
+    std::string title;
+    std::string description;
+    int experienceReward = 0;
+    std::unordered_map<std::string, int> skillRequirements;
+    
+    // Prerequisite quest ids (see QuestGraph); any one of them is enough if anyPrerequisite
+    std::vector<std::string> requiresCompleted;
+    std::vector<std::string> requiresFailed;
+    bool anyPrerequisite = false;
+    
+    // Game-time limits, see Quest
+    int64_t availableFrom = 0;
+    int64_t availableUntil = 0;
+    int64_t deadline = 0;
+    
+    static constexpr auto Fields() {
+        return std::make_tuple(
+            MakeField("id", &QuestDefinition::id),
+            MakeField("title", &QuestDefinition::title),
+            MakeField("description", &QuestDefinition::description),
+            MakeField("experienceReward", &QuestDefinition::experienceReward),
+            MakeField("skillRequirements", &QuestDefinition::skillRequirements),
+            MakeField("requiresCompleted", &QuestDefinition::requiresCompleted),
+            MakeField("requiresFailed", &QuestDefinition::requiresFailed),
+            MakeField("anyPrerequisite", &QuestDefinition::anyPrerequisite),
+            MakeField("availableFrom", &QuestDefinition::availableFrom),
+            MakeField("availableUntil", &QuestDefinition::availableUntil),
+            MakeField("deadline", &QuestDefinition::deadline));
+    }
+};
+
+// Read a content file into 'definitions', in file order. The file is read whole, split
+// into shards of quests and, if 'parallel', the shards are parsed on one thread per
+// core. On any malformed quest, logs where it is and returns false.
+bool ReadQuestContentJson(const std::string& filename, std::vector<QuestDefinition>& definitions, bool parallel = true);
+bool ReadQuestContentCompiled(const std::string& filename, std::vector<QuestDefinition>& definitions, bool parallel = true);
+
+// Picks the reader by extension: ".json" files are JSON, anything else compiled
+bool ReadQuestContent(const std::string& filename, std::vector<QuestDefinition>& definitions, bool parallel = true);
+
+// Writes the compiled form, e.g. from JSON content at build time
+bool WriteQuestContentCompiled(const std::string& filename, const std::vector<QuestDefinition>& definitions);
+// ^ QuestContent.h
\ No newline at end of file
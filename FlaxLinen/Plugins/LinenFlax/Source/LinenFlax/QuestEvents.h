@@ -23,4 +23,11 @@ public:
     QuestState newState;
 };
 
+// Event fired when an available quest meets its last unmet skill requirement or prerequisite
+class QuestUnlockedEvent : public EventType<QuestUnlockedEvent> {
+public:
+    std::string questId;
+    std::string questTitle;
+};
+
 // ^ QuestEvents.h
\ No newline at end of file
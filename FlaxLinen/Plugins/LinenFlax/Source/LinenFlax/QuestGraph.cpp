@@ -0,0 +1,205 @@
+// v QuestGraph.cpp
+#include "QuestGraph.h"
+#include "Engine/Core/Log.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace {
+
+// Quests named when reporting a cycle
+constexpr size_t MaxReportedCycleQuests = 10;
+
+} // namespace
+
+void QuestGraph::AddPrerequisite(const std::string& questId, const std::string& prerequisiteId, QuestPrerequisite kind) {
+    m_declarations.push_back({ questId, prerequisiteId, kind });
+}
+
+void QuestGraph::SetMode(const std::string& questId, PrerequisiteMode mode) {
+    m_modes[questId] = mode;
+}
+
+void QuestGraph::Clear() {
+    m_declarations.clear();
+    m_builtDeclarations = 0;
+    m_modes.clear();
+    m_nodeByQuestId.clear();
+    m_nodeIds.clear();
+    m_order.clear();
+    m_dependentOffsets.clear();
+    m_dependents.clear();
+    m_prerequisiteOffsets.clear();
+    m_prerequisites.clear();
+    m_met.clear();
+    m_needed.clear();
+    m_nodeIndices.clear();
+    m_indexNodes.clear();
+}
+
+bool QuestGraph::Build() {
+    m_nodeByQuestId.clear();
+    m_nodeIds.clear();
+    m_indexNodes.clear();
+    m_nodeByQuestId.reserve(m_declarations.size());
+    
+    // (dependent, prerequisite, kind), sorted so repeated declarations collapse
+    std::vector<std::tuple<uint32_t, uint32_t, QuestPrerequisite>> edges;
+    edges.reserve(m_declarations.size());
+    for (const Declaration& declaration : m_declarations) {
+        uint32_t quest = InternNode(declaration.questId);
+        uint32_t prerequisite = InternNode(declaration.prerequisiteId);
+        edges.emplace_back(quest, prerequisite, declaration.kind);
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    
+    size_t nodeCount = m_nodeIds.size();
+    m_dependentOffsets.assign(nodeCount + 1, 0);
+    m_prerequisiteOffsets.assign(nodeCount + 1, 0);
+    for (const auto& edge : edges) {
+        m_dependentOffsets[std::get<1>(edge) + 1]++;
+        m_prerequisiteOffsets[std::get<0>(edge) + 1]++;
+    }
+    for (size_t node = 0; node < nodeCount; ++node) {
+        m_dependentOffsets[node + 1] += m_dependentOffsets[node];
+        m_prerequisiteOffsets[node + 1] += m_prerequisiteOffsets[node];
+    }
+    
+    // Edges are sorted by dependent, so each prerequisite row fills in order
+    m_dependents.resize(edges.size());
+    m_prerequisites.resize(edges.size());
+    std::vector<uint32_t> cursors(m_dependentOffsets.begin(), m_dependentOffsets.end() - 1);
+    for (size_t i = 0; i < edges.size(); ++i) {
+        uint32_t quest = std::get<0>(edges[i]);
+        uint32_t prerequisite = std::get<1>(edges[i]);
+        QuestPrerequisite kind = std::get<2>(edges[i]);
+        m_prerequisites[i] = { prerequisite, kind };
+        m_dependents[cursors[prerequisite]++] = { quest, kind };
+    }
+    
+    // Kahn's algorithm: whatever never runs out of prerequisites sits on or behind a cycle
+    std::vector<uint32_t> remaining(nodeCount);
+    m_order.clear();
+    m_order.reserve(nodeCount);
+    for (uint32_t node = 0; node < nodeCount; ++node) {
+        remaining[node] = m_prerequisiteOffsets[node + 1] - m_prerequisiteOffsets[node];
+        if (remaining[node] == 0) {
+            m_order.push_back(node);
+        }
+    }
+    for (size_t next = 0; next < m_order.size(); ++next) {
+        uint32_t node = m_order[next];
+        for (uint32_t e = m_dependentOffsets[node]; e < m_dependentOffsets[node + 1]; ++e) {
+            if (--remaining[m_dependents[e].node] == 0) {
+                m_order.push_back(m_dependents[e].node);
+            }
+        }
+    }
+    
+    if (m_order.size() < nodeCount) {
+        std::string quests;
+        size_t reported = 0;
+        for (uint32_t node = 0; node < nodeCount && reported < MaxReportedCycleQuests; ++node) {
+            if (remaining[node] > 0) {
+                quests += (reported++ > 0 ? ", " : "") + m_nodeIds[node];
+            }
+        }
+        LOG(Error, "Quest prerequisites form a cycle through: {0}", String(quests.c_str()));
+        
+        // Back to the last graph that built
+        m_declarations.resize(m_builtDeclarations);
+        Build();
+        return false;
+    }
+    m_builtDeclarations = m_declarations.size();
+    
+    m_needed.resize(nodeCount);
+    for (uint32_t node = 0; node < nodeCount; ++node) {
+        uint32_t count = m_prerequisiteOffsets[node + 1] - m_prerequisiteOffsets[node];
+        auto mode = m_modes.find(m_nodeIds[node]);
+        bool anyOf = mode != m_modes.end() && mode->second == PrerequisiteMode::AnyOf;
+        m_needed[node] = anyOf ? std::min<uint32_t>(count, 1) : count;
+    }
+    m_met.assign(nodeCount, 0);
+    m_nodeIndices.assign(nodeCount, InvalidIndex);
+    return true;
+}
+
+void QuestGraph::Bind(size_t questCount, const IndexOf& indexOf, const StateOf& stateOf) {
+    m_indexNodes.assign(questCount, InvalidNode);
+    for (uint32_t node = 0; node < m_nodeIds.size(); ++node) {
+        uint32_t index = indexOf(m_nodeIds[node]);
+        m_nodeIndices[node] = index;
+        if (index != InvalidIndex) {
+            m_indexNodes[index] = node;
+        }
+    }
+    for (uint32_t node = 0; node < m_nodeIds.size(); ++node) {
+        CountMet(node, stateOf);
+    }
+}
+
+void QuestGraph::BindQuest(const std::string& questId, uint32_t index, const StateOf& stateOf) {
+    if (m_indexNodes.size() <= index) {
+        m_indexNodes.resize(index + 1, InvalidNode);
+    }
+    auto it = m_nodeByQuestId.find(questId);
+    if (it == m_nodeByQuestId.end()) {
+        return;
+    }
+    
+    uint32_t node = it->second;
+    m_nodeIndices[node] = index;
+    m_indexNodes[index] = node;
+    CountMet(node, stateOf);
+    
+    // Dependents counted the quest as missing until now
+    QuestState state = stateOf(index);
+    for (uint32_t e = m_dependentOffsets[node]; e < m_dependentOffsets[node + 1]; ++e) {
+        if (Satisfies(state, m_dependents[e].kind)) {
+            m_met[m_dependents[e].node]++;
+        }
+    }
+}
+
+void QuestGraph::QuestFinished(uint32_t index, QuestState state, std::vector<uint32_t>& unlocked) {
+    uint32_t node = index < m_indexNodes.size() ? m_indexNodes[index] : InvalidNode;
+    if (node == InvalidNode) {
+        return;
+    }
+    
+    for (uint32_t e = m_dependentOffsets[node]; e < m_dependentOffsets[node + 1]; ++e) {
+        const Edge& edge = m_dependents[e];
+        if (!Satisfies(state, edge.kind)) {
+            continue;
+        }
+        // Only the edge that reaches the count unlocks, later ones (any-of) change nothing
+        if (++m_met[edge.node] == m_needed[edge.node] && m_nodeIndices[edge.node] != InvalidIndex) {
+            unlocked.push_back(m_nodeIndices[edge.node]);
+        }
+    }
+}
+
+uint32_t QuestGraph::InternNode(const std::string& questId) {
+    auto it = m_nodeByQuestId.find(questId);
+    if (it != m_nodeByQuestId.end()) {
+        return it->second;
+    }
+    
+    uint32_t node = static_cast<uint32_t>(m_nodeIds.size());
+    m_nodeByQuestId.emplace(questId, node);
+    m_nodeIds.push_back(questId);
+    return node;
+}
+
+void QuestGraph::CountMet(uint32_t node, const StateOf& stateOf) {
+    m_met[node] = 0;
+    for (uint32_t e = m_prerequisiteOffsets[node]; e < m_prerequisiteOffsets[node + 1]; ++e) {
+        uint32_t index = m_nodeIndices[m_prerequisites[e].node];
+        if (index != InvalidIndex && Satisfies(stateOf(index), m_prerequisites[e].kind)) {
+            m_met[node]++;
+        }
+    }
+}
+// ^ QuestGraph.cpp
\ No newline at end of file
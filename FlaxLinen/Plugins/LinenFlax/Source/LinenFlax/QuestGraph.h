@@ -0,0 +1,105 @@
+// v QuestGraph.h
+#pragma once
+
+#include "QuestTypes.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+// Prerequisites between quests: a quest may need others completed or failed, all of them
+// or any one. This is content rather than save data. Edges are declared by quest id and
+// Build() turns them into adjacency arrays in both directions (compressed sparse rows),
+// rejecting cycles and ordering the quests so each comes after its prerequisites.
+//
+// At run time every quest in the graph is bound to its storage index, as in QuestTable,
+// and counts its met prerequisites. A quest finishing only visits its own dependents;
+// Bind() goes over the whole graph and is for loads.
+class QuestGraph {
+public:
+    static constexpr uint32_t InvalidNode = UINT32_MAX;
+    static constexpr uint32_t InvalidIndex = UINT32_MAX;
+    
+    // Storage index of a quest id, or InvalidIndex; and the state at a storage index
+    using IndexOf = std::function<uint32_t(const std::string& questId)>;
+    using StateOf = std::function<QuestState(uint32_t index)>;
+    
+    // Declarations, kept across Build() calls so content can be added in parts
+    void AddPrerequisite(const std::string& questId, const std::string& prerequisiteId, QuestPrerequisite kind);
+    void SetMode(const std::string& questId, PrerequisiteMode mode);
+    void Clear();
+    
+    // Rebuilds the adjacency arrays from every declaration and unbinds all quests. On a
+    // cycle, logs the quests caught in it, drops the declarations made since the last
+    // successful Build() and returns false.
+    bool Build();
+    
+    size_t GetNodeCount() const { return m_nodeIds.size(); }
+    size_t GetEdgeCount() const { return m_dependents.size(); }
+    const std::string& GetQuestId(uint32_t node) const { return m_nodeIds[node]; }
+    
+    // Every node, prerequisites first
+    const std::vector<uint32_t>& GetOrder() const { return m_order; }
+    
+    // Binds every node to its quest and counts met prerequisites. Costs the whole graph.
+    void Bind(size_t questCount, const IndexOf& indexOf, const StateOf& stateOf);
+    
+    // Binds one quest appended at storage index 'index'. Costs its prerequisite count.
+    void BindQuest(const std::string& questId, uint32_t index, const StateOf& stateOf);
+    
+    // Quests outside the graph have nothing to wait for
+    bool ArePrerequisitesMet(uint32_t index) const {
+        uint32_t node = index < m_indexNodes.size() ? m_indexNodes[index] : InvalidNode;
+        return node == InvalidNode || m_met[node] >= m_needed[node];
+    }
+    
+    // Records that the quest at 'index' ended in 'state' and appends to 'unlocked' every
+    // bound quest whose prerequisites that meets. Costs the quest's dependent count.
+    void QuestFinished(uint32_t index, QuestState state, std::vector<uint32_t>& unlocked);
+
+private:
+    struct Declaration {
+        std::string questId;
+        std::string prerequisiteId;
+        QuestPrerequisite kind;
+    };
+    
+    struct Edge {
+        uint32_t node;
+        QuestPrerequisite kind;
+    };
+    
+    static bool Satisfies(QuestState state, QuestPrerequisite kind) {
+        return (kind == QuestPrerequisite::Completed && state == QuestState::Completed)
+            || (kind == QuestPrerequisite::Failed && state == QuestState::Failed);
+    }
+    
+    uint32_t InternNode(const std::string& questId);
+    void CountMet(uint32_t node, const StateOf& stateOf);
+    
+    std::vector<Declaration> m_declarations;
+    size_t m_builtDeclarations = 0;
+    std::unordered_map<std::string, PrerequisiteMode> m_modes;
+    
+    std::unordered_map<std::string, uint32_t> m_nodeByQuestId;
+    std::vector<std::string> m_nodeIds;
+    std::vector<uint32_t> m_order;
+    
+    // Node n's edges are [offsets[n], offsets[n + 1]); an edge names the other end
+    std::vector<uint32_t> m_dependentOffsets;
+    std::vector<Edge> m_dependents;
+    std::vector<uint32_t> m_prerequisiteOffsets;
+    std::vector<Edge> m_prerequisites;
+    
+    // By node: met prerequisites, how many are needed and the bound storage index
+    std::vector<uint32_t> m_met;
+    std::vector<uint32_t> m_needed;
+    std::vector<uint32_t> m_nodeIndices;
+    
+    // By storage index: the node, or InvalidNode
+    std::vector<uint32_t> m_indexNodes;
+};
+// ^ QuestGraph.h
\ No newline at end of file
@@ -0,0 +1,149 @@
+// v QuestRequirementIndex.cpp
+#include "QuestRequirementIndex.h"
+
+void QuestRequirementIndex::Clear() {
+    m_skillIds.clear();
+    m_skills.clear();
+    m_unmet.clear();
+    m_rangeStarts.clear();
+    m_rangeCounts.clear();
+    m_requirements.clear();
+    m_unusedRequirements = 0;
+}
+
+void QuestRequirementIndex::Reserve(size_t questCount) {
+    m_unmet.reserve(questCount);
+    m_rangeStarts.reserve(questCount);
+    m_rangeCounts.reserve(questCount);
+}
+
+void QuestRequirementIndex::AddQuest(const Requirements& requirements, const SkillLookup& lookup) {
+    uint32_t index = static_cast<uint32_t>(m_unmet.size());
+    m_unmet.push_back(0);
+    m_rangeStarts.push_back(0);
+    m_rangeCounts.push_back(0);
+    IndexRequirements(index, requirements, lookup);
+}
+
+void QuestRequirementIndex::UpdateQuest(uint32_t index, const Requirements& requirements, const SkillLookup& lookup) {
+    if (HasRequirements(index, requirements)) {
+        return;
+    }
+    
+    RemoveRequirements(index);
+    IndexRequirements(index, requirements, lookup);
+    if (m_unusedRequirements > m_requirements.size() / 2) {
+        CompactRequirements();
+    }
+}
+
+void QuestRequirementIndex::SetSkillLevel(const std::string& skillId, int level, std::vector<uint32_t>& unlocked) {
+    auto it = m_skillIds.find(skillId);
+    if (it == m_skillIds.end()) {
+        // No quest requires it
+        return;
+    }
+    
+    SkillEntry& skill = m_skills[it->second];
+    bool wasKnown = skill.known;
+    int previousLevel = skill.level;
+    skill.known = true;
+    skill.level = level;
+    
+    for (const Dependent& dependent : skill.dependents) {
+        bool wasMet = wasKnown && previousLevel >= dependent.level;
+        bool isMet = level >= dependent.level;
+        if (wasMet == isMet) {
+            continue;
+        }
+        if (isMet) {
+            if (--m_unmet[dependent.quest] == 0) {
+                unlocked.push_back(dependent.quest);
+            }
+        } else {
+            ++m_unmet[dependent.quest];
+        }
+    }
+}
+
+bool QuestRequirementIndex::HasRequirements(uint32_t index, const Requirements& requirements) const {
+    // Skills are unique on both sides, so matching counts and finding each is enough
+    if (requirements.size() != m_rangeCounts[index]) {
+        return false;
+    }
+    const Requirement* begin = m_requirements.data() + m_rangeStarts[index];
+    const Requirement* end = begin + m_rangeCounts[index];
+    for (const auto& pair : requirements) {
+        auto skill = m_skillIds.find(pair.first);
+        if (skill == m_skillIds.end()) {
+            return false;
+        }
+        bool found = false;
+        for (const Requirement* requirement = begin; requirement != end && !found; ++requirement) {
+            found = requirement->skill == skill->second && requirement->level == pair.second;
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t QuestRequirementIndex::InternSkill(const std::string& skillId, const SkillLookup& lookup) {
+    auto it = m_skillIds.find(skillId);
+    if (it != m_skillIds.end()) {
+        return it->second;
+    }
+    
+    uint32_t skill = static_cast<uint32_t>(m_skills.size());
+    m_skillIds.emplace(skillId, skill);
+    m_skills.emplace_back();
+    m_skills.back().known = lookup && lookup(skillId, m_skills.back().level);
+    return skill;
+}
+
+void QuestRequirementIndex::IndexRequirements(uint32_t index, const Requirements& requirements, const SkillLookup& lookup) {
+    m_rangeStarts[index] = static_cast<uint32_t>(m_requirements.size());
+    m_rangeCounts[index] = static_cast<uint32_t>(requirements.size());
+    m_unmet[index] = 0;
+    
+    for (const auto& pair : requirements) {
+        uint32_t skill = InternSkill(pair.first, lookup);
+        m_requirements.push_back({ skill, pair.second });
+        m_skills[skill].dependents.push_back({ index, pair.second });
+        if (!IsMet(m_skills[skill], pair.second)) {
+            m_unmet[index]++;
+        }
+    }
+}
+
+void QuestRequirementIndex::RemoveRequirements(uint32_t index) {
+    for (uint32_t i = 0; i < m_rangeCounts[index]; ++i) {
+        auto& dependents = m_skills[m_requirements[m_rangeStarts[index] + i].skill].dependents;
+        for (size_t d = 0; d < dependents.size(); ++d) {
+            if (dependents[d].quest == index) {
+                dependents[d] = dependents.back();
+                dependents.pop_back();
+                break;
+            }
+        }
+    }
+    m_unusedRequirements += m_rangeCounts[index];
+    m_rangeCounts[index] = 0;
+    m_unmet[index] = 0;
+}
+
+void QuestRequirementIndex::CompactRequirements() {
+    std::vector<Requirement> requirements;
+    requirements.reserve(m_requirements.size() - m_unusedRequirements);
+    for (size_t index = 0; index < m_rangeStarts.size(); ++index) {
+        uint32_t start = static_cast<uint32_t>(requirements.size());
+        for (uint32_t i = 0; i < m_rangeCounts[index]; ++i) {
+            requirements.push_back(m_requirements[m_rangeStarts[index] + i]);
+        }
+        m_rangeStarts[index] = start;
+    }
+    m_requirements = std::move(requirements);
+    m_unusedRequirements = 0;
+}
+// ^ QuestRequirementIndex.cpp
\ No newline at end of file
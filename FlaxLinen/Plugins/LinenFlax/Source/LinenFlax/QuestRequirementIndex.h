@@ -0,0 +1,79 @@
+// v QuestRequirementIndex.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+// Skill requirements of every quest, indexed from each skill to the quests that need it,
+// so a skill change only re-evaluates the quests depending on that skill. Every quest
+// keeps a count of its unmet requirements and is unlocked while the count is zero.
+//
+// Quests are known by storage index (see QuestTable) and the index is rebuilt when those
+// move. The requirements of all quests share one array, each quest owning a range of it.
+// Skill levels are tracked here as SetSkillLevel() reports them.
+class QuestRequirementIndex {
+public:
+    using Requirements = std::unordered_map<std::string, int>;
+    
+    // Current level of a skill, or false if the character doesn't have it
+    using SkillLookup = std::function<bool(const std::string& skillId, int& level)>;
+    
+    void Clear();
+    void Reserve(size_t questCount);
+    size_t GetSize() const { return m_unmet.size(); }
+    
+    // Appends a quest at storage index GetSize(). 'lookup' gives the levels of skills the
+    // index hasn't seen yet.
+    void AddQuest(const Requirements& requirements, const SkillLookup& lookup);
+    
+    // Replaces a quest's requirements; does nothing if they are unchanged
+    void UpdateQuest(uint32_t index, const Requirements& requirements, const SkillLookup& lookup);
+    
+    // Records a skill's new level and appends to 'unlocked' every quest whose last unmet
+    // requirement it meets. Costs the number of quests that require the skill.
+    void SetSkillLevel(const std::string& skillId, int level, std::vector<uint32_t>& unlocked);
+    
+    bool IsUnlocked(uint32_t index) const { return m_unmet[index] == 0; }
+    uint32_t GetUnmetCount(uint32_t index) const { return m_unmet[index]; }
+
+private:
+    struct Requirement {
+        uint32_t skill;
+        int level;
+    };
+    
+    struct Dependent {
+        uint32_t quest;
+        int level;
+    };
+    
+    struct SkillEntry {
+        bool known = false;              // Whether the character has the skill
+        int level = 0;
+        std::vector<Dependent> dependents;
+    };
+    
+    static bool IsMet(const SkillEntry& skill, int requiredLevel) { return skill.known && skill.level >= requiredLevel; }
+    
+    bool HasRequirements(uint32_t index, const Requirements& requirements) const;
+    uint32_t InternSkill(const std::string& skillId, const SkillLookup& lookup);
+    void IndexRequirements(uint32_t index, const Requirements& requirements, const SkillLookup& lookup);
+    void RemoveRequirements(uint32_t index);
+    void CompactRequirements();
+    
+    std::unordered_map<std::string, uint32_t> m_skillIds;
+    std::vector<SkillEntry> m_skills;
+    
+    // By storage index: unmet count and requirement range
+    std::vector<uint32_t> m_unmet;
+    std::vector<uint32_t> m_rangeStarts;
+    std::vector<uint32_t> m_rangeCounts;
+    
+    std::vector<Requirement> m_requirements;
+    size_t m_unusedRequirements = 0;     // Left behind by UpdateQuest until compacted
+};
+// ^ QuestRequirementIndex.h
\ No newline at end of file
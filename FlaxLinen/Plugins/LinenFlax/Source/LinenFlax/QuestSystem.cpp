@@ -1,11 +1,88 @@
 // v QuestSystem.cpp
 #include "QuestSystem.h"
 #include "CharacterProgressionSystem.h"
+#include "SaveLoadSystem.h"
+#include "TimeSystem.h"
 #include "LinenFlax.h"
 #include "Engine/Core/Log.h"
+#include "json.hpp"
 
 // QuestSystem* QuestSystem::s_instance = nullptr;
 
+namespace {
+
+// A quest's binary layout in schema 1, before availability windows and deadlines
+struct QuestSchema1 {
+    std::string id;
+    std::string title;
+    std::string description;
+    QuestState state = QuestState::Available;
+    int experienceReward = 0;
+    std::unordered_map<std::string, int> skillRequirements;
+    
+    static constexpr auto Fields() {
+        return std::make_tuple(
+            MakeField("id", &QuestSchema1::id),
+            MakeField("title", &QuestSchema1::title),
+            MakeField("description", &QuestSchema1::description),
+            MakeField("state", &QuestSchema1::state),
+            MakeField("experienceReward", &QuestSchema1::experienceReward),
+            MakeField("skillRequirements", &QuestSchema1::skillRequirements));
+    }
+};
+
+// Schema 2 appends the time limits, none for quests saved before them
+void UpgradeQuestFromSchema1(BinaryReader& reader, BinaryWriter& writer) {
+    QuestSchema1 quest;
+    FieldSerializer::ReadBinary(reader, quest);
+    FieldSerializer::WriteBinary(writer, quest);
+    writer.WriteValue(int64_t(0));
+    writer.WriteValue(int64_t(0));
+    writer.WriteValue(int64_t(0));
+}
+
+bool UpgradeQuestsFromSchema1(BinaryReader& reader, BinaryWriter& writer) {
+    uint32_t questCount = 0;
+    reader.Read(questCount);
+    writer.Write(questCount);
+    for (uint32_t i = 0; i < questCount && !reader.HasFailed(); ++i) {
+        std::string questId;
+        reader.Read(questId);
+        writer.Write(questId);
+        UpgradeQuestFromSchema1(reader, writer);
+    }
+    return !reader.HasFailed();
+}
+
+// Same for SerializeDelta's records, where removed quests carry no body
+bool UpgradeQuestDeltaFromSchema1(BinaryReader& reader, BinaryWriter& writer) {
+    uint32_t questCount = 0;
+    reader.Read(questCount);
+    writer.Write(questCount);
+    for (uint32_t i = 0; i < questCount && !reader.HasFailed(); ++i) {
+        std::string questId;
+        bool exists = false;
+        reader.Read(questId);
+        reader.Read(exists);
+        writer.Write(questId);
+        writer.Write(exists);
+        if (exists) {
+            UpgradeQuestFromSchema1(reader, writer);
+        }
+    }
+    return !reader.HasFailed();
+}
+
+QuestTimers::Times GetTimes(const Quest& quest) {
+    QuestTimers::Times times;
+    times.opensAt = quest.GetAvailableFrom();
+    times.closesAt = quest.GetAvailableUntil();
+    times.deadline = quest.GetDeadline();
+    return times;
+}
+
+} // namespace
+
 Quest::Quest(const std::string& id, const std::string& title, const std::string& description)
     : m_id(id)
     , m_title(title)
@@ -20,7 +97,7 @@ void Quest::AddSkillRequirement(const std::string& skillName, int requiredLevel)
     m_skillRequirements[skillName] = requiredLevel;
 }
 
-bool Quest::CheckRequirements(const std::unordered_map<std::string, int>& playerSkills) const {
+bool Quest::CheckRequirements(const SnapshotMap<int>& playerSkills) const {
     for (const auto& req : m_skillRequirements) {
         auto it = playerSkills.find(req.first);
         if (it == playerSkills.end() || it->second < req.second) {
@@ -30,94 +107,38 @@ bool Quest::CheckRequirements(const std::unordered_map<std::string, int>& player
     return true;
 }
 
+// Quest serialization, generated from Quest::Fields()
 void Quest::Serialize(BinaryWriter& writer) const {
-    writer.Write(m_id);
-    writer.Write(m_title);
-    writer.Write(m_description);
-    writer.Write(static_cast<int32_t>(m_state));
-    writer.Write(m_experienceReward);
-    
-    // Write skill requirements
-    writer.Write(static_cast<uint32_t>(m_skillRequirements.size()));
-    for (const auto& pair : m_skillRequirements) {
-        writer.Write(pair.first);  // Skill name
-        writer.Write(pair.second); // Required level
-    }
+    FieldSerializer::WriteBinary(writer, *this);
 }
 
 void Quest::Deserialize(BinaryReader& reader) {
-    reader.Read(m_id);
-    reader.Read(m_title);
-    reader.Read(m_description);
-    
-    int32_t stateValue = 0;
-    reader.Read(stateValue);
-    m_state = static_cast<QuestState>(stateValue);
-    
-    reader.Read(m_experienceReward);
-    
-    // Read skill requirements
-    uint32_t requirementCount = 0;
-    reader.Read(requirementCount);
-    
-    m_skillRequirements.clear();
-    for (uint32_t i = 0; i < requirementCount; ++i) {
-        std::string skillName;
-        int requiredLevel = 0;
-        reader.Read(skillName);
-        reader.Read(requiredLevel);
-        m_skillRequirements[skillName] = requiredLevel;
-    }
+    FieldSerializer::ReadBinary(reader, *this);
 }
 
 void Quest::SerializeToText(TextWriter& writer) const {
-    writer.Write("questId", m_id);
-    writer.Write("questTitle", m_title);
-    writer.Write("questDescription", m_description);
-    writer.Write("questState", static_cast<int>(m_state));
-    writer.Write("questExperienceReward", m_experienceReward);
-    
-    // Write skill requirements count
-    writer.Write("questSkillReqCount", static_cast<int>(m_skillRequirements.size()));
-    
-    // Write each skill requirement
-    int index = 0;
-    for (const auto& pair : m_skillRequirements) {
-        std::string prefix = "questSkillReq" + std::to_string(index) + "_";
-        writer.Write(prefix + "skill", pair.first);
-        writer.Write(prefix + "level", pair.second);
-        index++;
-    }
+    FieldSerializer::WriteText(writer, *this);
 }
 
-// Quest text deserialization
 void Quest::DeserializeFromText(TextReader& reader) {
-    reader.Read("questId", m_id);
-    reader.Read("questTitle", m_title);
-    reader.Read("questDescription", m_description);
-    
-    int state = 0;
-    reader.Read("questState", state);
-    m_state = static_cast<QuestState>(state);
-    
-    reader.Read("questExperienceReward", m_experienceReward);
-    
-    // Read skill requirements
-    int reqCount = 0;
-    reader.Read("questSkillReqCount", reqCount);
-    
-    m_skillRequirements.clear();
-    for (int i = 0; i < reqCount; i++) {
-        std::string prefix = "questSkillReq" + std::to_string(i) + "_";
-        
-        std::string skillName;
-        int requiredLevel = 0;
-        
-        reader.Read(prefix + "skill", skillName);
-        reader.Read(prefix + "level", requiredLevel);
-        
-        m_skillRequirements[skillName] = requiredLevel;
+    FieldSerializer::ReadText(reader, *this);
+}
+
+void Quest::SerializeToJson(JsonWriter& writer) const {
+    FieldSerializer::WriteJson(writer, *this);
+}
+
+void Quest::DeserializeFromJson(const nlohmann::json& value) {
+    FieldSerializer::ReadJsonObject(*this, value);
+}
+
+bool Quest::CheckFields() {
+    if (IsValidQuestState(m_state)) {
+        return true;
     }
+    LOG(Warning, "Quest {0} has out-of-range state {1}, reset to available", String(m_id.c_str()), static_cast<int>(m_state));
+    m_state = QuestState::Available;
+    return false;
 }
 
 QuestSystem::QuestSystem() {
@@ -131,16 +152,46 @@ QuestSystem::~QuestSystem() {
 }
 
 void QuestSystem::Initialize() {
+    // Published immediately, so requirement counters are current when ActivateQuest asks
+    m_plugin->GetEventSystem().Subscribe<SkillLevelChangedEvent>(
+        [this](const SkillLevelChangedEvent& event) {
+            this->HandleSkillLevelChanged(event);
+        });
+    
+    auto* saveLoadSystem = m_plugin->GetSystem<SaveLoadSystem>();
+    if (saveLoadSystem) {
+        saveLoadSystem->RegisterChunkUpgrade(GetName(), 1, UpgradeQuestsFromSchema1, UpgradeQuestDeltaFromSchema1);
+    }
+    
     LOG(Info, "Quest System Initialized.");
 }
 
 void QuestSystem::Shutdown() {
     m_quests.clear();
+    m_table.Clear();
+    m_requirements.Clear();
+    m_requirementsStale = true;
+    m_graph.Clear();
+    m_graphStale = true;
+    m_timers.Clear();
+    m_timersStale = true;
     LOG(Info, "Quest System Shutdown.");
 }
 
 void QuestSystem::Update(float deltaTime) {
-    // Check for time-based quest updates
+    // Time limits that came due since the last update, earliest first
+    auto* timeSystem = m_plugin->GetSystem<TimeSystem>();
+    if (!timeSystem) {
+        return;
+    }
+    int64_t now = timeSystem->GetTotalMinutes();
+    SyncTimers(now);
+    
+    m_expiredTimers.clear();
+    m_timers.TakeExpired(now, m_expiredTimers);
+    for (const QuestTimers::Expired& expired : m_expiredTimers) {
+        HandleExpiredTimer(expired);
+    }
 }
 
 QuestResult QuestSystem::AddQuest(const std::string& id, const std::string& title, const std::string& description) {
@@ -151,8 +202,24 @@ QuestResult QuestSystem::AddQuest(const std::string& id, const std::string& titl
     }
     
     try {
-        auto quest = std::make_unique<Quest>(id, title, description);
-        m_quests[id] = std::move(quest);
+        if (m_table.GetSize() == QuestTable::MaxQuests) {
+            LOG(Error, "Failed to add quest: {0}. Too many quests", String(id.c_str()));
+            return QuestResult::Error;
+        }
+        m_quests[id] = Quest(id, title, description);
+        m_table.Add(QuestState::Available);
+        m_table.MarkDirty(static_cast<uint32_t>(m_table.GetSize() - 1));
+        if (!m_requirementsStale) {
+            m_requirements.AddQuest(QuestRequirementIndex::Requirements(), nullptr);
+        }
+        if (!m_timersStale) {
+            m_timers.AddQuest(QuestTimers::Times(), 0);
+        }
+        if (!m_graphStale) {
+            m_graph.BindQuest(id, static_cast<uint32_t>(m_table.GetSize() - 1), [this](uint32_t index) {
+                return m_quests.GetEntry(index).second.GetState();
+            });
+        }
         
         LOG(Info, "Added quest: {0}", String(title.c_str()));
         return QuestResult::Success;
@@ -165,32 +232,62 @@ QuestResult QuestSystem::AddQuest(const std::string& id, const std::string& titl
 }
 
 QuestResult QuestSystem::ActivateQuest(const std::string& id) {
-    auto it = m_quests.find(id);
-    if (it == m_quests.end()) {
+    QuestHandle handle = FindQuest(id);
+    if (!handle) {
         LOG(Warning, "Quest not found: {0}", String(id.c_str()));
         return QuestResult::NotFound;
     }
+    return ActivateQuest(handle);
+}
 
-    Quest* quest = it->second.get();
+QuestResult QuestSystem::ActivateQuest(QuestHandle handle) {
+    uint32_t index = m_table.Find(handle);
+    if (index == QuestTable::InvalidIndex) {
+        LOG(Warning, "Quest handle not valid: {0}", handle.value);
+        return QuestResult::NotFound;
+    }
+    Quest* quest = &m_quests.EditAt(index);
+    const std::string& id = m_quests.GetEntry(index).first;
+    
     if (quest->GetState() != QuestState::Available) {
         LOG(Warning, "Quest not available: {0}", String(id.c_str()));
         return QuestResult::InvalidState;
     }
-
+    
+    int64_t now = GetGameMinute();
+    if (!quest->IsInAvailabilityWindow(now)) {
+        LOG(Info, "Quest outside its availability window: {0}", String(id.c_str()));
+        return QuestResult::OutsideTimeWindow;
+    }
+    if (quest->IsPastDeadline(now)) {
+        // Its deadline entry has already been taken, so it would never fail
+        LOG(Info, "Quest deadline has passed: {0}", String(id.c_str()));
+        return QuestResult::OutsideTimeWindow;
+    }
+    
+    SyncGraph();
+    if (!m_graph.ArePrerequisitesMet(index)) {
+        LOG(Info, "Quest prerequisites not met: {0}", String(id.c_str()));
+        return QuestResult::PrerequisitesNotMet;
+    }
+    
     // Check character progression requirements
     auto* progressionSystem = m_plugin->GetSystem<CharacterProgressionSystem>();
-
+    
     if (progressionSystem) {
-        if (!quest->CheckRequirements(progressionSystem->GetSkills())) {
+        SyncRequirements(*progressionSystem);
+        if (!m_requirements.IsUnlocked(index)) {
             LOG(Info, "Character doesn't meet quest requirements: {0}", String(id.c_str()));
             return QuestResult::RequirementsNotMet;
         }
     }
-
+    
     // Store old state and update to new state
     QuestState oldState = quest->GetState();
     quest->SetState(QuestState::Active);
-
+    m_table.SetState(index, QuestState::Active);
+    m_table.MarkDirty(index);
+    
     // Create and publish event
     QuestStateChangedEvent event;
     event.questId = id;
@@ -204,19 +301,29 @@ QuestResult QuestSystem::ActivateQuest(const std::string& id) {
 }
 
 QuestResult QuestSystem::CompleteQuest(const std::string& id) {
+    QuestHandle handle = FindQuest(id);
+    if (!handle) {
+        LOG(Warning, "Quest not found: {0}", String(id.c_str()));
+        return QuestResult::NotFound;
+    }
+    return CompleteQuest(handle);
+}
+
+QuestResult QuestSystem::CompleteQuest(QuestHandle handle) {
     std::string questTitle;
     int experienceReward = 0;
     QuestState oldState;
     bool success = false;
     
-        
-    auto it = m_quests.find(id);
-    if (it == m_quests.end()) {
-        LOG(Warning, "Quest not found: {0}", String(id.c_str()));
+    
+    uint32_t index = m_table.Find(handle);
+    if (index == QuestTable::InvalidIndex) {
+        LOG(Warning, "Quest handle not valid: {0}", handle.value);
         return QuestResult::NotFound;
     }
+    Quest* quest = &m_quests.EditAt(index);
+    const std::string& id = m_quests.GetEntry(index).first;
     
-    Quest* quest = it->second.get();
     if (quest->GetState() != QuestState::Active) {
         LOG(Warning, "Quest not active: {0}", String(id.c_str()));
         return QuestResult::InvalidState;
@@ -226,7 +333,11 @@ QuestResult QuestSystem::CompleteQuest(const std::string& id) {
     questTitle = quest->GetTitle();
     experienceReward = quest->GetExperienceReward();
     
+    // Bound before the state changes, so the finish below is counted once
+    SyncGraph();
     quest->SetState(QuestState::Completed);
+    m_table.SetState(index, QuestState::Completed);
+    m_table.MarkDirty(index);
     success = true;
     
     if (success) {
@@ -244,7 +355,11 @@ QuestResult QuestSystem::CompleteQuest(const std::string& id) {
         stateEvent.oldState = oldState;
         stateEvent.newState = QuestState::Completed;
         m_plugin->GetEventSystem().Publish(stateEvent);
-
+        
+        m_unlockedQuests.clear();
+        m_graph.QuestFinished(index, QuestState::Completed, m_unlockedQuests);
+        PublishUnlockedQuests();
+        
         LOG(Info, "Completed quest: {0}", String(id.c_str()));
         return QuestResult::Success;
     }
@@ -253,17 +368,27 @@ QuestResult QuestSystem::CompleteQuest(const std::string& id) {
 }
 
 QuestResult QuestSystem::FailQuest(const std::string& id) {
+    QuestHandle handle = FindQuest(id);
+    if (!handle) {
+        LOG(Warning, "Quest not found: {0}", String(id.c_str()));
+        return QuestResult::NotFound;
+    }
+    return FailQuest(handle);
+}
+
+QuestResult QuestSystem::FailQuest(QuestHandle handle) {
     std::string questTitle;
     QuestState oldState;
     bool success = false;
     
-    auto it = m_quests.find(id);
-    if (it == m_quests.end()) {
-        LOG(Warning, "Quest not found: {0}", String(id.c_str()));
+    uint32_t index = m_table.Find(handle);
+    if (index == QuestTable::InvalidIndex) {
+        LOG(Warning, "Quest handle not valid: {0}", handle.value);
         return QuestResult::NotFound;
     }
+    Quest* quest = &m_quests.EditAt(index);
+    const std::string& id = m_quests.GetEntry(index).first;
     
-    Quest* quest = it->second.get();
     if (quest->GetState() != QuestState::Active) {
         LOG(Warning, "Quest not active: {0}", String(id.c_str()));
         return QuestResult::InvalidState;
@@ -271,9 +396,12 @@ QuestResult QuestSystem::FailQuest(const std::string& id) {
     
     oldState = quest->GetState();
     questTitle = quest->GetTitle();
+    SyncGraph();
     quest->SetState(QuestState::Failed);
+    m_table.SetState(index, QuestState::Failed);
+    m_table.MarkDirty(index);
     success = true;
-
+    
     if (success) {
         QuestStateChangedEvent event;
         event.questId = id;
@@ -281,7 +409,11 @@ QuestResult QuestSystem::FailQuest(const std::string& id) {
         event.oldState = oldState;
         event.newState = QuestState::Failed;
         m_plugin->GetEventSystem().Publish(event);
-
+        
+        m_unlockedQuests.clear();
+        m_graph.QuestFinished(index, QuestState::Failed, m_unlockedQuests);
+        PublishUnlockedQuests();
+        
         LOG(Info, "Failed quest: {0}", String(id.c_str()));
         return QuestResult::Success;
     }
@@ -289,168 +421,535 @@ QuestResult QuestSystem::FailQuest(const std::string& id) {
     return QuestResult::Error;
 }
 
-Quest* QuestSystem::GetQuest(const std::string& id) {    
+QuestHandle QuestSystem::FindQuest(const std::string& id) const {
     auto it = m_quests.find(id);
-    if (it == m_quests.end()) { return nullptr; }
-    return it->second.get();
+    if (it == m_quests.end()) { return QuestHandle(); }
+    return m_table.GetHandle(static_cast<uint32_t>(it.GetIndex()));
 }
 
-std::vector<Quest*> QuestSystem::GetAvailableQuests() const {
-    std::vector<Quest*> result;
-    for (const auto& pair : m_quests) {
-        if (pair.second->GetState() == QuestState::Available) {
-            result.push_back(pair.second.get());
+QuestState QuestSystem::GetQuestState(QuestHandle quest) const {
+    uint32_t index = m_table.Find(quest);
+    if (index == QuestTable::InvalidIndex) { return QuestState::Available; }
+    return m_quests.GetEntry(index).second.GetState();
+}
+
+bool QuestSystem::AreRequirementsMet(QuestHandle quest) const {
+    uint32_t index = m_table.Find(quest);
+    if (index == QuestTable::InvalidIndex) { return false; }
+    
+    auto* progressionSystem = m_plugin->GetSystem<CharacterProgressionSystem>();
+    if (!progressionSystem) { return true; }
+    SyncRequirements(*progressionSystem);
+    return m_requirements.IsUnlocked(index);
+}
+
+void QuestSystem::AddQuestPrerequisite(const std::string& questId, const std::string& prerequisiteId, QuestPrerequisite kind) {
+    m_graph.AddPrerequisite(questId, prerequisiteId, kind);
+}
+
+void QuestSystem::SetPrerequisiteMode(const std::string& questId, PrerequisiteMode mode) {
+    m_graph.SetMode(questId, mode);
+}
+
+bool QuestSystem::BuildQuestGraph() {
+    m_graphStale = true;
+    if (!m_graph.Build()) {
+        return false;
+    }
+    LOG(Info, "Quest graph built: {0} quests, {1} prerequisites",
+        static_cast<int>(m_graph.GetNodeCount()), static_cast<int>(m_graph.GetEdgeCount()));
+    return true;
+}
+
+bool QuestSystem::ArePrerequisitesMet(QuestHandle quest) const {
+    uint32_t index = m_table.Find(quest);
+    if (index == QuestTable::InvalidIndex) { return false; }
+    
+    SyncGraph();
+    return m_graph.ArePrerequisitesMet(index);
+}
+
+QuestResult QuestSystem::SetQuestDeadline(const std::string& id, int64_t deadline) {
+    QuestHandle handle = FindQuest(id);
+    if (!handle) {
+        LOG(Warning, "Quest not found: {0}", String(id.c_str()));
+        return QuestResult::NotFound;
+    }
+    return SetQuestDeadline(handle, deadline);
+}
+
+QuestResult QuestSystem::SetQuestAvailability(const std::string& id, int64_t availableFrom, int64_t availableUntil) {
+    QuestHandle handle = FindQuest(id);
+    if (!handle) {
+        LOG(Warning, "Quest not found: {0}", String(id.c_str()));
+        return QuestResult::NotFound;
+    }
+    return SetQuestAvailability(handle, availableFrom, availableUntil);
+}
+
+QuestResult QuestSystem::SetQuestDeadline(QuestHandle handle, int64_t deadline) {
+    uint32_t index = m_table.Find(handle);
+    if (index == QuestTable::InvalidIndex) {
+        LOG(Warning, "Quest handle not valid: {0}", handle.value);
+        return QuestResult::NotFound;
+    }
+    
+    Quest& quest = m_quests.EditAt(index);
+    quest.SetDeadline(deadline);
+    m_table.MarkDirty(index);
+    if (!m_timersStale) {
+        m_timers.UpdateQuest(index, GetTimes(quest), GetGameMinute());
+    }
+    return QuestResult::Success;
+}
+
+QuestResult QuestSystem::SetQuestAvailability(QuestHandle handle, int64_t availableFrom, int64_t availableUntil) {
+    uint32_t index = m_table.Find(handle);
+    if (index == QuestTable::InvalidIndex) {
+        LOG(Warning, "Quest handle not valid: {0}", handle.value);
+        return QuestResult::NotFound;
+    }
+    
+    Quest& quest = m_quests.EditAt(index);
+    quest.SetAvailabilityWindow(availableFrom, availableUntil);
+    m_table.MarkDirty(index);
+    if (!m_timersStale) {
+        m_timers.UpdateQuest(index, GetTimes(quest), GetGameMinute());
+    }
+    return QuestResult::Success;
+}
+
+size_t QuestSystem::AddQuests(std::vector<QuestDefinition>&& definitions) {
+    if (m_table.GetSize() + definitions.size() > QuestTable::MaxQuests) {
+        LOG(Error, "Failed to add {0} quests. Too many quests", static_cast<int>(definitions.size()));
+        return 0;
+    }
+    
+    // Requirements and timers are rebuilt once on first use instead of growing per quest
+    m_quests.reserve(m_quests.size() + definitions.size());
+    m_table.Reserve(m_table.GetSize() + definitions.size());
+    m_requirementsStale = true;
+    m_timersStale = true;
+    m_graphStale = true;
+    
+    size_t added = 0;
+    size_t duplicates = 0;
+    std::string firstDuplicate;
+    bool hasPrerequisites = false;
+    for (QuestDefinition& definition : definitions) {
+        Quest quest(definition.id, std::move(definition.title), std::move(definition.description));
+        quest.SetExperienceReward(definition.experienceReward);
+        for (const auto& requirement : definition.skillRequirements) {
+            quest.AddSkillRequirement(requirement.first, requirement.second);
+        }
+        quest.SetAvailabilityWindow(definition.availableFrom, definition.availableUntil);
+        quest.SetDeadline(definition.deadline);
+        if (!m_quests.insert(definition.id, std::move(quest))) {
+            if (duplicates++ == 0) {
+                firstDuplicate = definition.id;
+            }
+            continue;
+        }
+        m_table.Add(QuestState::Available);
+        m_table.MarkDirty(static_cast<uint32_t>(m_table.GetSize() - 1));
+        added++;
+        
+        for (const std::string& prerequisiteId : definition.requiresCompleted) {
+            m_graph.AddPrerequisite(definition.id, prerequisiteId, QuestPrerequisite::Completed);
         }
+        for (const std::string& prerequisiteId : definition.requiresFailed) {
+            m_graph.AddPrerequisite(definition.id, prerequisiteId, QuestPrerequisite::Failed);
+        }
+        if (definition.anyPrerequisite) {
+            m_graph.SetMode(definition.id, PrerequisiteMode::AnyOf);
+        }
+        hasPrerequisites = hasPrerequisites || !definition.requiresCompleted.empty() || !definition.requiresFailed.empty();
+    }
+    
+    if (hasPrerequisites) {
+        BuildQuestGraph();
+    }
+    if (duplicates > 0) {
+        LOG(Warning, "Skipped {0} quests that already exist, starting with {1}",
+            static_cast<int>(duplicates), String(firstDuplicate.c_str()));
+    }
+    LOG(Info, "Added {0} quests", static_cast<int>(added));
+    return added;
+}
+
+bool QuestSystem::LoadQuestContent(const std::string& filename) {
+    std::vector<QuestDefinition> definitions;
+    if (!ReadQuestContent(filename, definitions)) {
+        return false;
+    }
+    AddQuests(std::move(definitions));
+    return true;
+}
+
+Quest* QuestSystem::GetQuest(const std::string& id) {    
+    return GetQuest(FindQuest(id));
+}
+
+Quest* QuestSystem::GetQuest(QuestHandle quest) {
+    uint32_t index = m_table.Find(quest);
+    if (index == QuestTable::InvalidIndex) { return nullptr; }
+    
+    // The caller may modify the quest through this pointer, its state included
+    m_table.Watch(index);
+    m_table.MarkDirty(index);
+    return &m_quests.EditAt(index);
+}
+
+void QuestSystem::MarkQuestDirty(const std::string& id) {
+    auto it = m_quests.find(id);
+    if (it != m_quests.end()) {
+        m_table.MarkDirty(static_cast<uint32_t>(it.GetIndex()));
+    }
+}
+
+QuestRange QuestSystem::GetQuestsInState(QuestState state) const {
+    SyncTable();
+    return QuestRange(m_table.GetGroup(state), m_quests);
+}
+
+std::vector<const Quest*> QuestSystem::GetAvailableQuests() const {
+    QuestRange quests = GetQuestsInState(QuestState::Available);
+    std::vector<const Quest*> result;
+    result.reserve(quests.size());
+    for (const Quest& quest : quests) {
+        result.push_back(&quest);
     }
     return result;
 }
 
-std::vector<Quest*> QuestSystem::GetActiveQuests() const {
-    std::vector<Quest*> result;
-    for (const auto& pair : m_quests) {
-        if (pair.second->GetState() == QuestState::Active) {
-            result.push_back(pair.second.get());
-        }
+std::vector<const Quest*> QuestSystem::GetActiveQuests() const {
+    QuestRange quests = GetQuestsInState(QuestState::Active);
+    std::vector<const Quest*> result;
+    result.reserve(quests.size());
+    for (const Quest& quest : quests) {
+        result.push_back(&quest);
     }
     return result;
 }
 
-std::vector<Quest*> QuestSystem::GetCompletedQuests() const {
-    std::vector<Quest*> result;
-    for (const auto& pair : m_quests) {
-        if (pair.second->GetState() == QuestState::Completed) {
-            result.push_back(pair.second.get());
-        }
+std::vector<const Quest*> QuestSystem::GetCompletedQuests() const {
+    QuestRange quests = GetQuestsInState(QuestState::Completed);
+    std::vector<const Quest*> result;
+    result.reserve(quests.size());
+    for (const Quest& quest : quests) {
+        result.push_back(&quest);
     }
     return result;
 }
 
-std::vector<Quest*> QuestSystem::GetFailedQuests() const {
-    std::vector<Quest*> result;
-    for (const auto& pair : m_quests) {
-        if (pair.second->GetState() == QuestState::Failed) {
-            result.push_back(pair.second.get());
-        }
+std::vector<const Quest*> QuestSystem::GetFailedQuests() const {
+    QuestRange quests = GetQuestsInState(QuestState::Failed);
+    std::vector<const Quest*> result;
+    result.reserve(quests.size());
+    for (const Quest& quest : quests) {
+        result.push_back(&quest);
     }
     return result;
 }
 
-void QuestSystem::Serialize(BinaryWriter& writer) const {
-    // Write quests
-    writer.Write(static_cast<uint32_t>(m_quests.size()));
+void QuestSystem::RebuildTable() {
+    // Requirements are rebuilt on the game thread, which may read skills mid-load
+    m_requirementsStale = true;
+    m_graphStale = true;
+    m_timersStale = true;
+    m_table.Clear();
+    m_table.Reserve(m_quests.size());
     for (const auto& pair : m_quests) {
-        writer.Write(pair.first);  // Quest ID
-        
-        // Write quest data
-        writer.Write(pair.second->GetId());
-        writer.Write(pair.second->GetTitle());
-        writer.Write(pair.second->GetDescription());
-        writer.Write(static_cast<int32_t>(pair.second->GetState()));
-        writer.Write(pair.second->GetExperienceReward());
+        m_table.Add(pair.second.GetState());
+    }
+}
+
+void QuestSystem::SyncTable() const {
+    bool changed = m_table.SyncWatched([this](uint32_t index) {
+        return m_quests.GetEntry(index).second.GetState();
+    });
+    if (changed) {
+        // A state set through a pointer may have met or unmet any prerequisite
+        m_graphStale = true;
+    }
+}
+
+void QuestSystem::ForgetEditedQuests() const {
+    // Pointers from GetQuest end with a save, so their quests need no more watching
+    SyncTable();
+    auto* progressionSystem = m_plugin ? m_plugin->GetSystem<CharacterProgressionSystem>() : nullptr;
+    if (progressionSystem && !m_requirementsStale) {
+        SyncRequirements(*progressionSystem);
+    }
+    m_table.ClearWatched();
+}
+
+void QuestSystem::SyncRequirements(const CharacterProgressionSystem& progression, const SkillLevelChangedEvent* change) const {
+    // A skill change being handled is looked up at its old level; applying it comes next
+    const SnapshotMap<int>& skills = progression.GetSkills();
+    QuestRequirementIndex::SkillLookup lookup = [&skills, change](const std::string& skillId, int& level) {
+        if (change && skillId == change->skillId) {
+            level = change->oldLevel;
+            return !change->added;
+        }
+        auto it = skills.find(skillId);
+        if (it == skills.end()) {
+            return false;
+        }
+        level = it->second;
+        return true;
+    };
+    
+    if (m_requirementsStale || m_requirementsRevision != progression.GetSkillsRevision()) {
+        m_requirements.Clear();
+        m_requirements.Reserve(m_quests.size());
+        for (const auto& pair : m_quests) {
+            m_requirements.AddQuest(pair.second.GetSkillRequirements(), lookup);
+        }
+        m_requirementsStale = false;
+        m_requirementsRevision = progression.GetSkillsRevision();
+        return;
+    }
+    
+    // Quests handed out by GetQuest may have gained requirements
+    for (uint32_t index : m_table.GetWatched()) {
+        m_requirements.UpdateQuest(index, m_quests.GetEntry(index).second.GetSkillRequirements(), lookup);
+    }
+}
+
+void QuestSystem::SyncGraph() const {
+    SyncTable();
+    if (!m_graphStale) {
+        return;
+    }
+    
+    m_graph.Bind(m_quests.size(),
+        [this](const std::string& questId) {
+            auto it = m_quests.find(questId);
+            return it == m_quests.end() ? QuestGraph::InvalidIndex : static_cast<uint32_t>(it.GetIndex());
+        },
+        [this](uint32_t index) {
+            return m_quests.GetEntry(index).second.GetState();
+        });
+    m_graphStale = false;
+}
+
+void QuestSystem::HandleSkillLevelChanged(const SkillLevelChangedEvent& event) {
+    auto* progressionSystem = m_plugin->GetSystem<CharacterProgressionSystem>();
+    if (!progressionSystem) {
+        return;
+    }
+    SyncRequirements(*progressionSystem, &event);
+    
+    m_unlockedQuests.clear();
+    m_requirements.SetSkillLevel(event.skillId, event.newLevel, m_unlockedQuests);
+    PublishUnlockedQuests();
+}
+
+void QuestSystem::PublishUnlockedQuests() {
+    // Unlocked by one of skills, prerequisites or the window opening; all have to be met
+    auto* progressionSystem = m_plugin->GetSystem<CharacterProgressionSystem>();
+    if (progressionSystem) {
+        SyncRequirements(*progressionSystem);
+    }
+    SyncGraph();
+    int64_t now = GetGameMinute();
+    
+    for (uint32_t index : m_unlockedQuests) {
+        const Quest& quest = m_quests.GetEntry(index).second;
+        if (quest.GetState() != QuestState::Available || !m_graph.ArePrerequisitesMet(index)) {
+            continue;
+        }
+        if (!quest.IsInAvailabilityWindow(now) || quest.IsPastDeadline(now)) {
+            continue;
+        }
+        if (progressionSystem && !m_requirements.IsUnlocked(index)) {
+            continue;
+        }
         
-        // Write skill requirements
-        auto quest = pair.second.get();
-        const auto& reqMap = quest->GetSkillRequirements();
-        writer.Write(static_cast<uint32_t>(reqMap.size()));
+        QuestUnlockedEvent unlockedEvent;
+        unlockedEvent.questId = quest.GetId();
+        unlockedEvent.questTitle = quest.GetTitle();
+        m_plugin->GetEventSystem().Publish(unlockedEvent);
         
-        for (const auto& reqPair : reqMap) {
-            writer.Write(reqPair.first);  // Skill name
-            writer.Write(reqPair.second); // Required level
+        LOG(Info, "Unlocked quest: {0}", String(unlockedEvent.questId.c_str()));
+    }
+}
+
+int64_t QuestSystem::GetGameMinute() const {
+    auto* timeSystem = m_plugin ? m_plugin->GetSystem<TimeSystem>() : nullptr;
+    return timeSystem ? timeSystem->GetTotalMinutes() : 0;
+}
+
+void QuestSystem::SyncTimers(int64_t now) const {
+    if (m_timersStale) {
+        m_timers.Clear();
+        m_timers.Reserve(m_quests.size());
+        for (const auto& pair : m_quests) {
+            m_timers.AddQuest(GetTimes(pair.second), now);
         }
+        m_timersStale = false;
+        return;
+    }
+    
+    // Quests handed out by GetQuest may have new limits
+    for (uint32_t index : m_table.GetWatched()) {
+        m_timers.UpdateQuest(index, GetTimes(m_quests.GetEntry(index).second), now);
+    }
+}
+
+void QuestSystem::HandleExpiredTimer(const QuestTimers::Expired& expired) {
+    const Quest& quest = m_quests.GetEntry(expired.index).second;
+    QuestState oldState = quest.GetState();
+    if (expired.kind == QuestTimers::Kind::Opens) {
+        m_unlockedQuests.assign(1, expired.index);
+        PublishUnlockedQuests();
+        return;
     }
     
+    // A window only matters to quests not yet taken, a deadline to active ones
+    bool closed = expired.kind == QuestTimers::Kind::Closes && oldState == QuestState::Available;
+    bool overdue = expired.kind == QuestTimers::Kind::Deadline && oldState == QuestState::Active;
+    if (!closed && !overdue) {
+        return;
+    }
+    
+    SyncGraph();
+    Quest& failed = m_quests.EditAt(expired.index);
+    failed.SetState(QuestState::Failed);
+    m_table.SetState(expired.index, QuestState::Failed);
+    m_table.MarkDirty(expired.index);
+    
+    QuestStateChangedEvent event;
+    event.questId = failed.GetId();
+    event.questTitle = failed.GetTitle();
+    event.oldState = oldState;
+    event.newState = QuestState::Failed;
+    m_plugin->GetEventSystem().Publish(event);
+    
+    if (closed) {
+        LOG(Info, "Quest availability window closed: {0}", String(event.questId.c_str()));
+    } else {
+        LOG(Info, "Quest deadline passed: {0}", String(event.questId.c_str()));
+    }
+    
+    m_unlockedQuests.clear();
+    m_graph.QuestFinished(expired.index, QuestState::Failed, m_unlockedQuests);
+    PublishUnlockedQuests();
+}
+
+void QuestSystem::Serialize(BinaryWriter& writer) const {
+    // Each quest is written as its id followed by Quest::Serialize's layout
+    FieldSerializer::WriteBinary(writer, *this);
     LOG(Info, "QuestSystem serialized");
 }
 
 void QuestSystem::Deserialize(BinaryReader& reader) {
-    // Clear existing data
-    m_quests.clear();
+    FieldSerializer::ReadBinary(reader, *this);
+    RebuildTable();
+    LOG(Info, "QuestSystem deserialized");
+}
+
+std::function<void()> QuestSystem::DecodeDeferred(BinaryReader& reader) {
+    // Decoded into a separate quest map, the live one is swapped out when applied
+    auto values = std::make_shared<FieldSerializer::FieldValues<QuestSystem>>();
+    FieldSerializer::ReadBinaryValues<QuestSystem>(reader, *values);
+    return [this, values]() {
+        FieldSerializer::AssignValues(*this, *values);
+        RebuildTable();
+        LOG(Info, "QuestSystem deserialized");
+    };
+}
+
+std::function<void(BinaryWriter&)> QuestSystem::SnapshotState() const {
+    // O(1): the quest map shares its pages with the snapshot until they change
+    ForgetEditedQuests();
+    return [values = FieldSerializer::SnapshotValues(*this)](BinaryWriter& writer) {
+        FieldSerializer::WriteBinaryValues(writer, values);
+        LOG(Info, "QuestSystem serialized");
+    };
+}
+
+void QuestSystem::SerializeDelta(BinaryWriter& writer) const {
+    const std::vector<uint32_t>& dirty = m_table.GetDirty();
+    writer.Write(static_cast<uint32_t>(dirty.size()));
+    for (uint32_t index : dirty) {
+        // Every dirty quest still exists; the flag lets replay drop removed quests
+        const auto& entry = m_quests.GetEntry(index);
+        writer.Write(entry.first);
+        writer.Write(true);
+        entry.second.Serialize(writer);
+    }
     
-    // Read quests
+    LOG(Info, "QuestSystem delta serialized: {0} quests", static_cast<int>(dirty.size()));
+}
+
+void QuestSystem::DeserializeDelta(BinaryReader& reader) {
     uint32_t questCount = 0;
     reader.Read(questCount);
+    SyncTable();
+    m_requirementsStale = true;
+    m_graphStale = true;
+    m_timersStale = true;
     
-    for (uint32_t i = 0; i < questCount; ++i) {
+    for (uint32_t i = 0; i < questCount && !reader.HasFailed(); ++i) {
         std::string questId;
+        bool exists = false;
         reader.Read(questId);
+        reader.Read(exists);
         
-        // Read quest data
-        std::string id, title, description;
-        int32_t stateValue = 0;
-        int expReward = 0;
-        
-        reader.Read(id);
-        reader.Read(title);
-        reader.Read(description);
-        reader.Read(stateValue);
-        reader.Read(expReward);
-        
-        // Create quest
-        auto quest = std::make_unique<Quest>(id, title, description);
-        quest->SetState(static_cast<QuestState>(stateValue));
-        quest->SetExperienceReward(expReward);
-        
-        // Read skill requirements
-        uint32_t reqCount = 0;
-        reader.Read(reqCount);
-        
-        for (uint32_t j = 0; j < reqCount; ++j) {
-            std::string skillName;
-            int requiredLevel = 0;
-            reader.Read(skillName);
-            reader.Read(requiredLevel);
-            quest->AddSkillRequirement(skillName, requiredLevel);
+        auto it = m_quests.find(questId);
+        if (exists) {
+            Quest quest;
+            quest.Deserialize(reader);
+            QuestState state = quest.GetState();
+            if (it != m_quests.end()) {
+                uint32_t index = static_cast<uint32_t>(it.GetIndex());
+                m_quests.EditAt(index) = std::move(quest);
+                m_table.SetState(index, state);
+            } else {
+                m_quests[questId] = std::move(quest);
+                m_table.Add(state);
+            }
+        } else if (it != m_quests.end()) {
+            m_table.Erase(static_cast<uint32_t>(it.GetIndex()));
+            m_quests.erase(questId);
         }
-        
-        m_quests[questId] = std::move(quest);
     }
     
-    LOG(Info, "QuestSystem deserialized");
+    LOG(Info, "QuestSystem delta deserialized: {0} quests", static_cast<int>(questCount));
 }
 
 void QuestSystem::SerializeToText(TextWriter& writer) const {
-    // Write quest count
-    writer.Write("questCount", static_cast<int>(m_quests.size()));
-    
-    // Write each quest
-    int index = 0;
-    for (const auto& pair : m_quests) {
-        std::string prefix = "quest" + std::to_string(index) + "_";
-        writer.Write(prefix + "id", pair.first);
-        
-        // Let the quest serialize itself with the prefix
-        pair.second->SerializeToText(writer);
-        
-        index++;
-    }
-    
+    // Quests are written in id order, each under its own "quests<index>_" scope
+    FieldSerializer::WriteText(writer, *this);
     LOG(Info, "QuestSystem serialized to text");
 }
 
 void QuestSystem::DeserializeFromText(TextReader& reader) {
-    // Clear existing data
     m_quests.clear();
     
-    // Read quest count
-    int questCount = 0;
-    reader.Read("questCount", questCount);
-    
-    // Read each quest
-    for (int i = 0; i < questCount; i++) {
-        std::string prefix = "quest" + std::to_string(i) + "_";
-        
-        std::string questId;
-        reader.Read(prefix + "id", questId);
-        
-        // Create a placeholder quest
-        auto quest = std::make_unique<Quest>("", "", "");
-        
-        // Let the quest deserialize itself
-        quest->DeserializeFromText(reader);
-        
-        m_quests[questId] = std::move(quest);
-    }
-    
+    FieldSerializer::ReadText(reader, *this);
+    RebuildTable();
     LOG(Info, "QuestSystem deserialized from text");
 }
+
+void QuestSystem::SerializeToJson(JsonWriter& writer) const {
+    FieldSerializer::WriteJson(writer, *this);
+}
+
+void QuestSystem::BeginJsonLoad() {
+    FieldSerializer::ClearContainers(*this);
+    m_table.Clear();
+}
+
+void QuestSystem::DeserializeJsonField(const std::string& field, const nlohmann::json& value) {
+    // Quests arrive one at a time, the full array is never held in memory
+    FieldSerializer::ReadJsonField(*this, field, value);
+}
+
+void QuestSystem::EndJsonLoad() {
+    RebuildTable();
+    LOG(Info, "QuestSystem deserialized from JSON: {0} quests", static_cast<int>(m_quests.size()));
+}
 // ^ QuestSystem.cpp
\ No newline at end of file
@@ -4,18 +4,27 @@
 #include "RPGSystem.h"
 #include "QuestEvents.h"
 #include "QuestTypes.h"
-#include "Serialization.h"
+#include "QuestTable.h"
+#include "QuestRequirementIndex.h"
+#include "QuestGraph.h"
+#include "QuestTimers.h"
+#include "QuestContent.h"
+#include "Reflection.h"
 
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
+#include <iterator>
 
 // Forward declaration
 class CharacterProgressionSystem;
+class SkillLevelChangedEvent;
 
 class Quest {
 public:
+    Quest() = default;
     Quest(const std::string& id, const std::string& title, const std::string& description);
     
     // Getters/Setters
@@ -28,11 +37,27 @@ public:
     void SetState(QuestState state) { m_state = state; }
     void SetExperienceReward(int reward) { m_experienceReward = reward; }
     
+    // Game-time limits in TimeSystem::GetTotalMinutes() minutes, 0 for none. A quest can
+    // only be activated inside its availability window and fails if the window closes
+    // first; an active quest fails at its deadline, after which it can't be activated.
+    int64_t GetAvailableFrom() const { return m_availableFrom; }
+    int64_t GetAvailableUntil() const { return m_availableUntil; }
+    int64_t GetDeadline() const { return m_deadline; }
+    bool IsInAvailabilityWindow(int64_t now) const {
+        return (m_availableFrom == 0 || now >= m_availableFrom) && (m_availableUntil == 0 || now < m_availableUntil);
+    }
+    bool IsPastDeadline(int64_t now) const { return m_deadline != 0 && now >= m_deadline; }
+    void SetAvailabilityWindow(int64_t availableFrom, int64_t availableUntil) {
+        m_availableFrom = availableFrom;
+        m_availableUntil = availableUntil;
+    }
+    void SetDeadline(int64_t deadline) { m_deadline = deadline; }
+    
     // Add required skill check
     void AddSkillRequirement(const std::string& skillName, int requiredLevel);
     
     // Check if player meets skill requirements
-    bool CheckRequirements(const std::unordered_map<std::string, int>& playerSkills) const;
+    bool CheckRequirements(const SnapshotMap<int>& playerSkills) const;
     const std::unordered_map<std::string, int>& GetSkillRequirements() const { return m_skillRequirements; }
 
     // For serialization
@@ -40,16 +65,77 @@ public:
     void Deserialize(BinaryReader& reader);
     void SerializeToText(TextWriter& writer) const;
     void DeserializeFromText(TextReader& reader);
+    void SerializeToJson(JsonWriter& writer) const;
+    void DeserializeFromJson(const nlohmann::json& value);
+    
+    // Resets a state out of range to Available, for FieldSerializer after each read
+    bool CheckFields();
+    
+    // Serialized fields, in save order
+    static constexpr auto Fields() {
+        return std::make_tuple(
+            MakeField("id", &Quest::m_id),
+            MakeField("title", &Quest::m_title),
+            MakeField("description", &Quest::m_description),
+            MakeField("state", &Quest::m_state),
+            MakeField("experienceReward", &Quest::m_experienceReward),
+            MakeField("skillRequirements", &Quest::m_skillRequirements),
+            MakeField("availableFrom", &Quest::m_availableFrom),
+            MakeField("availableUntil", &Quest::m_availableUntil),
+            MakeField("deadline", &Quest::m_deadline));
+    }
     
 private:
     std::string m_id;
     std::string m_title;
     std::string m_description;
-    QuestState m_state;
-    int m_experienceReward;
+    QuestState m_state = QuestState::Available;
+    int m_experienceReward = 0;
     
     // Requirements to take/complete the quest
     std::unordered_map<std::string, int> m_skillRequirements;
+    
+    int64_t m_availableFrom = 0;
+    int64_t m_availableUntil = 0;
+    int64_t m_deadline = 0;
+};
+
+// The quests in one state, read straight from QuestSystem's storage without copying.
+// Valid until the next quest is added or changes state, or the next save or load.
+class QuestRange {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Quest;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Quest*;
+        using reference = const Quest&;
+        
+        Iterator(const uint32_t* index, const SnapshotMap<Quest>* quests) : m_index(index), m_quests(quests) {}
+        
+        reference operator*() const { return m_quests->GetEntry(*m_index).second; }
+        pointer operator->() const { return &**this; }
+        Iterator& operator++() { ++m_index; return *this; }
+        bool operator==(const Iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const Iterator& other) const { return m_index != other.m_index; }
+    
+    private:
+        const uint32_t* m_index;
+        const SnapshotMap<Quest>* m_quests;
+    };
+    
+    QuestRange(const std::vector<uint32_t>& indices, const SnapshotMap<Quest>& quests)
+        : m_indices(&indices), m_quests(&quests) {}
+    
+    size_t size() const { return m_indices->size(); }
+    bool empty() const { return m_indices->empty(); }
+    Iterator begin() const { return Iterator(m_indices->data(), m_quests); }
+    Iterator end() const { return Iterator(m_indices->data() + m_indices->size(), m_quests); }
+
+private:
+    const std::vector<uint32_t>* m_indices;
+    const SnapshotMap<Quest>* m_quests;
 };
 
 class QuestSystem : public RPGSystem {
@@ -66,24 +152,93 @@ public:
     // Implement GetName from LinenSystem
     std::string GetName() const override { return "QuestSystem"; }
     
-    // Quest management
+    // Quest management. The id overloads look the quest up and call the handle ones.
     QuestResult AddQuest(const std::string& id, const std::string& title, const std::string& description);
     QuestResult ActivateQuest(const std::string& id);
     QuestResult CompleteQuest(const std::string& id);
     QuestResult FailQuest(const std::string& id);
+    QuestResult ActivateQuest(QuestHandle quest);
+    QuestResult CompleteQuest(QuestHandle quest);
+    QuestResult FailQuest(QuestHandle quest);
+    
+    // Handles skip the id lookup. They stay valid until their quest is removed or the
+    // next load; an invalid handle acts like an unknown id.
+    QuestHandle FindQuest(const std::string& id) const;
+    QuestState GetQuestState(QuestHandle quest) const;
 
-    // Quest queries
+    // Whether the character meets a quest's skill requirements. Kept up to date as skills
+    // change, which also fires QuestUnlockedEvent for available quests; O(1) to ask.
+    bool AreRequirementsMet(QuestHandle quest) const;
+    
+    // Prerequisite quests, declared as content loads and checked for cycles and ordered
+    // by BuildQuestGraph(). A quest with unmet prerequisites can't be activated. Finishing
+    // a quest only updates the quests waiting on it, firing QuestUnlockedEvent for those
+    // that are now available and meet their skill requirements.
+    void AddQuestPrerequisite(const std::string& questId, const std::string& prerequisiteId,
+                              QuestPrerequisite kind = QuestPrerequisite::Completed);
+    void SetPrerequisiteMode(const std::string& questId, PrerequisiteMode mode);
+    bool BuildQuestGraph();
+    const QuestGraph& GetQuestGraph() const { return m_graph; }
+    bool ArePrerequisitesMet(QuestHandle quest) const;
+    
+    // Game-time limits; see Quest. Update() only takes the limits that came due, earliest
+    // first, so even a jump of many days costs just the quests it expires. Each expiry
+    // publishes a QuestStateChangedEvent to Failed; a window opening on an otherwise
+    // unlocked quest publishes QuestUnlockedEvent.
+    QuestResult SetQuestDeadline(const std::string& id, int64_t deadline);
+    QuestResult SetQuestAvailability(const std::string& id, int64_t availableFrom, int64_t availableUntil);
+    QuestResult SetQuestDeadline(QuestHandle quest, int64_t deadline);
+    QuestResult SetQuestAvailability(QuestHandle quest, int64_t availableFrom, int64_t availableUntil);
+    
+    // Content loading. Adds the definitions in one batch: storage grows once, their
+    // prerequisites go into one BuildQuestGraph() and one summary is logged instead of a
+    // line per quest. Ids already taken are skipped. Returns the number of quests added.
+    size_t AddQuests(std::vector<QuestDefinition>&& definitions);
+    
+    // Reads a content file (see ReadQuestContent) and adds its quests
+    bool LoadQuestContent(const std::string& filename);
+    
+    // Quest queries. Quests live in copy-on-write storage (see SnapshotMap), so returned
+    // pointers are only good until the next save or load. Until then a quest may be
+    // modified through the pointer from GetQuest; the list queries are read-only.
+    // GetQuestsInState costs the number of quests in that state and allocates nothing;
+    // the vector queries copy its result.
     Quest* GetQuest(const std::string& id);
-    std::vector<Quest*> GetAvailableQuests() const;
-    std::vector<Quest*> GetActiveQuests() const;
-    std::vector<Quest*> GetCompletedQuests() const;
-    std::vector<Quest*> GetFailedQuests() const;
+    Quest* GetQuest(QuestHandle quest);
+    QuestRange GetQuestsInState(QuestState state) const;
+    std::vector<const Quest*> GetAvailableQuests() const;
+    std::vector<const Quest*> GetActiveQuests() const;
+    std::vector<const Quest*> GetCompletedQuests() const;
+    std::vector<const Quest*> GetFailedQuests() const;
     
     // Serialization override
     void Serialize(BinaryWriter& writer) const override;
     void Deserialize(BinaryReader& reader) override;
     void SerializeToText(TextWriter& writer) const;
     void DeserializeFromText(TextReader& reader);
+    void SerializeToJson(JsonWriter& writer) const override;
+    void BeginJsonLoad() override;
+    void DeserializeJsonField(const std::string& field, const nlohmann::json& value) override;
+    void EndJsonLoad() override;
+    
+    // Binary layout version; 2 added the quests' availability windows and deadlines
+    uint32_t GetSchemaVersion() const override { return 2; }
+    
+    // Incremental saves only write quests changed since the last ClearDirty()
+    bool IsDirty() const override { return m_table.IsDirty(); }
+    void ClearDirty() override { m_table.ClearDirty(); }
+    void SerializeDelta(BinaryWriter& writer) const override;
+    void DeserializeDelta(BinaryReader& reader) override;
+    std::function<void()> DecodeDeferred(BinaryReader& reader) override;
+    std::function<void(BinaryWriter&)> SnapshotState() const override;
+    
+    // Call after modifying a quest through a pointer returned by the query methods
+    void MarkQuestDirty(const std::string& id);
+    
+    // Serialized fields, in save order
+    static constexpr auto Fields() {
+        return std::make_tuple(MakeField("quests", &QuestSystem::m_quests));
+    }
 
     // Meyer's Singleton - thread-safe in C++11 and beyond
     static QuestSystem* GetInstance() {
@@ -105,7 +260,39 @@ private:
     // Private constructor
     QuestSystem();
 
-    // Quest storage
-    std::unordered_map<std::string, std::unique_ptr<Quest>> m_quests;
+    // Quest storage, copy-on-write so saves can snapshot it without stopping the game
+    SnapshotMap<Quest> m_quests;
+    
+    // Handles, states and dirty quests, by m_quests' storage index. Mutable because
+    // queries first catch up with quests whose state was changed through GetQuest.
+    void RebuildTable();
+    void SyncTable() const;
+    void ForgetEditedQuests() const;
+    mutable QuestTable m_table;
+    
+    // Skill requirements by storage index. Rebuilt on first use after a load of this
+    // system or of CharacterProgressionSystem, and updated one skill at a time in between.
+    void HandleSkillLevelChanged(const SkillLevelChangedEvent& event);
+    void SyncRequirements(const CharacterProgressionSystem& progression, const SkillLevelChangedEvent* change = nullptr) const;
+    mutable QuestRequirementIndex m_requirements;
+    mutable bool m_requirementsStale = true;
+    mutable uint32_t m_requirementsRevision = 0;
+    std::vector<uint32_t> m_unlockedQuests;
+    
+    // Prerequisites, bound to storage indices on first use after a load or after a quest's
+    // state was changed through GetQuest, and kept up to date as quests finish
+    void SyncGraph() const;
+    void PublishUnlockedQuests();
+    mutable QuestGraph m_graph;
+    mutable bool m_graphStale = true;
+    
+    // Game-time limits by storage index. Rebuilt on first use after a load of this system,
+    // and rescheduled as limits are set or edited through GetQuest.
+    int64_t GetGameMinute() const;
+    void SyncTimers(int64_t now) const;
+    void HandleExpiredTimer(const QuestTimers::Expired& expired);
+    mutable QuestTimers m_timers;
+    mutable bool m_timersStale = true;
+    std::vector<QuestTimers::Expired> m_expiredTimers;
 };
 // ^ QuestSystem.h
\ No newline at end of file
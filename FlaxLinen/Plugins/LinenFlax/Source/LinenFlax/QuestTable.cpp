@@ -0,0 +1,156 @@
+// v QuestTable.cpp
+#include "QuestTable.h"
+
+#include <cassert>
+
+namespace {
+
+constexpr uint32_t MaxGeneration = UINT32_MAX >> QuestHandle::SlotBits;
+
+} // namespace
+
+void QuestTable::Clear() {
+    for (auto& group : m_groups) {
+        group.clear();
+    }
+    ClearDirty();
+    ClearWatched();
+    for (uint32_t slot : m_handleSlots) {
+        FreeSlot(slot);
+    }
+    m_states.clear();
+    m_groupSlots.clear();
+    m_handleSlots.clear();
+}
+
+void QuestTable::Reserve(size_t questCount) {
+    // Any group may end up holding every quest
+    for (auto& group : m_groups) {
+        group.reserve(questCount);
+    }
+    m_states.reserve(questCount);
+    m_groupSlots.reserve(questCount);
+    m_handleSlots.reserve(questCount);
+    m_slotIndices.reserve(questCount);
+    m_slotGenerations.reserve(questCount);
+}
+
+QuestHandle QuestTable::Add(QuestState state) {
+    assert(IsValidQuestState(state));
+    uint32_t index = static_cast<uint32_t>(m_states.size());
+    uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else if (m_slotIndices.size() < MaxQuests) {
+        slot = static_cast<uint32_t>(m_slotIndices.size());
+        m_slotIndices.push_back(index);
+        m_slotGenerations.push_back(1);
+    } else {
+        return QuestHandle();
+    }
+    m_slotIndices[slot] = index;
+    
+    auto& group = m_groups[static_cast<size_t>(state)];
+    m_states.push_back(state);
+    m_groupSlots.push_back(static_cast<uint32_t>(group.size()));
+    m_handleSlots.push_back(slot);
+    group.push_back(index);
+    return GetHandle(index);
+}
+
+void QuestTable::Erase(uint32_t index) {
+    ClearWatched();
+    RemoveFromGroup(index);
+    FreeSlot(m_handleSlots[index]);
+    
+    uint32_t last = static_cast<uint32_t>(m_states.size() - 1);
+    m_dirty.Erase(index, last);
+    if (index != last) {
+        m_states[index] = m_states[last];
+        m_groupSlots[index] = m_groupSlots[last];
+        m_handleSlots[index] = m_handleSlots[last];
+        m_groups[static_cast<size_t>(m_states[index])][m_groupSlots[index]] = index;
+        m_slotIndices[m_handleSlots[index]] = index;
+    }
+    m_states.pop_back();
+    m_groupSlots.pop_back();
+    m_handleSlots.pop_back();
+}
+
+QuestHandle QuestTable::GetHandle(uint32_t index) const {
+    uint32_t slot = m_handleSlots[index];
+    QuestHandle handle;
+    handle.value = (m_slotGenerations[slot] << QuestHandle::SlotBits) | slot;
+    return handle;
+}
+
+void QuestTable::SetState(uint32_t index, QuestState state) {
+    assert(IsValidQuestState(state));
+    if (m_states[index] == state) {
+        return;
+    }
+    RemoveFromGroup(index);
+    auto& group = m_groups[static_cast<size_t>(state)];
+    m_states[index] = state;
+    m_groupSlots[index] = static_cast<uint32_t>(group.size());
+    group.push_back(index);
+}
+
+void QuestTable::IndexSet::Insert(uint32_t index) {
+    if (contains.size() <= index) {
+        contains.resize(index + 1, false);
+    }
+    if (!contains[index]) {
+        contains[index] = true;
+        indices.push_back(index);
+    }
+}
+
+void QuestTable::IndexSet::Erase(uint32_t index, uint32_t last) {
+    // Drop 'index', then let the entry for 'last' follow the quest that moves there
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (indices[i] == index) {
+            indices[i] = indices.back();
+            indices.pop_back();
+            break;
+        }
+    }
+    bool lastContained = last < contains.size() && contains[last];
+    if (index < contains.size()) {
+        contains[index] = false;
+    }
+    if (lastContained && index != last) {
+        for (uint32_t& entry : indices) {
+            if (entry == last) {
+                entry = index;
+            }
+        }
+        contains[last] = false;
+        contains[index] = true;
+    }
+}
+
+void QuestTable::IndexSet::Clear() {
+    for (uint32_t index : indices) {
+        contains[index] = false;
+    }
+    indices.clear();
+}
+
+void QuestTable::RemoveFromGroup(uint32_t index) {
+    auto& group = m_groups[static_cast<size_t>(m_states[index])];
+    uint32_t slot = m_groupSlots[index];
+    uint32_t moved = group.back();
+    group[slot] = moved;
+    m_groupSlots[moved] = slot;
+    group.pop_back();
+}
+
+void QuestTable::FreeSlot(uint32_t slot) {
+    // Generation 0 is skipped so that no handle is all zeros
+    m_slotGenerations[slot] = m_slotGenerations[slot] == MaxGeneration ? 1 : m_slotGenerations[slot] + 1;
+    m_slotIndices[slot] = InvalidIndex;
+    m_freeSlots.push_back(slot);
+}
+// ^ QuestTable.cpp
\ No newline at end of file
@@ -0,0 +1,120 @@
+// v QuestTable.h
+#pragma once
+
+#include "QuestTypes.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Dense per-quest columns kept beside QuestSystem's quest storage, indexed by each quest's
+// storage index in the SnapshotMap, plus the slot table that QuestHandles resolve through.
+//
+// Storage indices are only ever appended while the game runs. They move only when quests
+// are erased (delta replay) or replaced wholesale (loads); this table follows the moves,
+// the other per-index structures of QuestSystem are rebuilt instead.
+//
+// Quests are grouped by state, so QuestSystem can list the quests in one state without
+// walking all of them. Each group is an unordered array of storage indices and each quest
+// remembers its place in its group, so moving a quest to another state or erasing it is
+// O(1) and allocates nothing once the groups have grown to their largest.
+//
+// A handle names a slot, which holds the quest's storage index and survives the index
+// moving on erase. Erasing a quest or clearing the table bumps the slot's generation, so
+// handles to the old quest stop resolving.
+//
+// The table also tracks which quests changed since the last incremental save, and which
+// were edited through a pointer and may have changed state behind the table's back;
+// Watch() those and SyncWatched() picks up their states before the groups are read.
+class QuestTable {
+public:
+    static constexpr size_t StateCount = 4;
+    static_assert(StateCount == static_cast<size_t>(QuestState::Failed) + 1, "One group per quest state");
+    static constexpr uint32_t InvalidIndex = UINT32_MAX;
+    static constexpr uint32_t MaxQuests = QuestHandle::SlotMask + 1;
+    
+    void Clear();
+    void Reserve(size_t questCount);
+    size_t GetSize() const { return m_states.size(); }
+    
+    // Appends a quest at storage index GetSize(). Fails with an invalid handle once
+    // MaxQuests quests are held. States must be valid (see IsValidQuestState); loads
+    // reset the ones that aren't before they reach the table.
+    QuestHandle Add(QuestState state);
+    
+    // Mirrors SnapshotMap::erase: the quest at 'index' goes and the last one takes its
+    // index. Forgets watched quests, so SyncWatched() first. Costs the number of dirty
+    // quests on top, which is fine for delta replay, the only place quests are erased.
+    void Erase(uint32_t index);
+    
+    // Storage index of a quest, or InvalidIndex for a handle that no longer resolves
+    uint32_t Find(QuestHandle handle) const {
+        uint32_t slot = handle.value & QuestHandle::SlotMask;
+        if (slot >= m_slotIndices.size() || m_slotGenerations[slot] != handle.value >> QuestHandle::SlotBits) {
+            return InvalidIndex;
+        }
+        return m_slotIndices[slot];
+    }
+    QuestHandle GetHandle(uint32_t index) const;
+    
+    void SetState(uint32_t index, QuestState state);
+    QuestState GetState(uint32_t index) const { return m_states[index]; }
+    
+    // Storage indices of the quests in 'state', in no particular order
+    const std::vector<uint32_t>& GetGroup(QuestState state) const { return m_groups[static_cast<size_t>(state)]; }
+    
+    // Quests changed since the last incremental save, by storage index
+    void MarkDirty(uint32_t index) { m_dirty.Insert(index); }
+    bool IsDirty() const { return !m_dirty.indices.empty(); }
+    const std::vector<uint32_t>& GetDirty() const { return m_dirty.indices; }
+    void ClearDirty() { m_dirty.Clear(); }
+    
+    void Watch(uint32_t index) { m_watched.Insert(index); }
+    const std::vector<uint32_t>& GetWatched() const { return m_watched.indices; }
+    void ClearWatched() { m_watched.Clear(); }
+    
+    // Re-reads the state of every watched quest; 'stateOf' maps a storage index to the
+    // quest's current state. Quests stay watched. Returns whether any state changed.
+    template<typename StateOf>
+    bool SyncWatched(StateOf&& stateOf) {
+        bool changed = false;
+        for (uint32_t index : m_watched.indices) {
+            QuestState state = stateOf(index);
+            if (state != m_states[index]) {
+                SetState(index, state);
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+private:
+    // Storage indices, each listed once
+    struct IndexSet {
+        std::vector<uint32_t> indices;
+        std::vector<bool> contains;
+        
+        void Insert(uint32_t index);
+        void Erase(uint32_t index, uint32_t last);
+        void Clear();
+    };
+    
+    void RemoveFromGroup(uint32_t index);
+    void FreeSlot(uint32_t slot);
+    
+    // Columns, by storage index
+    std::vector<QuestState> m_states;
+    std::vector<uint32_t> m_groupSlots;     // Position in its state's group
+    std::vector<uint32_t> m_handleSlots;
+    
+    std::vector<uint32_t> m_groups[StateCount];
+    
+    // Handle slots: storage index and generation of each, and the unused ones
+    std::vector<uint32_t> m_slotIndices;
+    std::vector<uint32_t> m_slotGenerations;
+    std::vector<uint32_t> m_freeSlots;
+    
+    IndexSet m_dirty;
+    IndexSet m_watched;
+};
+// ^ QuestTable.h
\ No newline at end of file
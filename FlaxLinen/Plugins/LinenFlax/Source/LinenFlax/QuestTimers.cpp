@@ -0,0 +1,99 @@
+// v QuestTimers.cpp
+#include "QuestTimers.h"
+
+#include <algorithm>
+
+void QuestTimers::Clear() {
+    m_scheduled.clear();
+    m_heap.clear();
+    m_pending = 0;
+    m_sequence = 0;
+}
+
+void QuestTimers::Reserve(size_t questCount) {
+    m_scheduled.reserve(questCount * KindCount);
+}
+
+void QuestTimers::AddQuest(const Times& times, int64_t now) {
+    uint32_t index = static_cast<uint32_t>(GetSize());
+    m_scheduled.resize(m_scheduled.size() + KindCount);
+    UpdateQuest(index, times, now);
+}
+
+void QuestTimers::UpdateQuest(uint32_t index, const Times& times, int64_t now) {
+    uint32_t first = index * KindCount;
+    Schedule(first + static_cast<uint32_t>(Kind::Opens), times.opensAt, now, true);
+    Schedule(first + static_cast<uint32_t>(Kind::Closes), times.closesAt, now, false);
+    Schedule(first + static_cast<uint32_t>(Kind::Deadline), times.deadline, now, false);
+}
+
+void QuestTimers::TakeExpired(int64_t now, std::vector<Expired>& expired) {
+    while (!m_heap.empty() && m_heap.front().minute <= now) {
+        std::pop_heap(m_heap.begin(), m_heap.end(), Later());
+        Entry entry = m_heap.back();
+        m_heap.pop_back();
+        
+        // Left behind by a reschedule
+        Timer& timer = m_scheduled[entry.timer];
+        if (!timer.pending || timer.minute != entry.minute) {
+            continue;
+        }
+        timer.pending = false;
+        m_pending--;
+        expired.push_back({ static_cast<uint32_t>(entry.timer / KindCount), static_cast<Kind>(entry.timer % KindCount), entry.minute });
+    }
+}
+
+void QuestTimers::Schedule(uint32_t timer, int64_t minute, int64_t now, bool isOpening) {
+    Timer& scheduled = m_scheduled[timer];
+    if (scheduled.minute == minute) {
+        return;
+    }
+    if (scheduled.pending) {
+        scheduled.pending = false;
+        m_pending--;
+    }
+    scheduled.minute = minute;
+    if (minute == 0 || (isOpening && minute <= now)) {
+        return;
+    }
+    
+    if (m_sequence == UINT32_MAX) {
+        RebuildHeap();
+    }
+    scheduled.pending = true;
+    m_pending++;
+    m_heap.push_back({ minute, m_sequence++, timer });
+    std::push_heap(m_heap.begin(), m_heap.end(), Later());
+    if (m_heap.size() - m_pending > m_pending) {
+        RebuildHeap();
+    }
+}
+
+void QuestTimers::RebuildHeap() {
+    // Keeps the live entries, renumbered in the order they would be taken
+    std::vector<Entry> live;
+    live.reserve(m_pending);
+    for (const Entry& entry : m_heap) {
+        const Timer& timer = m_scheduled[entry.timer];
+        if (timer.pending && timer.minute == entry.minute) {
+            live.push_back(entry);
+        }
+    }
+    
+    // A timer rescheduled away and back has two entries that look live; the first stays
+    std::sort(live.begin(), live.end(), [](const Entry& a, const Entry& b) {
+        return a.timer != b.timer ? a.timer < b.timer : a.sequence < b.sequence;
+    });
+    live.erase(std::unique(live.begin(), live.end(), [](const Entry& a, const Entry& b) {
+        return a.timer == b.timer;
+    }), live.end());
+    std::sort(live.begin(), live.end(), [](const Entry& a, const Entry& b) { return Later()(b, a); });
+    for (size_t i = 0; i < live.size(); ++i) {
+        live[i].sequence = static_cast<uint32_t>(i);
+    }
+    m_sequence = static_cast<uint32_t>(live.size());
+    std::make_heap(live.begin(), live.end(), Later());
+    m_heap = std::move(live);
+}
+// ^ QuestTimers.cpp
\ No newline at end of file
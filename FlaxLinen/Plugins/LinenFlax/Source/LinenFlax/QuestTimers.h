@@ -0,0 +1,80 @@
+// v QuestTimers.h
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Game-time events of every quest (availability window opening and closing, deadline),
+// in a min-heap on absolute game minutes (TimeSystem::GetTotalMinutes), so that taking
+// what is due costs only the expired entries however far the clock jumped.
+//
+// Quests are known by storage index (see QuestTable); the timers are rebuilt when those
+// move. Rescheduling leaves the old entry in the heap to be skipped when it comes up; the
+// heap is rebuilt once those outnumber the live ones. A time of 0 means none.
+class QuestTimers {
+public:
+    enum class Kind : uint8_t {
+        Opens,      // Availability window starts
+        Closes,     // Availability window ends
+        Deadline    // Active quest must be finished by then
+    };
+    static constexpr size_t KindCount = 3;
+    
+    struct Times {
+        int64_t opensAt = 0;
+        int64_t closesAt = 0;
+        int64_t deadline = 0;
+    };
+    
+    struct Expired {
+        uint32_t index;
+        Kind kind;
+        int64_t minute;
+    };
+    
+    void Clear();
+    void Reserve(size_t questCount);
+    size_t GetSize() const { return m_scheduled.size() / KindCount; }
+    
+    // Appends a quest at storage index GetSize(). A window that opened by 'now' is not
+    // announced again; closings and deadlines in the past come due on the next take.
+    void AddQuest(const Times& times, int64_t now);
+    
+    // Reschedules whatever changed; times already taken and unchanged stay taken
+    void UpdateQuest(uint32_t index, const Times& times, int64_t now);
+    
+    // Appends every entry due by 'now' to 'expired', earliest first; entries due the same
+    // minute come in the order they were scheduled
+    void TakeExpired(int64_t now, std::vector<Expired>& expired);
+    
+    size_t GetPendingCount() const { return m_pending; }
+
+private:
+    struct Entry {
+        int64_t minute;
+        uint32_t sequence;
+        uint32_t timer;     // Storage index * KindCount + kind
+    };
+    
+    // Earliest entry on top of the std:: heap functions' max-heap
+    struct Later {
+        bool operator()(const Entry& a, const Entry& b) const {
+            return a.minute != b.minute ? a.minute > b.minute : a.sequence > b.sequence;
+        }
+    };
+    
+    struct Timer {
+        int64_t minute = 0;
+        bool pending = false;
+    };
+    
+    void Schedule(uint32_t timer, int64_t minute, int64_t now, bool isOpening);
+    void RebuildHeap();
+    
+    std::vector<Timer> m_scheduled;     // By timer
+    std::vector<Entry> m_heap;
+    size_t m_pending = 0;
+    uint32_t m_sequence = 0;
+};
+// ^ QuestTimers.h
\ No newline at end of file
@@ -1,6 +1,8 @@
 // v QuestTypes.h
 #pragma once
 
+#include <cstdint>
+
 // Forward declarations and common types for Quest-related classes
 class Quest;
 
@@ -12,12 +14,45 @@ enum class QuestState {
     Failed
 };
 
+// Saves hold the state as a plain number, which may name no state at all
+constexpr bool IsValidQuestState(QuestState state) {
+    return static_cast<uint32_t>(state) <= static_cast<uint32_t>(QuestState::Failed);
+}
+
+// Generation-checked reference to a quest held by QuestSystem; see QuestTable. The low
+// bits pick a slot, the high bits must match that slot's generation. The default handle
+// never resolves.
+struct QuestHandle {
+    static constexpr uint32_t SlotBits = 24;
+    static constexpr uint32_t SlotMask = (1u << SlotBits) - 1;
+    
+    uint32_t value = 0;
+    
+    explicit operator bool() const { return value != 0; }
+    bool operator==(QuestHandle other) const { return value == other.value; }
+    bool operator!=(QuestHandle other) const { return value != other.value; }
+};
+
+// What a prerequisite quest must end in; see QuestGraph
+enum class QuestPrerequisite {
+    Completed,
+    Failed
+};
+
+// Whether a quest needs all of its prerequisites or any one of them
+enum class PrerequisiteMode {
+    AllOf,
+    AnyOf
+};
+
 enum class QuestResult {
     Success,            
     NotFound,           // Quest ID not found
     AlreadyExists,      // When trying to add a quest that already exists
     InvalidState,       // Quest is in wrong state for the operation
     RequirementsNotMet, // Player doesn't meet skill requirements
+    PrerequisitesNotMet, // Prerequisite quests not completed/failed yet
+    OutsideTimeWindow,  // Quest's availability window isn't open, or its deadline passed
     Error               // Generic error
 };
 // ^ QuestTypes.h
\ No newline at end of file
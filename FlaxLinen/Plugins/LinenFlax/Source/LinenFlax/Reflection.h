@@ -0,0 +1,648 @@
+// v Reflection.h
+#pragma once
+
+#include "Serialization.h"
+#include "JsonSerialization.h"
+#include "SnapshotMap.h"
+#include <tuple>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <type_traits>
+#include <utility>
+#include <cstring>
+#include <cstdint>
+
+// Field groups let a serializer work on a subset of fields, e.g. one delta block
+constexpr uint32_t AllFieldGroups = ~0u;
+
+// Compile-time description of one serialized member
+template<typename Owner, typename T, uint32_t Groups>
+struct FieldInfo {
+    using OwnerType = Owner;
+    using ValueType = T;
+    static constexpr uint32_t groups = Groups;
+    
+    std::string_view name;
+    T Owner::* member;
+};
+
+template<uint32_t Groups = AllFieldGroups, typename Owner, typename T>
+constexpr FieldInfo<Owner, T, Groups> MakeField(std::string_view name, T Owner::* member) {
+    return { name, member };
+}
+
+// Generates binary, text and JSON serialization from a type's field list.
+//
+// A reflected type declares its fields once, in save order:
+//
+//     static constexpr auto Fields() {
+//         return std::make_tuple(MakeField("id", &Skill::m_id), MakeField("level", &Skill::m_level));
+//     }
+//
+// Supported members are arithmetic and enum values, std::string, reflected types,
+// std::vector of any of those, and string-keyed unordered_maps of values or of
+// unique_ptrs to reflected types. A SnapshotMap can stand in for such a map, holding
+// reflected types by value, and is written the same way. Keyed collections of reflected
+// types are written as arrays in text and JSON; the element's first field, which must be
+// a string, is its key.
+//
+// Binary output is laid out exactly like the hand-written serializers it replaces.
+// Consecutive arithmetic and enum fields are packed into one block and written or read
+// with a single call.
+//
+// A type may also declare 'bool CheckFields()', called after each read of it to catch
+// values no format can rule out, like an enum out of range. It returns false after
+// resetting them; a binary read then fails, text and JSON keep the reset value.
+struct FieldSerializer {
+    // Binary
+    
+    template<uint32_t Mask = AllFieldGroups, typename T>
+    static void WriteBinary(BinaryWriter& writer, const T& object) {
+        constexpr auto fields = T::Fields();
+        WriteBinaryFrom<Mask, 0>(writer, object, fields);
+    }
+    
+    template<uint32_t Mask = AllFieldGroups, typename T>
+    static void ReadBinary(BinaryReader& reader, T& object) {
+        constexpr auto fields = T::Fields();
+        ReadBinaryFrom<Mask, 0>(reader, object, fields);
+        if (!CheckRead(object)) {
+            reader.Fail();
+        }
+    }
+    
+    // One value per field of T, held apart from any object. A load can decode into these
+    // on a worker thread while the live object is still in use, then move them in.
+    template<typename... F>
+    static std::tuple<typename F::ValueType...> ValuesOf(const std::tuple<F...>&);
+    template<typename T>
+    using FieldValues = decltype(ValuesOf(T::Fields()));
+    
+    // Same layout as ReadBinary
+    template<typename T>
+    static void ReadBinaryValues(BinaryReader& reader, FieldValues<T>& values) {
+        std::apply([&](auto&... value) { (ReadBinaryValue(reader, value), ...); }, values);
+    }
+    
+    template<typename T>
+    static void AssignValues(T& object, FieldValues<T>& values) {
+        constexpr auto fields = T::Fields();
+        AssignValuesFrom<0>(object, values, fields);
+    }
+    
+    // Frozen copy of every field, for a save that serializes on another thread while the
+    // object keeps changing. SnapshotMaps are captured in O(1); other fields are copied,
+    // so they should be small. WriteBinaryValues writes them in WriteBinary's layout.
+    template<typename T>
+    static auto SnapshotValues(const T& object) {
+        return std::apply([&](const auto&... field) {
+            return std::make_tuple(SnapshotValue(object.*(field.member))...);
+        }, T::Fields());
+    }
+    
+    template<typename Values>
+    static void WriteBinaryValues(BinaryWriter& writer, const Values& values) {
+        std::apply([&](const auto&... value) { (WriteBinaryValue(writer, value), ...); }, values);
+    }
+    
+    template<typename V>
+    static void WriteBinaryValue(BinaryWriter& writer, const V& value) {
+        if constexpr (IsBlittable<V>) {
+            writer.WriteValue(value);
+        } else if constexpr (std::is_same_v<V, std::string>) {
+            writer.Write(value);
+        } else if constexpr (IsReflected<V>::value) {
+            WriteBinary(writer, value);
+        } else if constexpr (IsUniquePtr<V>::value) {
+            WriteBinary(writer, *value);
+        } else if constexpr (IsVector<V>::value) {
+            using E = typename V::value_type;
+            if constexpr (HasStreamOperators<E>) {
+                writer.WriteVector(value);
+            } else {
+                writer.Write(static_cast<uint32_t>(value.size()));
+                for (const auto& element : value) {
+                    WriteBinaryValue(writer, element);
+                }
+            }
+        } else if constexpr (IsStringMap<V>::value) {
+            using E = typename V::mapped_type;
+            if constexpr (HasStreamOperators<E>) {
+                writer.WriteMap(value);
+            } else {
+                writer.Write(static_cast<uint32_t>(value.size()));
+                for (const auto& pair : value) {
+                    writer.Write(pair.first);
+                    WriteBinaryValue(writer, pair.second);
+                }
+            }
+        } else {
+            static_assert(AlwaysFalse<V>::value, "Unsupported field type");
+        }
+    }
+    
+    template<typename V>
+    static void ReadBinaryValue(BinaryReader& reader, V& value) {
+        if constexpr (IsBlittable<V>) {
+            reader.ReadValue(value);
+        } else if constexpr (std::is_same_v<V, std::string>) {
+            reader.Read(value);
+        } else if constexpr (IsReflected<V>::value) {
+            ReadBinary(reader, value);
+        } else if constexpr (IsUniquePtr<V>::value) {
+            value = std::make_unique<typename V::element_type>();
+            ReadBinary(reader, *value);
+        } else if constexpr (IsVector<V>::value) {
+            using E = typename V::value_type;
+            if constexpr (HasStreamOperators<E>) {
+                reader.ReadVector(value);
+            } else {
+                uint32_t count = 0;
+                reader.Read(count);
+                value.clear();
+                if (!reader.CanHold(count, 1)) {
+                    reader.Fail();
+                    return;
+                }
+                for (uint32_t i = 0; i < count && !reader.HasFailed(); ++i) {
+                    E element{};
+                    ReadBinaryValue(reader, element);
+                    value.push_back(std::move(element));
+                }
+            }
+        } else if constexpr (IsStringMap<V>::value) {
+            using E = typename V::mapped_type;
+            if constexpr (HasStreamOperators<E>) {
+                reader.ReadMap(value);
+            } else {
+                uint32_t count = 0;
+                reader.Read(count);
+                value.clear();
+                // Every entry has at least a key length prefix
+                if (!reader.CanHold(count, reader.GetMinStringSize())) {
+                    reader.Fail();
+                    return;
+                }
+                for (uint32_t i = 0; i < count && !reader.HasFailed(); ++i) {
+                    std::string key;
+                    E element{};
+                    reader.Read(key);
+                    ReadBinaryValue(reader, element);
+                    value[key] = std::move(element);
+                }
+            }
+        } else {
+            static_assert(AlwaysFalse<V>::value, "Unsupported field type");
+        }
+    }
+    
+    // Text
+    
+    template<typename T>
+    static void WriteText(TextWriter& writer, const T& object) {
+        ForEachField(T::Fields(), [&](const auto& field) {
+            WriteTextValue(writer, field.name, object.*(field.member));
+        });
+    }
+    
+    template<typename T>
+    static void ReadText(TextReader& reader, T& object) {
+        ForEachField(T::Fields(), [&](const auto& field) {
+            ReadTextValue(reader, field.name, object.*(field.member));
+        });
+        CheckRead(object);
+    }
+    
+    // JSON
+    
+    // Writes the fields as members of an object the caller has opened
+    template<typename T>
+    static void WriteJson(JsonWriter& writer, const T& object) {
+        ForEachField(T::Fields(), [&](const auto& field) {
+            WriteJsonValue(writer, field.name, object.*(field.member));
+        });
+    }
+    
+    // Streaming counterpart for LinenSystem::DeserializeJsonField: applies one top-level
+    // member, or one element of a top-level array. Returns false for unknown fields.
+    template<typename T, typename Json>
+    static bool ReadJsonField(T& object, const std::string& field, const Json& value) {
+        bool found = false;
+        ForEachField(T::Fields(), [&](const auto& info) {
+            if (!found && info.name == field) {
+                ReadJsonValue(object.*(info.member), value, true);
+                found = true;
+            }
+        });
+        return found;
+    }
+    
+    // Reads a whole JSON object, e.g. one quest record
+    template<typename T, typename Json>
+    static void ReadJsonObject(T& object, const Json& json) {
+        ForEachField(T::Fields(), [&](const auto& field) {
+            auto it = json.find(field.name);
+            if (it != json.end()) {
+                ReadJsonValue(object.*(field.member), *it, false);
+            }
+        });
+        CheckRead(object);
+    }
+    
+    // Empties every container field, before a streamed load adds elements to them
+    template<typename T>
+    static void ClearContainers(T& object) {
+        ForEachField(T::Fields(), [&](const auto& field) {
+            using V = typename std::decay_t<decltype(field)>::ValueType;
+            if constexpr (IsVector<V>::value || IsStringMap<V>::value) {
+                (object.*(field.member)).clear();
+            }
+        });
+    }
+
+private:
+    template<typename T>
+    struct AlwaysFalse : std::false_type {};
+    
+    template<typename T, typename = void>
+    struct IsReflected : std::false_type {};
+    template<typename T>
+    struct IsReflected<T, std::void_t<decltype(T::Fields())>> : std::true_type {};
+    
+    template<typename T>
+    struct IsVector : std::false_type {};
+    template<typename T, typename A>
+    struct IsVector<std::vector<T, A>> : std::true_type {};
+    
+    template<typename T>
+    struct IsStringMap : std::false_type {};
+    template<typename V, typename H, typename E, typename A>
+    struct IsStringMap<std::unordered_map<std::string, V, H, E, A>> : std::true_type {};
+    template<typename V, size_t P>
+    struct IsStringMap<SnapshotMap<V, P>> : std::true_type {};
+    template<typename V, size_t P>
+    struct IsStringMap<SnapshotMapView<V, P>> : std::true_type {};
+    
+    template<typename T>
+    struct IsSnapshotMap : std::false_type {};
+    template<typename V, size_t P>
+    struct IsSnapshotMap<SnapshotMap<V, P>> : std::true_type {};
+    
+    template<typename T, typename = void>
+    struct HasCheckFields : std::false_type {};
+    template<typename T>
+    struct HasCheckFields<T, std::void_t<decltype(std::declval<T&>().CheckFields())>> : std::true_type {};
+    
+    template<typename T>
+    static bool CheckRead(T& object) {
+        if constexpr (HasCheckFields<T>::value) {
+            return object.CheckFields();
+        } else {
+            return true;
+        }
+    }
+    
+    template<typename T>
+    struct IsUniquePtr : std::false_type {};
+    template<typename T, typename D>
+    struct IsUniquePtr<std::unique_ptr<T, D>> : std::true_type {};
+    
+    template<typename T>
+    static constexpr bool IsBlittable = IsTriviallySerializable<T>;
+    
+    // Element types the BinaryWriter/BinaryReader container helpers handle directly
+    template<typename T>
+    static constexpr bool HasStreamOperators = IsTriviallySerializable<T> || std::is_same_v<T, std::string>;
+    
+    // Values written as a single text line or JSON scalar
+    template<typename T>
+    static constexpr bool IsScalar = IsBlittable<T> || std::is_same_v<T, std::string>;
+    
+    template<typename Tuple, typename Func>
+    static void ForEachField(const Tuple& fields, Func&& func) {
+        std::apply([&](const auto&... field) { (func(field), ...); }, fields);
+    }
+    
+    template<typename Tuple, size_t I>
+    using FieldAt = std::tuple_element_t<I, std::remove_const_t<Tuple>>;
+    
+    template<uint32_t Mask, typename F>
+    static constexpr bool InMask = (F::groups & Mask) != 0;
+    
+    // One past the end of the run of blittable fields starting at I. Fields outside the
+    // mask don't break a run, they are simply left out of the block.
+    template<uint32_t Mask, typename Tuple, size_t I>
+    static constexpr size_t RunEnd() {
+        if constexpr (I == std::tuple_size_v<std::remove_const_t<Tuple>>) {
+            return I;
+        } else {
+            using F = FieldAt<Tuple, I>;
+            if constexpr (!InMask<Mask, F> || IsBlittable<typename F::ValueType>) {
+                return RunEnd<Mask, Tuple, I + 1>();
+            } else {
+                return I;
+            }
+        }
+    }
+    
+    template<uint32_t Mask, typename Tuple, size_t I, size_t End>
+    static constexpr size_t RunBytes() {
+        if constexpr (I == End) {
+            return 0;
+        } else {
+            using F = FieldAt<Tuple, I>;
+            return (InMask<Mask, F> ? sizeof(typename F::ValueType) : 0) + RunBytes<Mask, Tuple, I + 1, End>();
+        }
+    }
+    
+    template<uint32_t Mask, size_t I, typename T, typename Tuple>
+    static void WriteBinaryFrom(BinaryWriter& writer, const T& object, const Tuple& fields) {
+        if constexpr (I < std::tuple_size_v<std::remove_const_t<Tuple>>) {
+            using F = FieldAt<Tuple, I>;
+            if constexpr (!InMask<Mask, F>) {
+                WriteBinaryFrom<Mask, I + 1>(writer, object, fields);
+            } else if constexpr (IsBlittable<typename F::ValueType>) {
+                constexpr size_t end = RunEnd<Mask, Tuple, I>();
+                uint8_t block[RunBytes<Mask, Tuple, I, end>()];
+                PackRun<Mask, I, end>(block, object, fields);
+                writer.Write(block, sizeof(block));
+                WriteBinaryFrom<Mask, end>(writer, object, fields);
+            } else {
+                WriteBinaryValue(writer, object.*(std::get<I>(fields).member));
+                WriteBinaryFrom<Mask, I + 1>(writer, object, fields);
+            }
+        }
+    }
+    
+    template<uint32_t Mask, size_t I, typename T, typename Tuple>
+    static void ReadBinaryFrom(BinaryReader& reader, T& object, const Tuple& fields) {
+        if constexpr (I < std::tuple_size_v<std::remove_const_t<Tuple>>) {
+            using F = FieldAt<Tuple, I>;
+            if constexpr (!InMask<Mask, F>) {
+                ReadBinaryFrom<Mask, I + 1>(reader, object, fields);
+            } else if constexpr (IsBlittable<typename F::ValueType>) {
+                constexpr size_t end = RunEnd<Mask, Tuple, I>();
+                uint8_t block[RunBytes<Mask, Tuple, I, end>()];
+                reader.Read(block, sizeof(block));
+                UnpackRun<Mask, I, end>(block, object, fields);
+                ReadBinaryFrom<Mask, end>(reader, object, fields);
+            } else {
+                ReadBinaryValue(reader, object.*(std::get<I>(fields).member));
+                ReadBinaryFrom<Mask, I + 1>(reader, object, fields);
+            }
+        }
+    }
+    
+    template<size_t I, typename T, typename Values, typename Tuple>
+    static void AssignValuesFrom(T& object, Values& values, const Tuple& fields) {
+        if constexpr (I < std::tuple_size_v<Values>) {
+            object.*(std::get<I>(fields).member) = std::move(std::get<I>(values));
+            AssignValuesFrom<I + 1>(object, values, fields);
+        }
+    }
+    
+    template<uint32_t Mask, size_t I, size_t End, typename T, typename Tuple>
+    static void PackRun(uint8_t* out, const T& object, const Tuple& fields) {
+        if constexpr (I < End) {
+            using F = FieldAt<Tuple, I>;
+            if constexpr (InMask<Mask, F>) {
+                auto value = LittleEndian(object.*(std::get<I>(fields).member));
+                std::memcpy(out, &value, sizeof(value));
+                out += sizeof(value);
+            }
+            PackRun<Mask, I + 1, End>(out, object, fields);
+        }
+    }
+    
+    template<uint32_t Mask, size_t I, size_t End, typename T, typename Tuple>
+    static void UnpackRun(const uint8_t* in, T& object, const Tuple& fields) {
+        if constexpr (I < End) {
+            using F = FieldAt<Tuple, I>;
+            if constexpr (InMask<Mask, F>) {
+                typename F::ValueType value;
+                std::memcpy(&value, in, sizeof(value));
+                object.*(std::get<I>(fields).member) = LittleEndian(value);
+                in += sizeof(value);
+            }
+            UnpackRun<Mask, I + 1, End>(in, object, fields);
+        }
+    }
+    
+    template<typename V>
+    static auto SnapshotValue(const V& value) {
+        if constexpr (IsSnapshotMap<V>::value) {
+            return value.Snapshot();
+        } else {
+            return value;
+        }
+    }
+    
+    // Keyed collections hold reflected elements either by value or through unique_ptr
+    template<typename E>
+    static auto& ElementOf(E& element) {
+        if constexpr (IsUniquePtr<std::remove_const_t<E>>::value) {
+            return *element;
+        } else {
+            return element;
+        }
+    }
+    
+    template<typename E>
+    static E NewElement() {
+        if constexpr (IsUniquePtr<E>::value) {
+            return std::make_unique<typename E::element_type>();
+        } else {
+            return E{};
+        }
+    }
+    
+    // The key of an element in a keyed collection is its first field
+    template<typename E>
+    static const std::string& KeyOf(const E& element) {
+        constexpr auto fields = E::Fields();
+        using F = FieldAt<decltype(fields), 0>;
+        static_assert(std::is_same_v<typename F::ValueType, std::string>, "First field of a keyed element must be its string key");
+        return element.*(std::get<0>(fields).member);
+    }
+    
+    template<typename V>
+    static void WriteTextValue(TextWriter& writer, std::string_view name, const V& value) {
+        if constexpr (IsScalar<V>) {
+            writer.Write(name, value);
+        } else if constexpr (IsVector<V>::value && IsBlittable<typename V::value_type>) {
+            writer.WriteVector(name, value);
+        } else if constexpr (IsVector<V>::value && IsScalar<typename V::value_type>) {
+            // Strings may contain the list separator, one line each
+            writer.Write(name, value.size());
+            for (size_t i = 0; i < value.size(); ++i) {
+                writer.WriteIndexed(name, i, value[i]);
+            }
+        } else if constexpr (IsStringMap<V>::value && IsScalar<typename V::mapped_type>) {
+            writer.Write(name, value.size());
+            size_t index = 0;
+            for (const auto* pair : SortedByKey(value)) {
+                writer.BeginScope(name, index++);
+                writer.Write("key", pair->first);
+                writer.Write("value", pair->second);
+                writer.EndScope();
+            }
+        } else if constexpr (IsStringMap<V>::value) {
+            // "<name>=count", then each element's fields under "<name><index>_"
+            writer.Write(name, value.size());
+            size_t index = 0;
+            for (const auto* pair : SortedByKey(value)) {
+                writer.BeginScope(name, index++);
+                WriteText(writer, ElementOf(pair->second));
+                writer.EndScope();
+            }
+        } else {
+            static_assert(AlwaysFalse<V>::value, "Unsupported text field type");
+        }
+    }
+    
+    template<typename V>
+    static void ReadTextValue(TextReader& reader, std::string_view name, V& value) {
+        if constexpr (IsScalar<V>) {
+            reader.Read(name, value);
+        } else if constexpr (IsVector<V>::value && IsBlittable<typename V::value_type>) {
+            reader.ReadVector(name, value);
+        } else if constexpr (IsVector<V>::value && IsScalar<typename V::value_type>) {
+            size_t count = ReadTextCount(reader, name);
+            value.clear();
+            for (size_t i = 0; i < count; ++i) {
+                typename V::value_type item{};
+                reader.ReadIndexed(name, i, item);
+                value.push_back(std::move(item));
+            }
+        } else if constexpr (IsStringMap<V>::value && IsScalar<typename V::mapped_type>) {
+            size_t count = ReadTextCount(reader, name);
+            value.clear();
+            for (size_t i = 0; i < count; ++i) {
+                std::string key;
+                typename V::mapped_type item{};
+                reader.BeginScope(name, i);
+                reader.Read("key", key);
+                reader.Read("value", item);
+                reader.EndScope();
+                value[key] = std::move(item);
+            }
+        } else if constexpr (IsStringMap<V>::value) {
+            size_t count = ReadTextCount(reader, name);
+            value.clear();
+            for (size_t i = 0; i < count; ++i) {
+                auto element = NewElement<typename V::mapped_type>();
+                reader.BeginScope(name, i);
+                ReadText(reader, ElementOf(element));
+                reader.EndScope();
+                std::string key = KeyOf(ElementOf(element));
+                value[key] = std::move(element);
+            }
+        } else {
+            static_assert(AlwaysFalse<V>::value, "Unsupported text field type");
+        }
+    }
+    
+    // Element count written under a collection's name. Each element takes at least one
+    // key, so a count larger than the number of keys is corrupt and gets clamped.
+    static size_t ReadTextCount(TextReader& reader, std::string_view name) {
+        size_t count = 0;
+        if (!reader.Read(name, count)) {
+            return 0;
+        }
+        return count < reader.GetKeyCount() ? count : reader.GetKeyCount();
+    }
+    
+    template<typename V>
+    static void WriteJsonValue(JsonWriter& writer, std::string_view name, const V& value) {
+        if constexpr (IsScalar<V>) {
+            writer.Write(name, value);
+        } else if constexpr (IsReflected<V>::value) {
+            writer.BeginObject(name);
+            WriteJson(writer, value);
+            writer.EndObject();
+        } else if constexpr (IsVector<V>::value) {
+            writer.BeginArray(name);
+            for (const auto& element : value) {
+                if constexpr (IsReflected<typename V::value_type>::value) {
+                    writer.BeginObject();
+                    WriteJson(writer, element);
+                    writer.EndObject();
+                } else {
+                    writer.WriteValue(element);
+                }
+            }
+            writer.EndArray();
+        } else if constexpr (IsStringMap<V>::value && IsScalar<typename V::mapped_type>) {
+            writer.WriteMap(name, value);
+        } else if constexpr (IsStringMap<V>::value) {
+            // Keyed elements become an array so a streamed load sees one at a time
+            writer.BeginArray(name);
+            for (const auto* pair : SortedByKey(value)) {
+                writer.BeginObject();
+                WriteJson(writer, ElementOf(pair->second));
+                writer.EndObject();
+            }
+            writer.EndArray();
+        } else {
+            static_assert(AlwaysFalse<V>::value, "Unsupported JSON field type");
+        }
+    }
+    
+    // 'element' is set when a streamed load hands over one element of an array field
+    template<typename V, typename Json>
+    static void ReadJsonValue(V& value, const Json& json, bool element) {
+        if constexpr (std::is_enum_v<V>) {
+            value = static_cast<V>(json.template get<std::underlying_type_t<V>>());
+        } else if constexpr (IsScalar<V>) {
+            value = json.template get<V>();
+        } else if constexpr (IsReflected<V>::value) {
+            ReadJsonObject(value, json);
+        } else if constexpr (IsVector<V>::value) {
+            if (element) {
+                value.push_back(ReadJsonElement<typename V::value_type>(json));
+                return;
+            }
+            value.clear();
+            for (const auto& item : json) {
+                value.push_back(ReadJsonElement<typename V::value_type>(item));
+            }
+        } else if constexpr (IsStringMap<V>::value && IsScalar<typename V::mapped_type>) {
+            value.clear();
+            for (auto it = json.begin(); it != json.end(); ++it) {
+                typename V::mapped_type item{};
+                ReadJsonValue(item, it.value(), false);
+                value[it.key()] = std::move(item);
+            }
+        } else if constexpr (IsStringMap<V>::value) {
+            if (element) {
+                AddJsonKeyedElement(value, json);
+                return;
+            }
+            value.clear();
+            for (const auto& item : json) {
+                AddJsonKeyedElement(value, item);
+            }
+        } else {
+            static_assert(AlwaysFalse<V>::value, "Unsupported JSON field type");
+        }
+    }
+    
+    template<typename E, typename Json>
+    static E ReadJsonElement(const Json& json) {
+        E element{};
+        ReadJsonValue(element, json, false);
+        return element;
+    }
+    
+    template<typename V, typename Json>
+    static void AddJsonKeyedElement(V& map, const Json& json) {
+        auto element = NewElement<typename V::mapped_type>();
+        ReadJsonObject(ElementOf(element), json);
+        std::string key = KeyOf(ElementOf(element));
+        map[key] = std::move(element);
+    }
+};
+// ^ Reflection.h
\ No newline at end of file
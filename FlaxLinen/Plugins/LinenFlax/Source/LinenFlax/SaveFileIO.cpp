@@ -0,0 +1,164 @@
+// v SaveFileIO.cpp
+#include "SaveFileIO.h"
+#include "Engine/Core/Log.h"
+#include <filesystem>
+#include <system_error>
+
+#if defined(_WIN32)
+    #include <io.h>
+#else
+    #include <unistd.h>
+    #include <fcntl.h>
+#endif
+
+namespace fs = std::filesystem;
+
+bool SyncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#if defined(_WIN32)
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool SeekFile(std::FILE* file, int64_t offset, int origin) {
+#if defined(_WIN32)
+    return _fseeki64(file, offset, origin) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+#endif
+}
+
+int64_t TellFile(std::FILE* file) {
+#if defined(_WIN32)
+    return _ftelli64(file);
+#else
+    return static_cast<int64_t>(ftello(file));
+#endif
+}
+
+void SyncDirectory(const std::string& directory) {
+#if !defined(_WIN32)
+    int fd = open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+#endif
+}
+
+bool WriteFileAtomic(const std::string& filename, const void* data, size_t size) {
+    std::string tempFilename = filename + ".tmp";
+    
+    std::FILE* file = std::fopen(tempFilename.c_str(), "wb");
+    if (!file) {
+        LOG(Error, "Failed to create temporary save file: {0}", String(tempFilename.c_str()));
+        return false;
+    }
+    
+    bool written = size == 0 || std::fwrite(data, 1, size, file) == size;
+    bool synced = written && SyncFile(file);
+    bool closed = std::fclose(file) == 0;
+    
+    std::error_code error;
+    if (!written || !synced || !closed) {
+        LOG(Error, "Failed to write temporary save file: {0}", String(tempFilename.c_str()));
+        fs::remove(tempFilename, error);
+        return false;
+    }
+    
+    // Rename replaces the target in one step; the old save stays intact until here
+    fs::rename(tempFilename, filename, error);
+    if (error) {
+        LOG(Error, "Failed to replace save file {0}: {1}", String(filename.c_str()), String(error.message().c_str()));
+        fs::remove(tempFilename, error);
+        return false;
+    }
+    
+    SyncDirectory(fs::path(filename).parent_path().string());
+    return true;
+}
+
+bool SaveJournal::Open(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_file && m_filename == filename) {
+        return true;
+    }
+    
+    CloseLocked();
+    m_file = std::fopen(filename.c_str(), "ab");
+    if (!m_file) {
+        LOG(Error, "Failed to open save journal: {0}", String(filename.c_str()));
+        return false;
+    }
+    m_filename = filename;
+    m_unsyncedRecords = 0;
+    return true;
+}
+
+void SaveJournal::Close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CloseLocked();
+}
+
+void SaveJournal::CloseLocked() {
+    if (!m_file) {
+        return;
+    }
+    SyncLocked();
+    std::fclose(m_file);
+    m_file = nullptr;
+    m_filename.clear();
+}
+
+bool SaveJournal::Append(const void* data, size_t size) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_file) {
+        return false;
+    }
+    
+    if (std::fwrite(data, 1, size, m_file) != size || std::fflush(m_file) != 0) {
+        LOG(Error, "Failed to append to save journal: {0}", String(m_filename.c_str()));
+        return false;
+    }
+    
+    // Group commit: pay for one fsync per batch rather than per record
+    m_unsyncedRecords++;
+    if (m_unsyncedRecords >= m_syncBatchSize) {
+        return SyncLocked();
+    }
+    return true;
+}
+
+bool SaveJournal::Sync() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return SyncLocked();
+}
+
+bool SaveJournal::SyncLocked() {
+    if (!m_file || m_unsyncedRecords == 0) {
+        return true;
+    }
+    
+    bool synced = SyncFile(m_file);
+    if (synced) {
+        m_unsyncedRecords = 0;
+    } else {
+        LOG(Error, "Failed to sync save journal: {0}", String(m_filename.c_str()));
+    }
+    return synced;
+}
+
+bool SaveJournal::IsOpen(const std::string& filename) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_file && m_filename == filename;
+}
+
+void SaveJournal::SetSyncBatchSize(size_t records) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_syncBatchSize = records > 0 ? records : 1;
+}
+// ^ SaveFileIO.cpp
\ No newline at end of file
@@ -0,0 +1,61 @@
+// v SaveFileIO.h
+#pragma once
+
+#include <string>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+// Writes the data to a temporary file next to 'filename', flushes it to disk and renames
+// it over the target. A crash at any point leaves either the previous file or the new one.
+bool WriteFileAtomic(const std::string& filename, const void* data, size_t size);
+
+// Flushes buffered writes and forces them to disk
+bool SyncFile(std::FILE* file);
+
+// fseek and ftell with 64-bit offsets; the std:: ones take a long, which is 32 bits on
+// Windows and would cut files off at 2 GiB. TellFile returns -1 on failure.
+bool SeekFile(std::FILE* file, int64_t offset, int origin);
+int64_t TellFile(std::FILE* file);
+
+// Flushes a directory entry to disk so a rename or delete inside it survives a crash.
+// No-op on platforms where directories can't be synced.
+void SyncDirectory(const std::string& directory);
+
+// Append-only write-ahead journal for incremental save records.
+// Appends are flushed to the OS immediately, but fsync is batched: it runs once every
+// 'syncBatchSize' records, or when Sync()/Close() is called. Thread safe.
+class SaveJournal {
+public:
+    explicit SaveJournal(size_t syncBatchSize = 8) : m_syncBatchSize(syncBatchSize) {}
+    ~SaveJournal() { Close(); }
+    
+    SaveJournal(const SaveJournal&) = delete;
+    SaveJournal& operator=(const SaveJournal&) = delete;
+    
+    // Opens the journal for appending, closing any other journal first
+    bool Open(const std::string& filename);
+    
+    // Syncs outstanding records and closes the file
+    void Close();
+    
+    bool Append(const void* data, size_t size);
+    
+    // Forces outstanding records to disk
+    bool Sync();
+    
+    bool IsOpen(const std::string& filename) const;
+    void SetSyncBatchSize(size_t records);
+    
+private:
+    bool SyncLocked();
+    void CloseLocked();
+    
+    mutable std::mutex m_mutex;
+    std::FILE* m_file = nullptr;
+    std::string m_filename;
+    size_t m_unsyncedRecords = 0;
+    size_t m_syncBatchSize;
+};
+// ^ SaveFileIO.h
\ No newline at end of file
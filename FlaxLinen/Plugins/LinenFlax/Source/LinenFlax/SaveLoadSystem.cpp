@@ -2,12 +2,148 @@
 #include "SaveLoadSystem.h"
 #include "LinenFlax.h"
 #include "LinenSystemIncludes.h"
+#include "Checksum.h"
+#include "SaveFileIO.h"
 #include "Engine/Core/Log.h"
 #include <filesystem>
 #include <fstream>
+#include <chrono>
+#include <algorithm>
+#include <cctype>
 
 namespace fs = std::filesystem;
 
+namespace {
+
+// Runs task(0) .. task(count - 1), each on its own thread when 'parallel' is set and
+// the CPU has more than one core. The calling thread takes the last task. Exceptions
+// are rethrown here.
+template<typename Task>
+void RunTasks(size_t count, bool parallel, Task&& task) {
+    static const bool multiCore = std::thread::hardware_concurrency() > 1;
+    if (!parallel || !multiCore || count < 2) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+    
+    std::vector<std::future<void>> workers;
+    workers.reserve(count - 1);
+    for (size_t i = 0; i + 1 < count; ++i) {
+        workers.push_back(std::async(std::launch::async, [&task, i] { task(i); }));
+    }
+    task(count - 1);
+    for (auto& worker : workers) {
+        worker.get();
+    }
+}
+
+bool ReadFileBytes(std::FILE* file, void* data, size_t size) {
+    return std::fread(data, 1, size, file) == size;
+}
+
+bool ReadFileValue(std::FILE* file, uint32_t& value) {
+    if (!ReadFileBytes(file, &value, sizeof(value))) {
+        return false;
+    }
+    value = LittleEndian(value);
+    return true;
+}
+
+// Matches keys of the form "<name><index>..."; 'rest' is what follows the name
+bool MatchIndexedKey(std::string_view key, std::string_view name, std::string_view& rest) {
+    if (key.size() <= name.size() || key.compare(0, name.size(), name) != 0 ||
+        !std::isdigit(static_cast<unsigned char>(key[name.size()]))) {
+        return false;
+    }
+    rest = key.substr(name.size());
+    return true;
+}
+
+// "<name><index>_<field>" for a map entry, whose fields are now called key and value
+std::string MapEntryKey(std::string_view name, std::string_view rest, std::string_view keyField, std::string_view valueField) {
+    size_t separator = rest.find('_');
+    std::string_view field = separator == std::string_view::npos ? std::string_view() : rest.substr(separator + 1);
+    std::string key(name);
+    key.append(rest.substr(0, separator == std::string_view::npos ? rest.size() : separator + 1));
+    key.append(field == keyField ? "key" : field == valueField ? "value" : field);
+    return key;
+}
+
+// Text saves before 1.1.0 used hand-picked key names; from 1.1.0 the keys are the
+// reflected field names. Quest details were written without the quest's index, so every
+// quest overwrote the previous one's and only the quest named by "questId" still has
+// them; the other quests come back with just their id.
+void UpgradeTextFrom_1_0_0(const TextReader& reader, TextWriter& writer) {
+    static const std::pair<std::string_view, std::string_view> renamedKeys[] = {
+        { "characterExperience", "experience" },
+        { "characterLevel", "level" },
+        { "skillCount", "skills" },
+        { "skillLevelsCount", "skillLevels" },
+        { "questCount", "quests" },
+        { "seasonCount", "seasons" }
+    };
+    static const std::pair<std::string_view, std::string_view> questDetails[] = {
+        { "questTitle", "title" },
+        { "questDescription", "description" },
+        { "questState", "state" },
+        { "questExperienceReward", "experienceReward" },
+        { "questSkillReqCount", "skillRequirements" }
+    };
+    
+    std::string_view detailsId;
+    std::string detailsPrefix;
+    if (reader.Find("questId", detailsId)) {
+        reader.ForEach([&](std::string_view key, std::string_view value) {
+            std::string_view rest;
+            if (value == detailsId && MatchIndexedKey(key, "quest", rest) && rest.size() > 3 &&
+                rest.substr(rest.size() - 3) == "_id") {
+                detailsPrefix = "quests";
+                detailsPrefix.append(rest.substr(0, rest.size() - 2));
+            }
+        });
+    }
+    
+    reader.ForEach([&](std::string_view key, std::string_view value) {
+        std::string renamed(key);
+        std::string_view rest;
+        if (MatchIndexedKey(key, "skillLevel", rest)) {
+            renamed = MapEntryKey("skillLevels", rest, "id", "level");
+        } else if (MatchIndexedKey(key, "skill", rest)) {
+            renamed = "skills" + std::string(rest);
+        } else if (MatchIndexedKey(key, "quest", rest)) {
+            renamed = "quests" + std::string(rest);
+        } else if (MatchIndexedKey(key, "season", rest)) {
+            renamed = "seasons" + std::string(rest);
+        } else if (MatchIndexedKey(key, "questSkillReq", rest)) {
+            if (detailsPrefix.empty()) {
+                return;
+            }
+            renamed = MapEntryKey(detailsPrefix + "skillRequirements", rest, "skill", "level");
+        } else if (key == "questId") {
+            return;
+        } else {
+            for (const auto& entry : renamedKeys) {
+                if (key == entry.first) {
+                    renamed = entry.second;
+                }
+            }
+            for (const auto& entry : questDetails) {
+                if (key == entry.first) {
+                    if (detailsPrefix.empty()) {
+                        return;
+                    }
+                    renamed = detailsPrefix + std::string(entry.second);
+                }
+            }
+        }
+        writer.Write(renamed, value);
+    });
+}
+
+} // namespace
+
 SaveLoadSystem::~SaveLoadSystem() {
     Destroy();
 }
@@ -19,32 +155,106 @@ void SaveLoadSystem::Initialize() {
     RegisterSerializableSystem("TestSystem");
     RegisterSerializableSystem("TimeSystem");
     
+    RegisterTextUpgrade("1.0.0", "1.1.0", UpgradeTextFrom_1_0_0);
+    
+    // Handlers can't be removed, so a re-initialized system keeps its first ones
+    if (!m_autosaveSubscribed) {
+        EventSystem& events = m_plugin->GetEventSystem();
+        events.Subscribe<DayChangedEvent>([this](const DayChangedEvent&) { m_autosave.OnDayChanged(); });
+        events.Subscribe<HourChangedEvent>([this](const HourChangedEvent&) { m_autosave.OnHourChanged(); });
+        events.Subscribe<QuestCompletedEvent>([this](const QuestCompletedEvent&) { m_autosave.OnQuestCompleted(); });
+        m_autosaveSubscribed = true;
+    }
+    m_autosave.Reset();
+    
     LOG(Info, "Save/Load System Initialized.");
 }
 
 void SaveLoadSystem::Shutdown() {
+    CancelDeferredLoads();
+    
+    // Let queued background saves finish before tearing down
+    StopSaveThread();
+    PublishCompletedSaves();
+    m_journal.Close();
+    m_store.Close();
+    
     m_serializableSystems.clear();
     LOG(Info, "Save/Load System Shutdown.");
 }
 
 void SaveLoadSystem::Update(float deltaTime) {
-    // Nothing to update regularly
+    m_playtime += deltaTime;
+    
+    // Report background saves that finished since the last frame
+    PublishCompletedSaves();
+    ApplyDeferredLoads();
+    
+    uint32_t autosaveReasons = m_autosave.Update(deltaTime, IsSaveInProgress() || IsLoadInProgress());
+    if (autosaveReasons != 0) {
+        StartAutosave(autosaveReasons);
+    }
+}
+
+void SaveLoadSystem::StartAutosave(uint32_t reasons) {
+    const std::string& name = m_autosave.GetSlotName();
+    LOG(Info, "Autosaving to {0} ({1})", String(name.c_str()),
+        String(AutosaveScheduler::DescribeReasons(reasons).c_str()));
+    
+    // Completion is reported through SaveCompletedEvent like any background save
+    if (m_store.IsOpen()) {
+        SaveGameToSlotAsync(name);
+    } else {
+        SaveGameAsync(name, SerializationFormat::Binary);
+    }
+}
+
+void SaveLoadSystem::PublishCompletedSaves() {
+    std::vector<std::pair<std::string, bool>> completed;
+    {
+        std::lock_guard<std::mutex> lock(m_saveMutex);
+        completed.swap(m_completedSaves);
+    }
+    
+    for (const auto& result : completed) {
+        if (!result.second && result.first == m_incrementalFile) {
+            // Restart the delta chain with a full base after a failed write
+            m_incrementalFile.clear();
+        }
+        
+        SaveCompletedEvent event;
+        event.filename = result.first;
+        event.success = result.second;
+        m_plugin->GetEventSystem().Publish(event);
+    }
 }
 
 std::string SaveLoadSystem::GetExtensionForFormat(SerializationFormat format) const {
     switch (format) {
         case SerializationFormat::Binary: return ".bin";
         case SerializationFormat::Text: return ".txt";
+        case SerializationFormat::Json: return ".json";
         default: return ".sav";
     }
 }
 
+const char* SaveLoadSystem::GetFormatName(SerializationFormat format) const {
+    switch (format) {
+        case SerializationFormat::Binary: return "Binary";
+        case SerializationFormat::Text: return "Text";
+        case SerializationFormat::Json: return "Json";
+        default: return "Unknown";
+    }
+}
+
 SerializationFormat SaveLoadSystem::GetFormatFromFilename(const std::string& filename) const {
     fs::path filePath(filename);
     std::string extension = filePath.extension().string();
     
     if (extension == ".txt") {
         return SerializationFormat::Text;
+    } else if (extension == ".json") {
+        return SerializationFormat::Json;
     } else if (extension == ".bin") {
         return SerializationFormat::Binary;
     } else {
@@ -54,11 +264,10 @@ SerializationFormat SaveLoadSystem::GetFormatFromFilename(const std::string& fil
 }
 
 std::string SaveLoadSystem::EnsureCorrectExtension(const std::string& filename, SerializationFormat format) const {
+    // Only the extension is swapped, the directory part of the path is kept
     fs::path filePath(filename);
-    std::string baseFilename = filePath.stem().string();
-    std::string correctExtension = GetExtensionForFormat(format);
-    
-    return baseFilename + correctExtension;
+    filePath.replace_extension(GetExtensionForFormat(format));
+    return filePath.string();
 }
 
 RPGSystem* SaveLoadSystem::GetSystemByName(const std::string& systemName) {
@@ -76,225 +285,1593 @@ RPGSystem* SaveLoadSystem::GetSystemByName(const std::string& systemName) {
 
 bool SaveLoadSystem::SaveGame(const std::string& filename, SerializationFormat format) {    
     std::string saveFilename = EnsureCorrectExtension(filename, format);
-
-    const char* formatName = format == SerializationFormat::Binary ? "Binary" : "Text";
-    LOG(Info, "Saving game to: {0} (Format: {1})", String(saveFilename.c_str()), String(formatName));
+    
+    LOG(Info, "Saving game to: {0} (Format: {1})", String(saveFilename.c_str()), String(GetFormatName(format)));
+    
+    // A standalone save replaces any delta chain on the same file
+    if (saveFilename == m_incrementalFile) {
+        m_incrementalFile.clear();
+    }
     
     try {
-        if (format == SerializationFormat::Binary) {
-            BinaryWriter writer(saveFilename);
-            if (!writer.IsValid()) {
-                LOG(Error, "Failed to create save file: {0}", String(saveFilename.c_str()));
-                return false;
-            }
-            
-            // Write header information
-            writer.Write(static_cast<uint32_t>(m_serializableSystems.size()));
-            
-            // For each registered system, call its Serialize method
-            for (const auto& systemName : m_serializableSystems) {
-                writer.Write(systemName); // Write system name
-                
-                auto system = GetSystemByName(systemName);
-                if (system) {
-                    system->Serialize(writer);
-                    LOG(Info, "Saved system: {0}", String(systemName.c_str()));
-                } else {
-                    LOG(Warning, "System not found for serialization: {0}", String(systemName.c_str()));
-                    // Write empty placeholder
-                    uint32_t size = 0;
-                    writer.Write(size);
-                }
-            }
-        } else { // Text format
-            TextWriter textWriter;
-            
-            // Write version info
-            textWriter.Write("version", std::string("1.0.0"));  // Convert char* to std::string
-            textWriter.Write("systemCount", static_cast<int>(m_serializableSystems.size()));
-            
-            // Write system names
-            int index = 0;
-            for (const auto& systemName : m_serializableSystems) {
-                textWriter.Write("system" + std::to_string(index), systemName);
-                index++;
-            }
-            
-            // For each registered system, call its SerializeToText method
-            for (const auto& systemName : m_serializableSystems) {
-                auto system = GetSystemByName(systemName);
-                if (system) {
-                    if (systemName == "CharacterProgressionSystem") {
-                        static_cast<CharacterProgressionSystem*>(system)->SerializeToText(textWriter);
-                    } else if (systemName == "QuestSystem") {
-                        static_cast<QuestSystem*>(system)->SerializeToText(textWriter);
-                    } else if (systemName == "TestSystem") {
-                        static_cast<TestSystem*>(system)->SerializeToText(textWriter);
-                    } else if (systemName == "TimeSystem") {
-                        static_cast<TimeSystem*>(system)->SerializeToText(textWriter);
-                    }
-                    LOG(Info, "Saved system to text: {0}", String(systemName.c_str()));
-                } else {
-                    LOG(Warning, "System not found for text serialization: {0}", String(systemName.c_str()));
-                }
-            }
-            
-            // Save to file
-            if (!textWriter.SaveToFile(saveFilename)) {
-                LOG(Error, "Failed to write text save file: {0}", String(saveFilename.c_str()));
-                return false;
-            }
-        }
-        
-        LOG(Info, "Game saved successfully: {0}", String(saveFilename.c_str()));
-        return true;
+        auto snapshot = CaptureSnapshot(saveFilename, format);
+        return WriteSnapshot(*snapshot);
     } catch (const std::exception& e) {
         LOG(Error, "Exception during save: {0}", String(e.what()));
         return false;
     }
 }
 
-bool SaveLoadSystem::LoadGame(const std::string& filename, SerializationFormat format) {    
-    std::string loadFilename = EnsureCorrectExtension(filename, format);
+std::shared_future<bool> SaveLoadSystem::SaveGameAsync(const std::string& filename, SerializationFormat format) {
+    std::string saveFilename = EnsureCorrectExtension(filename, format);
     
-    if (!fs::exists(loadFilename)) {
-        LOG(Error, "Save file not found: {0}", String(loadFilename.c_str()));
-        return false;
+    // Phase one runs here on the game thread: systems only serialize into memory
+    std::unique_ptr<SaveSnapshot> snapshot;
+    try {
+        snapshot = CaptureSnapshot(saveFilename, format);
+    } catch (const std::exception& e) {
+        LOG(Error, "Exception during save snapshot: {0}", String(e.what()));
+        std::promise<bool> failed;
+        failed.set_value(false);
+        return failed.get_future().share();
+    }
+    
+    if (saveFilename == m_incrementalFile) {
+        m_incrementalFile.clear();
     }
     
-    const char* formatName = format == SerializationFormat::Binary ? "Binary" : "Text";
-    LOG(Info, "Loading game from: {0} (Format: {1})", String(loadFilename.c_str()), String(formatName));
+    return QueueSnapshot(std::move(snapshot));
+}
 
+bool SaveLoadSystem::SaveGameIncremental(const std::string& filename) {
+    std::string saveFilename = EnsureCorrectExtension(filename, SerializationFormat::Binary);
+    
     try {
-        if (format == SerializationFormat::Binary) {
-            BinaryReader reader(loadFilename);
-            if (!reader.IsValid()) {
-                LOG(Error, "Failed to open save file: {0}", String(loadFilename.c_str()));
-                return false;
-            }
-            
-            // Read header information
-            uint32_t systemCount = 0;
-            reader.Read(systemCount);
-            
-            // For each system in the file
-            for (uint32_t i = 0; i < systemCount; ++i) {
-                std::string systemName;
-                reader.Read(systemName);
-                
-                auto system = GetSystemByName(systemName);
-                if (system) {
-                    system->Deserialize(reader);
-                    LOG(Info, "Loaded system: {0}", String(systemName.c_str()));
-                } else {
-                    LOG(Warning, "System not found for deserialization: {0}", String(systemName.c_str()));
-                    // Skip data
-                    uint32_t size = 0;
-                    reader.Read(size);
-                    for (uint32_t j = 0; j < size; j++) {
-                        char dummy;
-                        reader.Read(&dummy, 1);
-                    }
-                }
-            }
-        } else { // Text format
-            TextReader textReader;
-            if (!textReader.LoadFromFile(loadFilename)) {
-                LOG(Error, "Failed to parse text save file: {0}", String(loadFilename.c_str()));
-                return false;
-            }
-            
-            // Version check (optional)
-            std::string version;
-            if (textReader.Read("version", version)) {
-                LOG(Info, "Save file version: {0}", String(version.c_str()));
-            }
-            
-            // Get system count
-            int systemCount = 0;
-            if (!textReader.Read("systemCount", systemCount)) {
-                LOG(Error, "Invalid system count in save file");
-                return false;
-            }
-            
-            // Load systems
-            for (int i = 0; i < systemCount; i++) {
-                std::string systemName;
-                if (!textReader.Read("system" + std::to_string(i), systemName)) {
-                    LOG(Warning, "Missing system name at index {0}", i);
-                    continue;
-                }
-                
-                auto system = GetSystemByName(systemName);
-                if (system) {
-                    if (systemName == "CharacterProgressionSystem") {
-                        static_cast<CharacterProgressionSystem*>(system)->DeserializeFromText(textReader);
-                    } else if (systemName == "QuestSystem") {
-                        static_cast<QuestSystem*>(system)->DeserializeFromText(textReader);
-                    } else if (systemName == "TestSystem") {
-                        static_cast<TestSystem*>(system)->DeserializeFromText(textReader);
-                    } else if (systemName == "TimeSystem") {
-                        static_cast<TimeSystem*>(system)->DeserializeFromText(textReader);
-                    }
-                    
-                    LOG(Info, "Loaded system from text: {0}", String(systemName.c_str()));
-                } else {
-                    LOG(Warning, "System not found for text deserialization: {0}", String(systemName.c_str()));
-                }
-            }
+        auto snapshot = CaptureIncrementalSnapshot(saveFilename);
+        bool success = WriteSnapshot(*snapshot);
+        if (!success) {
+            // The dirty state is already consumed, so restart the chain with a full base
+            m_incrementalFile.clear();
         }
-        
-        LOG(Info, "Game loaded successfully: {0}", String(loadFilename.c_str()));
-        return true;
+        return success;
     } catch (const std::exception& e) {
-        LOG(Error, "Exception during load: {0}", String(e.what()));
+        LOG(Error, "Exception during incremental save: {0}", String(e.what()));
+        m_incrementalFile.clear();
         return false;
     }
 }
 
-void SaveLoadSystem::RegisterSerializableSystem(const std::string& systemName) {
-    m_serializableSystems.insert(systemName);
-    LOG(Info, "Registered system for serialization: {0}", String(systemName.c_str()));
+std::shared_future<bool> SaveLoadSystem::SaveGameIncrementalAsync(const std::string& filename) {
+    std::string saveFilename = EnsureCorrectExtension(filename, SerializationFormat::Binary);
+    
+    std::unique_ptr<SaveSnapshot> snapshot;
+    try {
+        snapshot = CaptureIncrementalSnapshot(saveFilename);
+    } catch (const std::exception& e) {
+        LOG(Error, "Exception during incremental save snapshot: {0}", String(e.what()));
+        m_incrementalFile.clear();
+        std::promise<bool> failed;
+        failed.set_value(false);
+        return failed.get_future().share();
+    }
+    
+    return QueueSnapshot(std::move(snapshot));
 }
 
-// Default binary serialization
-void SaveLoadSystem::Serialize(BinaryWriter& writer) const {
-    // Save system's own data (if any)
-    writer.Write(static_cast<uint32_t>(m_serializableSystems.size()));
+std::shared_future<bool> SaveLoadSystem::QueueSnapshot(std::unique_ptr<SaveSnapshot> snapshot) {
+    std::lock_guard<std::mutex> lock(m_saveMutex);
     
-    for (const auto& systemName : m_serializableSystems) {
-        writer.Write(systemName);
+    if (!m_saveThread.joinable()) {
+        m_stopSaveThread = false;
+        m_saveThread = std::thread(&SaveLoadSystem::SaveThreadMain, this);
+    }
+    
+    // A queued standalone save to the same file that hasn't started yet just takes the
+    // newer snapshot. Delta chain saves can't be merged this way, each holds changes
+    // the next one doesn't.
+    if (snapshot->kind == SnapshotKind::Full || snapshot->kind == SnapshotKind::Slot) {
+        for (auto& job : m_pendingSaves) {
+            if (job.snapshot->kind == snapshot->kind && job.snapshot->filename == snapshot->filename) {
+                job.snapshot = std::move(snapshot);
+                LOG(Info, "Coalesced save request: {0}", String(job.snapshot->filename.c_str()));
+                return job.future;
+            }
+        }
     }
+    
+    SaveJob job;
+    job.snapshot = std::move(snapshot);
+    job.promise = std::make_shared<std::promise<bool>>();
+    job.future = job.promise->get_future().share();
+    std::shared_future<bool> future = job.future;
+    LOG(Info, "Queued background save: {0}", String(job.snapshot->filename.c_str()));
+    m_pendingSaves.push_back(std::move(job));
+    m_saveCondition.notify_one();
+    
+    return future;
 }
 
-// Default binary deserialization
-void SaveLoadSystem::Deserialize(BinaryReader& reader) {
-    // Load system's own data (if any)
-    uint32_t systemCount = 0;
-    reader.Read(systemCount);
+bool SaveLoadSystem::IsSaveInProgress() const {
+    std::lock_guard<std::mutex> lock(m_saveMutex);
+    return !m_pendingSaves.empty() || m_saveInFlight;
+}
+
+void SaveLoadSystem::WaitForPendingSaves() {
+    std::unique_lock<std::mutex> lock(m_saveMutex);
+    m_saveIdleCondition.wait(lock, [this] { return m_pendingSaves.empty() && !m_saveInFlight; });
+}
+
+std::unique_ptr<SaveLoadSystem::SaveSnapshot> SaveLoadSystem::CaptureSnapshot(const std::string& saveFilename, SerializationFormat format) {
+    FinishDeferredLoads();
     
-    m_serializableSystems.clear();
-    for (uint32_t i = 0; i < systemCount; ++i) {
-        std::string systemName;
-        reader.Read(systemName);
-        m_serializableSystems.insert(systemName);
+    auto snapshot = std::make_unique<SaveSnapshot>();
+    snapshot->filename = saveFilename;
+    snapshot->format = format;
+    snapshot->generation = NewGeneration();
+    
+    if (format == SerializationFormat::Binary) {
+        // Each system is serialized into its own chunk so it can be checksummed and skipped.
+        // Strings are pooled in a table that goes in front of the system chunks; it is
+        // encoded once the frozen chunks have been serialized too.
+        std::vector<std::string> systemNames(m_serializableSystems.begin(), m_serializableSystems.end());
+        snapshot->strings = std::make_unique<StringTableBuilder>();
+        snapshot->chunks.resize(1);
+        snapshot->frozenChunks.resize(1);
+        snapshot->chunks[0].systemName = StringTableChunkName;
+        snapshot->stringBytesSaved = SerializeChunks(systemNames, false, snapshot->chunks, snapshot->strings.get(),
+            &snapshot->frozenChunks);
+        CaptureSlotInfo(*snapshot);
+    } else if (format == SerializationFormat::Text) {
+        TextWriter& textWriter = snapshot->text;
+        
+        // Systems are written in name order so identical state gives an identical file
+        std::vector<std::string> systemNames(m_serializableSystems.begin(), m_serializableSystems.end());
+        std::sort(systemNames.begin(), systemNames.end());
+        
+        // Write version info
+        textWriter.Write("version", TextSaveVersion);
+        textWriter.Write("systemCount", static_cast<int>(systemNames.size()));
+        
+        // Write system names
+        for (size_t index = 0; index < systemNames.size(); ++index) {
+            textWriter.WriteIndexed("system", index, systemNames[index]);
+        }
+        
+        // For each registered system, call its SerializeToText method
+        for (const auto& systemName : systemNames) {
+            auto system = GetSystemByName(systemName);
+            if (system) {
+                if (systemName == "CharacterProgressionSystem") {
+                    static_cast<CharacterProgressionSystem*>(system)->SerializeToText(textWriter);
+                } else if (systemName == "QuestSystem") {
+                    static_cast<QuestSystem*>(system)->SerializeToText(textWriter);
+                } else if (systemName == "TestSystem") {
+                    static_cast<TestSystem*>(system)->SerializeToText(textWriter);
+                } else if (systemName == "TimeSystem") {
+                    static_cast<TimeSystem*>(system)->SerializeToText(textWriter);
+                }
+                LOG(Info, "Saved system to text: {0}", String(systemName.c_str()));
+            } else {
+                LOG(Warning, "System not found for text serialization: {0}", String(systemName.c_str()));
+            }
+        }
+    } else { // JSON format
+        JsonWriter& jsonWriter = snapshot->json;
+        
+        std::vector<std::string> systemNames(m_serializableSystems.begin(), m_serializableSystems.end());
+        std::sort(systemNames.begin(), systemNames.end());
+        
+        jsonWriter.BeginObject();
+        jsonWriter.Write("version", "1.0.0");
+        jsonWriter.BeginArray("systems");
+        for (const auto& systemName : systemNames) {
+            jsonWriter.WriteValue(systemName);
+        }
+        jsonWriter.EndArray();
+        
+        // One object per system, written straight into the output buffer
+        for (const auto& systemName : systemNames) {
+            auto system = GetSystemByName(systemName);
+            if (!system) {
+                LOG(Warning, "System not found for JSON serialization: {0}", String(systemName.c_str()));
+                continue;
+            }
+            jsonWriter.BeginObject(systemName);
+            system->SerializeToJson(jsonWriter);
+            jsonWriter.EndObject();
+            LOG(Info, "Saved system to JSON: {0}", String(systemName.c_str()));
+        }
+        jsonWriter.EndObject();
     }
+    
+    return snapshot;
 }
 
-// Text serialization
-void SaveLoadSystem::SerializeToText(TextWriter& writer) const {
-    // Create list of system names
-    std::vector<std::string> systems;
+std::unique_ptr<SaveLoadSystem::SaveSnapshot> SaveLoadSystem::CaptureIncrementalSnapshot(const std::string& saveFilename) {
+    FinishDeferredLoads();
+    std::unique_ptr<SaveSnapshot> snapshot;
+    
+    // Loaded data from older chunks also goes into a fresh base, which stores it upgraded
+    bool startNewBase = !m_journalEnabled || saveFilename != m_incrementalFile ||
+        m_deltaRecordCount >= m_deltaCompactionThreshold || m_needsNewBase;
+    if (startNewBase) {
+        // Compaction: fold the chain into a fresh base
+        snapshot = CaptureSnapshot(saveFilename, SerializationFormat::Binary);
+        snapshot->kind = SnapshotKind::Base;
+        
+        m_incrementalFile = saveFilename;
+        m_incrementalGeneration = snapshot->generation;
+        m_deltaRecordCount = 0;
+        m_needsNewBase = false;
+        LOG(Info, "Writing incremental save base: {0}", String(saveFilename.c_str()));
+    } else {
+        snapshot = std::make_unique<SaveSnapshot>();
+        snapshot->filename = saveFilename;
+        snapshot->format = SerializationFormat::Binary;
+        snapshot->kind = SnapshotKind::Delta;
+        snapshot->generation = m_incrementalGeneration;
+        snapshot->sequence = ++m_deltaRecordCount;
+        
+        std::vector<std::string> dirtySystems;
+        for (const auto& systemName : m_serializableSystems) {
+            auto system = GetSystemByName(systemName);
+            if (system && system->IsDirty()) {
+                dirtySystems.push_back(systemName);
+            }
+        }
+        SerializeChunks(dirtySystems, true, snapshot->chunks);
+        LOG(Info, "Writing incremental save delta {0} with {1} systems", snapshot->sequence, static_cast<int>(snapshot->chunks.size()));
+    }
+    
+    // Everything up to here is now captured in either the base or this delta
     for (const auto& systemName : m_serializableSystems) {
-        systems.push_back(systemName);
+        auto system = GetSystemByName(systemName);
+        if (system) {
+            system->ClearDirty();
+        }
+    }
+    
+    return snapshot;
+}
+
+void SaveLoadSystem::CompleteSnapshot(SaveSnapshot& snapshot) {
+    // Frozen states don't change any more, so they serialize on this thread while the
+    // game carries on
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < snapshot.frozenChunks.size(); ++i) {
+        if (snapshot.frozenChunks[i]) {
+            pending.push_back(i);
+        }
+    }
+    std::vector<int64_t> bytesSaved(pending.size(), 0);
+    RunTasks(pending.size(), m_parallelSerialization, [&](size_t index) {
+        SnapshotChunk& chunk = snapshot.chunks[pending[index]];
+        BinaryWriter writer;
+        writer.SetStringTable(snapshot.strings.get());
+        snapshot.frozenChunks[pending[index]](writer);
+        chunk.data = writer.GetBuffer();
+        bytesSaved[index] = writer.GetStringBytesSaved();
+        LOG(Info, "Saved system: {0}", String(chunk.systemName.c_str()));
+    });
+    
+    // Dropping the frozen states lets the systems change their data in place again
+    snapshot.frozenChunks.clear();
+    
+    if (snapshot.strings) {
+        for (int64_t saved : bytesSaved) {
+            snapshot.stringBytesSaved += saved;
+        }
+        snapshot.chunks[0].data = snapshot.strings->Encode();
+        snapshot.stringBytesSaved -= static_cast<int64_t>(snapshot.chunks[0].data.size());
+        LOG(Info, "String table holds {0} strings, saving {1} bytes", static_cast<int>(snapshot.strings->GetCount()),
+            snapshot.stringBytesSaved);
+        snapshot.strings.reset();
+    }
+    
+    if (snapshot.kind != SnapshotKind::Delta) {
+        SaveSlotInfo& info = snapshot.slotInfo;
+        info.chunkCount = static_cast<uint32_t>(snapshot.chunks.size());
+        for (size_t i = 0; i < snapshot.chunks.size() && i < SaveSlotInfo::MaxChunkSizes; ++i) {
+            info.chunkSizes[i] = static_cast<uint32_t>(snapshot.chunks[i].data.size());
+        }
+    }
+}
+
+bool SaveLoadSystem::WriteSnapshot(SaveSnapshot& snapshot) {
+    const std::string& saveFilename = snapshot.filename;
+    
+    CompleteSnapshot(snapshot);
+    
+    if (snapshot.kind == SnapshotKind::Delta) {
+        return WriteDeltaRecord(snapshot);
+    }
+    if (snapshot.kind == SnapshotKind::Slot) {
+        return m_store.WriteSlot(snapshot.filename, snapshot.slotInfo, snapshot.chunks);
     }
     
+    // Files are encoded in memory and committed with an atomic replace, so a crash
+    // mid-save never leaves a half-written file where the previous save used to be
+    if (snapshot.format == SerializationFormat::Binary) {
+        // The thumbnail follows the chunks; its offset goes in the header
+        SaveSlotInfo info = snapshot.slotInfo;
+        size_t chunkBytes = 0;
+        for (const auto& chunk : snapshot.chunks) {
+            chunkBytes += sizeof(uint32_t) * 4 + chunk.systemName.size() + chunk.data.size();
+        }
+        if (!snapshot.thumbnail.empty()) {
+            info.thumbnailOffset = static_cast<uint32_t>(SaveSlotHeaderSize + chunkBytes);
+            info.thumbnailSize = static_cast<uint32_t>(snapshot.thumbnail.size());
+        }
+        
+        BinaryWriter writer;
+        WriteSaveSlotHeader(writer, info);
+        for (const auto& chunk : snapshot.chunks) {
+            WriteChunk(writer, chunk);
+        }
+        if (!snapshot.thumbnail.empty()) {
+            writer.Write(snapshot.thumbnail.data(), snapshot.thumbnail.size());
+        }
+        
+        if (!WriteFileAtomic(saveFilename, writer.GetBuffer().data(), writer.GetSize())) {
+            LOG(Error, "Failed to write save file: {0}", String(saveFilename.c_str()));
+            return false;
+        }
+        
+        // The new base supersedes any journal written against an older one. If the
+        // delete doesn't make it to disk, the stale records still carry the old
+        // generation and are skipped on load.
+        std::string deltaFilename = GetDeltaFilename(saveFilename);
+        if (m_journal.IsOpen(deltaFilename)) {
+            m_journal.Close();
+        }
+        std::error_code error;
+        fs::remove(deltaFilename, error);
+    } else if (snapshot.format == SerializationFormat::Text) {
+        const std::string& text = snapshot.text.GetBuffer();
+        if (!WriteFileAtomic(saveFilename, text.data(), text.size())) {
+            LOG(Error, "Failed to write text save file: {0}", String(saveFilename.c_str()));
+            return false;
+        }
+    } else { // JSON format
+        const std::string& json = snapshot.json.GetBuffer();
+        if (!WriteFileAtomic(saveFilename, json.data(), json.size())) {
+            LOG(Error, "Failed to write JSON save file: {0}", String(saveFilename.c_str()));
+            return false;
+        }
+    }
+    
+    LOG(Info, "Game saved successfully: {0}", String(saveFilename.c_str()));
+    return true;
+}
+
+bool SaveLoadSystem::WriteDeltaRecord(const SaveSnapshot& snapshot) {
+    if (snapshot.chunks.empty()) {
+        LOG(Info, "Nothing changed since the last incremental save: {0}", String(snapshot.filename.c_str()));
+        return true;
+    }
+    
+    // Build the whole record first so it reaches the file in a single append
+    BinaryWriter record;
+    record.Write(DeltaRecordMagic);
+    record.Write(snapshot.generation);
+    record.Write(snapshot.sequence);
+    record.Write(static_cast<uint32_t>(snapshot.chunks.size()));
+    for (const auto& chunk : snapshot.chunks) {
+        WriteChunk(record, chunk);
+    }
+    
+    // The journal stays open between records; fsync is batched by the journal
+    std::string deltaFilename = GetDeltaFilename(snapshot.filename);
+    if (!m_journal.Open(deltaFilename)) {
+        return false;
+    }
+    if (!m_journal.Append(record.GetBuffer().data(), record.GetSize())) {
+        return false;
+    }
+    
+    LOG(Info, "Appended delta record {0} ({1} bytes) to {2}", snapshot.sequence, static_cast<int>(record.GetSize()), String(deltaFilename.c_str()));
+    return true;
+}
+
+std::string SaveLoadSystem::GetDeltaFilename(const std::string& saveFilename) const {
+    fs::path filePath(saveFilename);
+    filePath.replace_extension(".delta");
+    return filePath.string();
+}
+
+uint32_t SaveLoadSystem::ReplayDeltaRecords(const std::string& saveFilename, uint32_t generation, uint32_t formatVersion) {
+    DeltaJournal journal;
+    ReadDeltaRecords(saveFilename, generation, formatVersion, journal);
+    return ApplyDeltaRecords(journal);
+}
+
+void SaveLoadSystem::ReadDeltaRecords(const std::string& saveFilename, uint32_t generation, uint32_t formatVersion,
+    DeltaJournal& journal) {
+    journal = DeltaJournal();
+    journal.filename = GetDeltaFilename(saveFilename);
+    
+    // The journal may be truncated below, don't keep appending through a stale handle
+    if (m_journal.IsOpen(journal.filename)) {
+        m_journal.Close();
+    }
+    
+    if (!fs::exists(journal.filename) || !ReadFileContents(journal.filename, journal.data)) {
+        return;
+    }
+    
+    BinaryReader reader(journal.data.data(), journal.data.size());
+    uint32_t expectedSequence = 1;
+    
+    while (reader.GetRemaining() > 0) {
+        size_t recordStart = journal.data.size() - reader.GetRemaining();
+        
+        uint32_t magic = 0;
+        uint32_t recordGeneration = 0;
+        uint32_t sequence = 0;
+        uint32_t chunkCount = 0;
+        reader.Read(magic);
+        reader.Read(recordGeneration);
+        reader.Read(sequence);
+        reader.Read(chunkCount);
+        
+        // A torn record at the end of the file is an interrupted append, the records
+        // before it are still good. Cut it off so new records follow the good ones.
+        std::vector<SaveChunk> chunks;
+        if (reader.HasFailed() || magic != DeltaRecordMagic || !ReadChunks(reader, chunkCount, formatVersion, chunks)) {
+            LOG(Warning, "Discarding incomplete delta record at the end of {0}", String(journal.filename.c_str()));
+            std::error_code error;
+            fs::resize_file(journal.filename, recordStart, error);
+            break;
+        }
+        
+        if (recordGeneration != generation) {
+            continue;
+        }
+        
+        // A generation's records are numbered from 1. A gap is an append that failed after
+        // its changes were captured, and the records behind it build on those changes.
+        if (sequence != expectedSequence) {
+            LOG(Warning, "Stopped replaying {0} at delta record {1}, expected record {2}",
+                String(journal.filename.c_str()), sequence, expectedSequence);
+            m_needsNewBase = true;
+            break;
+        }
+        expectedSequence++;
+        journal.records.push_back(std::move(chunks));
+    }
+}
+
+uint32_t SaveLoadSystem::ApplyDeltaRecords(const DeltaJournal& journal, const std::unordered_set<std::string>* systems) {
+    uint32_t applied = 0;
+    for (const std::vector<SaveChunk>& chunks : journal.records) {
+        uint32_t sequence = applied + 1;
+        
+        // Chunks of an older schema are upgraded before any of the record is applied. A
+        // record that can't be upgraded ends the replay, so the game is left as of the
+        // record before it rather than with part of the changes.
+        std::vector<RPGSystem*> targets(chunks.size(), nullptr);
+        std::vector<std::vector<uint8_t>> upgraded(chunks.size());
+        bool readable = true;
+        for (size_t i = 0; i < chunks.size() && readable; ++i) {
+            auto system = GetSystemByName(chunks[i].systemName);
+            if (!system || (systems && !systems->count(chunks[i].systemName))) {
+                continue;
+            }
+            targets[i] = system;
+            if (chunks[i].schemaVersion != system->GetSchemaVersion()) {
+                readable = UpgradeChunk(chunks[i].systemName, chunks[i].schemaVersion, system->GetSchemaVersion(), true,
+                    chunks[i].data, chunks[i].size, nullptr, upgraded[i]);
+                m_needsNewBase = true;
+            }
+        }
+        if (!readable) {
+            LOG(Warning, "Stopped replaying {0} at delta record {1}, it can't be upgraded", String(journal.filename.c_str()), sequence);
+            break;
+        }
+        
+        // Likewise a chunk that fails to decode ends the replay, and the next save writes a
+        // new base instead of extending a chain the game no longer matches
+        bool decoded = true;
+        for (size_t i = 0; i < chunks.size() && decoded; ++i) {
+            if (!targets[i]) {
+                continue;
+            }
+            
+            bool upgrade = chunks[i].schemaVersion != targets[i]->GetSchemaVersion();
+            BinaryReader chunkReader(upgrade ? upgraded[i].data() : chunks[i].data, upgrade ? upgraded[i].size() : chunks[i].size);
+            targets[i]->DeserializeDelta(chunkReader);
+            if (chunkReader.HasFailed()) {
+                LOG(Error, "Delta chunk data ended early for system: {0}", String(chunks[i].systemName.c_str()));
+                decoded = false;
+            }
+        }
+        if (!decoded) {
+            LOG(Warning, "Stopped replaying {0} at delta record {1}, it is corrupt", String(journal.filename.c_str()), sequence);
+            m_needsNewBase = true;
+            break;
+        }
+        applied++;
+    }
+    
+    if (applied > 0) {
+        LOG(Info, "Replayed {0} delta records from {1}", applied, String(journal.filename.c_str()));
+    }
+    return applied;
+}
+
+uint32_t SaveLoadSystem::NewGeneration() {
+    // Unique per base write; seeded from the clock so separate sessions don't collide
+    if (m_lastGeneration == 0) {
+        m_lastGeneration = static_cast<uint32_t>(std::chrono::system_clock::now().time_since_epoch().count());
+    }
+    m_lastGeneration = m_lastGeneration * 1664525u + 1013904223u;
+    return m_lastGeneration;
+}
+
+void SaveLoadSystem::SaveThreadMain() {
+    std::unique_lock<std::mutex> lock(m_saveMutex);
+    
+    while (true) {
+        m_saveCondition.wait(lock, [this] { return m_stopSaveThread || !m_pendingSaves.empty(); });
+        
+        // Pending saves are still written on shutdown
+        if (m_pendingSaves.empty()) {
+            break;
+        }
+        
+        SaveJob job = std::move(m_pendingSaves.front());
+        m_pendingSaves.pop_front();
+        m_saveInFlight = true;
+        lock.unlock();
+        
+        // Phase two: encoding and file I/O, off the game thread
+        bool success = false;
+        try {
+            success = WriteSnapshot(*job.snapshot);
+        } catch (const std::exception& e) {
+            LOG(Error, "Exception during background save: {0}", String(e.what()));
+        }
+        
+        // Group commit: once the queue drains, one fsync covers every record
+        // appended since the last sync
+        lock.lock();
+        bool queueDrained = m_pendingSaves.empty();
+        lock.unlock();
+        if (queueDrained && !m_journal.Sync()) {
+            success = false;
+        }
+        job.promise->set_value(success);
+        
+        lock.lock();
+        m_saveInFlight = false;
+        m_completedSaves.push_back({ job.snapshot->filename, success });
+        m_saveIdleCondition.notify_all();
+        
+        // Slot writes leave superseded records behind; reclaim them while idle
+        if (m_pendingSaves.empty() && m_store.NeedsCompaction()) {
+            lock.unlock();
+            m_store.Compact();
+            lock.lock();
+        }
+    }
+}
+
+void SaveLoadSystem::StopSaveThread() {
+    {
+        std::lock_guard<std::mutex> lock(m_saveMutex);
+        if (!m_saveThread.joinable()) {
+            return;
+        }
+        m_stopSaveThread = true;
+    }
+    m_saveCondition.notify_one();
+    m_saveThread.join();
+}
+
+bool SaveLoadSystem::LoadGame(const std::string& filename, SerializationFormat format) {    
+    std::string loadFilename = EnsureCorrectExtension(filename, format);
+    
+    // Don't read a file the save thread may still be replacing or appending to
+    WaitForPendingSaves();
+    CancelDeferredLoads();
+    m_needsNewBase = false;
+    
+    if (!fs::exists(loadFilename)) {
+        LOG(Error, "Save file not found: {0}", String(loadFilename.c_str()));
+        return false;
+    }
+    
+    LOG(Info, "Loading game from: {0} (Format: {1})", String(loadFilename.c_str()), String(GetFormatName(format)));
+    
+    try {
+        if (format == SerializationFormat::Binary) {
+            std::vector<uint8_t> fileData;
+            if (!ReadFileContents(loadFilename, fileData)) {
+                LOG(Error, "Failed to open save file: {0}", String(loadFilename.c_str()));
+                return false;
+            }
+            
+            BinaryReader reader(fileData.data(), fileData.size());
+            
+            uint32_t magic = 0;
+            reader.Read(magic);
+            if (magic != SaveFileMagic) {
+                // Saves written before chunking have no header or checksums
+                LOG(Warning, "Save file has no chunk header, loading as legacy format: {0}", String(loadFilename.c_str()));
+                BinaryReader legacyReader(fileData.data(), fileData.size());
+                if (!LoadLegacyBinary(legacyReader)) {
+                    LOG(Error, "Legacy save file is truncated or corrupt: {0}", String(loadFilename.c_str()));
+                    return false;
+                }
+            } else {
+                SaveSlotInfo info;
+                if (!ReadSaveSlotHeader(fileData.data(), fileData.size(), info)) {
+                    LOG(Error, "Save file header is truncated or corrupt: {0}", String(loadFilename.c_str()));
+                    return false;
+                }
+                if (info.formatVersion > SaveFormatVersion) {
+                    LOG(Error, "Save file version {0} is newer than supported version {1}", info.formatVersion, SaveFormatVersion);
+                    return false;
+                }
+                
+                uint32_t version = info.formatVersion;
+                uint32_t generation = info.generation;
+                uint32_t systemCount = info.chunkCount;
+                reader.Skip(info.headerSize - sizeof(uint32_t)); // The magic is already read
+                
+                // Verify every chunk before touching any system state, so a corrupt
+                // file is rejected instead of being half-applied
+                std::vector<SaveChunk> chunks;
+                if (reader.HasFailed() || !ReadChunks(reader, systemCount, version, chunks)) {
+                    LOG(Error, "Save file is truncated or corrupt: {0}", String(loadFilename.c_str()));
+                    return false;
+                }
+                
+                StringTable strings;
+                if (version >= 5) {
+                    if (chunks.empty() || chunks[0].systemName != StringTableChunkName ||
+                        !strings.Decode(chunks[0].data, chunks[0].size)) {
+                        LOG(Error, "Save file string table is missing or corrupt: {0}", String(loadFilename.c_str()));
+                        return false;
+                    }
+                    chunks.erase(chunks.begin());
+                }
+                
+                if (!DeserializeChunks(chunks, version >= 5 ? &strings : nullptr)) {
+                    return false;
+                }
+                
+                if (info.hasMetadata) {
+                    m_playtime = info.playtimeSeconds;
+                }
+                
+                // Apply incremental changes saved on top of this base and continue the chain.
+                // An older format's chain is only read; saving starts a current base.
+                m_incrementalFile.clear();
+                if (version >= 3) {
+                    m_deltaRecordCount = ReplayDeltaRecords(loadFilename, generation, version);
+                    m_incrementalGeneration = generation;
+                    m_incrementalFile = loadFilename;
+                }
+                if (version < SaveFormatVersion) {
+                    m_needsNewBase = true;
+                }
+            }
+        } else if (format == SerializationFormat::Json) {
+            if (!LoadJson(loadFilename)) {
+                return false;
+            }
+        } else { // Text format
+            TextReader textReader;
+            if (!textReader.LoadFromFile(loadFilename)) {
+                LOG(Error, "Failed to parse text save file: {0}", String(loadFilename.c_str()));
+                return false;
+            }
+            
+            // Older key layouts are upgraded before any system reads them
+            std::string version;
+            if (textReader.Read("version", version)) {
+                LOG(Info, "Save file version: {0}", String(version.c_str()));
+                if (!UpgradeText(textReader, version)) {
+                    return false;
+                }
+            }
+            
+            // Get system count
+            int systemCount = 0;
+            if (!textReader.Read("systemCount", systemCount)) {
+                LOG(Error, "Invalid system count in save file");
+                return false;
+            }
+            
+            // Load systems
+            for (int i = 0; i < systemCount; i++) {
+                std::string systemName;
+                if (!textReader.ReadIndexed("system", i, systemName)) {
+                    LOG(Warning, "Missing system name at index {0}", i);
+                    continue;
+                }
+                
+                auto system = GetSystemByName(systemName);
+                if (system) {
+                    if (systemName == "CharacterProgressionSystem") {
+                        static_cast<CharacterProgressionSystem*>(system)->DeserializeFromText(textReader);
+                    } else if (systemName == "QuestSystem") {
+                        static_cast<QuestSystem*>(system)->DeserializeFromText(textReader);
+                    } else if (systemName == "TestSystem") {
+                        static_cast<TestSystem*>(system)->DeserializeFromText(textReader);
+                    } else if (systemName == "TimeSystem") {
+                        static_cast<TimeSystem*>(system)->DeserializeFromText(textReader);
+                    }
+                    
+                    LOG(Info, "Loaded system from text: {0}", String(systemName.c_str()));
+                } else {
+                    LOG(Warning, "System not found for text deserialization: {0}", String(systemName.c_str()));
+                }
+            }
+        }
+        
+        LOG(Info, "Game loaded successfully: {0}", String(loadFilename.c_str()));
+        return true;
+    } catch (const std::exception& e) {
+        LOG(Error, "Exception during load: {0}", String(e.what()));
+        return false;
+    }
+}
+
+bool SaveLoadSystem::SaveGameToSlot(const std::string& slot) {
+    LOG(Info, "Saving game to slot: {0}", String(slot.c_str()));
+    if (!m_store.IsOpen()) {
+        LOG(Error, "No save store is open");
+        return false;
+    }
+    
+    try {
+        auto snapshot = CaptureSlotSnapshot(slot);
+        return WriteSnapshot(*snapshot);
+    } catch (const std::exception& e) {
+        LOG(Error, "Exception during slot save: {0}", String(e.what()));
+        return false;
+    }
+}
+
+std::shared_future<bool> SaveLoadSystem::SaveGameToSlotAsync(const std::string& slot) {
+    std::unique_ptr<SaveSnapshot> snapshot;
+    try {
+        if (m_store.IsOpen()) {
+            snapshot = CaptureSlotSnapshot(slot);
+        } else {
+            LOG(Error, "No save store is open");
+        }
+    } catch (const std::exception& e) {
+        LOG(Error, "Exception during slot save snapshot: {0}", String(e.what()));
+    }
+    
+    if (!snapshot) {
+        std::promise<bool> failed;
+        failed.set_value(false);
+        return failed.get_future().share();
+    }
+    
+    return QueueSnapshot(std::move(snapshot));
+}
+
+std::unique_ptr<SaveLoadSystem::SaveSnapshot> SaveLoadSystem::CaptureSlotSnapshot(const std::string& slot) {
+    FinishDeferredLoads();
+    
+    auto snapshot = std::make_unique<SaveSnapshot>();
+    snapshot->filename = slot;
+    snapshot->kind = SnapshotKind::Slot;
+    snapshot->generation = NewGeneration();
+    
+    // Strings stay inline: a shared string table would change with every save and
+    // hide which systems are actually unchanged
+    std::vector<std::string> systemNames(m_serializableSystems.begin(), m_serializableSystems.end());
+    std::sort(systemNames.begin(), systemNames.end());
+    SerializeChunks(systemNames, false, snapshot->chunks, nullptr, &snapshot->frozenChunks);
+    CaptureSlotInfo(*snapshot);
+    return snapshot;
+}
+
+bool SaveLoadSystem::LoadGameFromSlot(const std::string& slot) {
+    WaitForPendingSaves();
+    CancelDeferredLoads();
+    m_needsNewBase = false;
+    
+    LOG(Info, "Loading game from slot: {0}", String(slot.c_str()));
+    
+    std::vector<SaveStoreChunk> storeChunks;
+    SaveSlotInfo info;
+    if (!m_store.ReadSlot(slot, storeChunks, &info)) {
+        LOG(Error, "Save slot not found or corrupt: {0}", String(slot.c_str()));
+        return false;
+    }
+    
+    std::vector<SaveChunk> chunks(storeChunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        chunks[i].systemName = storeChunks[i].systemName;
+        chunks[i].size = static_cast<uint32_t>(storeChunks[i].data.size());
+        chunks[i].schemaVersion = storeChunks[i].schemaVersion;
+        chunks[i].data = storeChunks[i].data.data();
+    }
+    
+    try {
+        if (!DeserializeChunks(chunks)) {
+            return false;
+        }
+    } catch (const std::exception& e) {
+        LOG(Error, "Exception during slot load: {0}", String(e.what()));
+        return false;
+    }
+    
+    if (info.hasMetadata) {
+        m_playtime = info.playtimeSeconds;
+    }
+    
+    // The loaded state no longer matches any delta chain
+    m_incrementalFile.clear();
+    
+    LOG(Info, "Game loaded from slot: {0}", String(slot.c_str()));
+    return true;
+}
+
+bool SaveLoadSystem::DeleteSaveSlot(const std::string& slot) {
+    // A queued write to the slot would bring it back
+    WaitForPendingSaves();
+    return m_store.DeleteSlot(slot);
+}
+
+bool SaveLoadSystem::LoadGamePartial(const std::string& filename, const std::vector<std::string>& immediate,
+    const std::vector<std::string>& deferred) {
+    std::string loadFilename = EnsureCorrectExtension(filename, SerializationFormat::Binary);
+    
+    WaitForPendingSaves();
+    CancelDeferredLoads();
+    m_needsNewBase = false;
+    
+    SaveSlotInfo info;
+    if (!ReadSaveSlotInfo(loadFilename, info)) {
+        // Saves without a chunk header can only be loaded whole
+        if (!LoadGame(filename, SerializationFormat::Binary)) {
+            return false;
+        }
+        for (const auto& systemName : deferred) {
+            SystemLoadedEvent event;
+            event.filename = loadFilename;
+            event.systemName = systemName;
+            event.success = true;
+            m_plugin->GetEventSystem().Publish(event);
+        }
+        return true;
+    }
+    if (info.formatVersion > SaveFormatVersion) {
+        LOG(Error, "Save file version {0} is newer than supported version {1}", info.formatVersion, SaveFormatVersion);
+        return false;
+    }
+    
+    LOG(Info, "Loading game partially from: {0} ({1} systems now, {2} deferred)", String(loadFilename.c_str()),
+        static_cast<int>(immediate.size()), static_cast<int>(deferred.size()));
+    
+    std::FILE* file = std::fopen(loadFilename.c_str(), "rb");
+    if (!file) {
+        LOG(Error, "Failed to open save file: {0}", String(loadFilename.c_str()));
+        return false;
+    }
+    
+    // Only chunk headers are read here, payloads are skipped over
+    std::vector<ChunkLocation> locations;
+    if (!ReadChunkDirectory(file, info, locations)) {
+        LOG(Error, "Save file is truncated or corrupt: {0}", String(loadFilename.c_str()));
+        std::fclose(file);
+        return false;
+    }
+    
+    auto strings = std::make_shared<StringTable>();
+    if (info.formatVersion >= 5) {
+        std::vector<uint8_t> tableData;
+        if (locations.empty() || locations[0].systemName != StringTableChunkName ||
+            !ReadChunkPayload(file, locations[0], tableData) || !strings->Decode(tableData.data(), tableData.size())) {
+            LOG(Error, "Save file string table is missing or corrupt: {0}", String(loadFilename.c_str()));
+            std::fclose(file);
+            return false;
+        }
+        locations.erase(locations.begin());
+    }
+    
+    auto findChunk = [&](const std::string& systemName) -> const ChunkLocation* {
+        for (const auto& location : locations) {
+            if (location.systemName == systemName) {
+                return &location;
+            }
+        }
+        LOG(Warning, "Save file has no chunk for system: {0}", String(systemName.c_str()));
+        return nullptr;
+    };
+    
+    // First pass: the systems needed right away, verified and loaded as in LoadGame
+    std::vector<std::vector<uint8_t>> payloads;
+    std::vector<SaveChunk> chunks;
+    std::unordered_set<std::string> loadedSystems;
+    payloads.reserve(immediate.size());
+    for (const auto& systemName : immediate) {
+        const ChunkLocation* location = findChunk(systemName);
+        if (!location || !loadedSystems.insert(systemName).second) {
+            continue;
+        }
+        payloads.emplace_back();
+        if (!ReadChunkPayload(file, *location, payloads.back())) {
+            LOG(Error, "Chunk is truncated or corrupt: {0}", String(systemName.c_str()));
+            std::fclose(file);
+            return false;
+        }
+        SaveChunk chunk;
+        chunk.systemName = systemName;
+        chunk.size = location->size;
+        chunk.checksum = location->checksum;
+        chunk.schemaVersion = location->schemaVersion;
+        chunk.data = payloads.back().data();
+        chunks.push_back(chunk);
+    }
+    std::fclose(file);
+    
+    if (!DeserializeChunks(chunks, info.formatVersion >= 5 ? strings.get() : nullptr)) {
+        return false;
+    }
+    if (info.hasMetadata) {
+        m_playtime = info.playtimeSeconds;
+    }
+    
+    // The journal is read once; its records are applied per system, as each one is
+    // restored. Deferred systems stop at the same record as the ones loaded now.
+    m_incrementalFile.clear();
+    m_deferredDeltas = DeltaJournal();
+    if (info.formatVersion >= 3) {
+        ReadDeltaRecords(loadFilename, info.generation, info.formatVersion, m_deferredDeltas);
+        m_deltaRecordCount = ApplyDeltaRecords(m_deferredDeltas, &loadedSystems);
+        m_deferredDeltas.records.resize(m_deltaRecordCount);
+        m_incrementalGeneration = info.generation;
+        m_incrementalFile = loadFilename;
+    }
+    if (info.formatVersion < SaveFormatVersion) {
+        m_needsNewBase = true;
+    }
+    
+    // Second pass on the load thread, in priority order
+    std::vector<ChunkLocation> deferredChunks;
+    std::vector<RPGSystem*> deferredSystems;
+    for (const auto& systemName : deferred) {
+        const ChunkLocation* location = findChunk(systemName);
+        RPGSystem* system = GetSystemByName(systemName);
+        if (!location || !system || !loadedSystems.insert(systemName).second) {
+            continue;
+        }
+        deferredChunks.push_back(*location);
+        deferredSystems.push_back(system);
+    }
+    
+    m_deferredRemaining = deferredChunks.size();
+    m_deferredStrings = info.formatVersion >= 5 ? strings : nullptr;
+    m_deferredFilename = loadFilename;
+    if (!deferredChunks.empty()) {
+        m_cancelLoad = false;
+        m_loadThread = std::thread(&SaveLoadSystem::LoadThreadMain, this, loadFilename,
+            std::move(deferredChunks), std::move(deferredSystems));
+    }
+    
+    LOG(Info, "Game partially loaded: {0}", String(loadFilename.c_str()));
+    return true;
+}
+
+void SaveLoadSystem::LoadThreadMain(std::string filename, std::vector<ChunkLocation> chunks, std::vector<RPGSystem*> systems) {
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    
+    for (size_t i = 0; i < chunks.size() && !m_cancelLoad; ++i) {
+        DecodedChunk decoded;
+        decoded.systemName = chunks[i].systemName;
+        decoded.system = systems[i];
+        
+        // Failed chunks are still handed over, so every deferred system gets its event
+        try {
+            std::vector<uint8_t> data;
+            uint32_t schemaVersion = decoded.system->GetSchemaVersion();
+            bool readable = file && ReadChunkPayload(file, chunks[i], data);
+            if (readable && chunks[i].schemaVersion != schemaVersion) {
+                std::vector<uint8_t> upgraded;
+                readable = UpgradeChunk(decoded.systemName, chunks[i].schemaVersion, schemaVersion, false,
+                    data.data(), data.size(), m_deferredStrings.get(), upgraded);
+                data = std::move(upgraded);
+                decoded.upgraded = true;
+            }
+            if (readable) {
+                BinaryReader reader(data.data(), data.size());
+                reader.SetStringTable(decoded.upgraded ? nullptr : m_deferredStrings.get());
+                decoded.apply = decoded.system->DecodeDeferred(reader);
+                if (decoded.apply) {
+                    decoded.success = !reader.HasFailed();
+                } else {
+                    decoded.data = std::move(data);
+                    decoded.success = true;
+                }
+            }
+        } catch (const std::exception& e) {
+            LOG(Error, "Exception while decoding deferred chunk {0}: {1}", String(decoded.systemName.c_str()), String(e.what()));
+            decoded.apply = nullptr;
+            decoded.success = false;
+        }
+        
+        std::lock_guard<std::mutex> lock(m_loadMutex);
+        m_decodedChunks.push_back(std::move(decoded));
+        m_loadCondition.notify_all();
+    }
+    
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+void SaveLoadSystem::ApplyDeferredLoads() {
+    if (m_deferredRemaining == 0) {
+        return;
+    }
+    
+    std::deque<DecodedChunk> ready;
+    {
+        std::lock_guard<std::mutex> lock(m_loadMutex);
+        ready.swap(m_decodedChunks);
+    }
+    
+    for (auto& decoded : ready) {
+        if (decoded.success && decoded.apply) {
+            decoded.apply();
+        } else if (decoded.success) {
+            BinaryReader reader(decoded.data.data(), decoded.data.size());
+            reader.SetStringTable(decoded.upgraded ? nullptr : m_deferredStrings.get());
+            decoded.system->Deserialize(reader);
+            decoded.success = !reader.HasFailed();
+        }
+        
+        if (decoded.success) {
+            if (decoded.upgraded) {
+                m_needsNewBase = true;
+            }
+            if (!m_deferredDeltas.records.empty()) {
+                std::unordered_set<std::string> system = { decoded.systemName };
+                m_deferredDeltas.records.resize(ApplyDeltaRecords(m_deferredDeltas, &system));
+            }
+            LOG(Info, "Loaded deferred system: {0}", String(decoded.systemName.c_str()));
+        } else {
+            LOG(Error, "Deferred chunk is corrupt for system: {0}", String(decoded.systemName.c_str()));
+        }
+        
+        SystemLoadedEvent event;
+        event.filename = m_deferredFilename;
+        event.systemName = decoded.systemName;
+        event.success = decoded.success;
+        m_plugin->GetEventSystem().Publish(event);
+        m_deferredRemaining--;
+    }
+    
+    if (m_deferredRemaining == 0) {
+        if (m_loadThread.joinable()) {
+            m_loadThread.join();
+        }
+        m_deferredStrings.reset();
+        m_deferredDeltas = DeltaJournal();
+    }
+}
+
+void SaveLoadSystem::FinishDeferredLoads() {
+    if (m_deferredRemaining == 0) {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(m_loadMutex);
+        m_loadCondition.wait(lock, [this] { return m_decodedChunks.size() >= m_deferredRemaining; });
+    }
+    ApplyDeferredLoads();
+}
+
+void SaveLoadSystem::CancelDeferredLoads() {
+    m_cancelLoad = true;
+    if (m_loadThread.joinable()) {
+        m_loadThread.join();
+    }
+    
+    std::lock_guard<std::mutex> lock(m_loadMutex);
+    if (m_deferredRemaining > 0) {
+        LOG(Info, "Dropped {0} deferred systems of {1}", static_cast<int>(m_deferredRemaining), String(m_deferredFilename.c_str()));
+    }
+    m_decodedChunks.clear();
+    m_deferredRemaining = 0;
+    m_deferredStrings.reset();
+    m_deferredDeltas = DeltaJournal();
+}
+
+bool SaveLoadSystem::ReadChunkDirectory(std::FILE* file, const SaveSlotInfo& info, std::vector<ChunkLocation>& chunks) const {
+    if (std::fseek(file, 0, SEEK_END) != 0) {
+        return false;
+    }
+    long fileSize = std::ftell(file);
+    if (fileSize < 0 || std::fseek(file, static_cast<long>(info.headerSize), SEEK_SET) != 0) {
+        return false;
+    }
+    
+    chunks.clear();
+    for (uint32_t i = 0; i < info.chunkCount; ++i) {
+        ChunkLocation chunk;
+        uint32_t nameLength = 0;
+        if (!ReadFileValue(file, nameLength) || nameLength > static_cast<uint32_t>(fileSize)) {
+            return false;
+        }
+        chunk.systemName.resize(nameLength);
+        if ((nameLength > 0 && !ReadFileBytes(file, &chunk.systemName[0], nameLength)) ||
+            !ReadFileValue(file, chunk.size) || !ReadFileValue(file, chunk.checksum)) {
+            return false;
+        }
+        if (info.formatVersion >= FirstSchemaVersionedFormat && !ReadFileValue(file, chunk.schemaVersion)) {
+            return false;
+        }
+        
+        chunk.offset = std::ftell(file);
+        if (chunk.offset < 0 || chunk.size > static_cast<unsigned long>(fileSize - chunk.offset) ||
+            std::fseek(file, static_cast<long>(chunk.size), SEEK_CUR) != 0) {
+            return false;
+        }
+        chunks.push_back(std::move(chunk));
+    }
+    return true;
+}
+
+bool SaveLoadSystem::ReadChunkPayload(std::FILE* file, const ChunkLocation& chunk, std::vector<uint8_t>& data) const {
+    data.resize(chunk.size);
+    if (std::fseek(file, chunk.offset, SEEK_SET) != 0 || (chunk.size > 0 && !ReadFileBytes(file, data.data(), chunk.size))) {
+        return false;
+    }
+    return ComputeCrc32c(data.data(), data.size()) == chunk.checksum;
+}
+
+void SaveLoadSystem::CaptureSlotInfo(SaveSnapshot& snapshot) {
+    SaveSlotInfo& info = snapshot.slotInfo;
+    info.generation = snapshot.generation;
+    info.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    info.playtimeSeconds = m_playtime;
+    
+    if (auto* timeSystem = m_plugin->GetSystem<TimeSystem>()) {
+        info.gameMinute = timeSystem->GetMinute();
+        info.gameHour = timeSystem->GetHour();
+        info.gameDay = timeSystem->GetDay();
+        info.gameMonth = timeSystem->GetMonth();
+        info.gameYear = timeSystem->GetYear();
+    }
+    if (auto* progressionSystem = m_plugin->GetSystem<CharacterProgressionSystem>()) {
+        info.characterLevel = progressionSystem->GetLevel();
+    }
+    
+    // Copied so a later SetSaveThumbnail can't race a background write
+    snapshot.thumbnail = m_thumbnail;
+}
+
+int64_t SaveLoadSystem::SerializeChunks(const std::vector<std::string>& systemNames, bool delta, std::vector<SnapshotChunk>& chunks,
+    StringTableBuilder* strings, std::vector<FrozenChunk>* frozen) {
+    std::vector<RPGSystem*> systems;
+    for (const auto& systemName : systemNames) {
+        systems.push_back(GetSystemByName(systemName));
+    }
+    
+    // With 'frozen', systems that can freeze their state only do that here; the chunk is
+    // serialized from it later by CompleteSnapshot
+    size_t first = chunks.size();
+    if (frozen) {
+        frozen->resize(first + systemNames.size());
+        for (size_t i = 0; i < systems.size(); ++i) {
+            if (systems[i]) {
+                (*frozen)[first + i] = systems[i]->SnapshotState();
+            }
+        }
+    }
+    
+    // Systems only read their own state while serializing, so each one is encoded into
+    // its own buffer on a separate thread and the buffers become the file's chunks
+    chunks.resize(first + systemNames.size());
+    std::vector<int64_t> bytesSaved(systemNames.size(), 0);
+    RunTasks(systemNames.size(), m_parallelSerialization, [&](size_t index) {
+        SnapshotChunk& chunk = chunks[first + index];
+        chunk.systemName = systemNames[index];
+        if (systems[index]) {
+            chunk.schemaVersion = systems[index]->GetSchemaVersion();
+        }
+        if (frozen && (*frozen)[first + index]) {
+            return;
+        }
+        
+        BinaryWriter writer;
+        writer.SetStringTable(strings);
+        if (!systems[index]) {
+            LOG(Warning, "System not found for serialization: {0}", String(chunk.systemName.c_str()));
+        } else if (delta) {
+            systems[index]->SerializeDelta(writer);
+        } else {
+            systems[index]->Serialize(writer);
+            LOG(Info, "Saved system: {0}", String(chunk.systemName.c_str()));
+        }
+        chunk.data = writer.GetBuffer();
+        bytesSaved[index] = writer.GetStringBytesSaved();
+    });
+    
+    int64_t totalSaved = 0;
+    for (int64_t saved : bytesSaved) {
+        totalSaved += saved;
+    }
+    return totalSaved;
+}
+
+bool SaveLoadSystem::DeserializeChunks(const std::vector<SaveChunk>& chunks, const StringTable* strings) {
+    struct PendingChunk {
+        const SaveChunk* chunk;
+        RPGSystem* system;
+        bool failed;
+        bool upgraded;
+    };
+    
+    std::vector<PendingChunk> pending;
+    std::unordered_set<std::string> unloaded;
+    for (const auto& chunk : chunks) {
+        auto system = GetSystemByName(chunk.systemName);
+        if (!system) {
+            LOG(Warning, "System not found for deserialization: {0}", String(chunk.systemName.c_str()));
+            continue;
+        }
+        if (chunk.size == 0) {
+            LOG(Warning, "Empty chunk for system: {0}", String(chunk.systemName.c_str()));
+            continue;
+        }
+        pending.push_back({ &chunk, system, false, false });
+        unloaded.insert(chunk.systemName);
+    }
+    
+    // A chunk that fails leaves the game as it was, so every system about to load is
+    // captured first and restored if one does. Copy-on-write systems only freeze their
+    // state, the others are serialized.
+    struct PreviousState {
+        RPGSystem* system;
+        FrozenChunk frozen;
+        std::vector<uint8_t> data;
+    };
+    std::vector<PreviousState> previous;
+    previous.reserve(pending.size());
+    for (const auto& entry : pending) {
+        PreviousState state{ entry.system, entry.system->SnapshotState(), {} };
+        if (!state.frozen) {
+            BinaryWriter writer;
+            entry.system->Serialize(writer);
+            state.data = writer.GetBuffer();
+        }
+        previous.push_back(std::move(state));
+    }
+    auto restorePrevious = [&]() {
+        for (auto& state : previous) {
+            if (state.frozen) {
+                BinaryWriter writer;
+                state.frozen(writer);
+                state.data = writer.GetBuffer();
+            }
+            BinaryReader reader(state.data.data(), state.data.size());
+            state.system->Deserialize(reader);
+        }
+        // Restoring drops the systems' record of what changed since the last save
+        m_needsNewBase = true;
+        LOG(Warning, "Load failed, restored the {0} systems it had started loading", static_cast<int>(previous.size()));
+    };
+    
+    // Systems are loaded in dependency order, one level at a time. A system only
+    // writes its own state while deserializing, so every system in a level is decoded
+    // on its own thread.
+    while (!pending.empty()) {
+        std::vector<PendingChunk> level;
+        std::vector<PendingChunk> later;
+        for (const auto& entry : pending) {
+            bool ready = true;
+            for (const auto& dependency : entry.system->GetDependencies()) {
+                if (unloaded.count(dependency)) {
+                    ready = false;
+                    break;
+                }
+            }
+            (ready ? level : later).push_back(entry);
+        }
+        if (level.empty()) {
+            LOG(Warning, "Cyclic system dependencies, loading the remaining systems together");
+            level.swap(later);
+        }
+        
+        RunTasks(level.size(), m_parallelSerialization, [&](size_t index) {
+            const SaveChunk& chunk = *level[index].chunk;
+            uint32_t schemaVersion = level[index].system->GetSchemaVersion();
+            std::vector<uint8_t> upgraded;
+            if (chunk.schemaVersion != schemaVersion) {
+                // UpgradeChunk reports its own failures
+                level[index].upgraded = UpgradeChunk(chunk.systemName, chunk.schemaVersion, schemaVersion, false,
+                    chunk.data, chunk.size, strings, upgraded);
+                if (!level[index].upgraded) {
+                    level[index].failed = true;
+                    return;
+                }
+            }
+            
+            BinaryReader chunkReader(level[index].upgraded ? upgraded.data() : chunk.data,
+                level[index].upgraded ? upgraded.size() : chunk.size);
+            chunkReader.SetStringTable(level[index].upgraded ? nullptr : strings);
+            level[index].system->Deserialize(chunkReader);
+            if (chunkReader.HasFailed()) {
+                LOG(Error, "Chunk data ended early for system: {0}", String(chunk.systemName.c_str()));
+                level[index].failed = true;
+            }
+        });
+        
+        for (const auto& entry : level) {
+            if (entry.failed) {
+                restorePrevious();
+                return false;
+            }
+            if (entry.upgraded) {
+                m_needsNewBase = true;
+            }
+            unloaded.erase(entry.chunk->systemName);
+            LOG(Info, "Loaded system: {0}", String(entry.chunk->systemName.c_str()));
+        }
+        pending.swap(later);
+    }
+    return true;
+}
+
+void SaveLoadSystem::WriteChunk(BinaryWriter& writer, const SnapshotChunk& chunk) const {
+    writer.Write(chunk.systemName);
+    writer.Write(static_cast<uint32_t>(chunk.data.size()));
+    writer.Write(ComputeCrc32c(chunk.data.data(), chunk.data.size()));
+    writer.Write(chunk.schemaVersion);
+    if (!chunk.data.empty()) {
+        writer.Write(chunk.data.data(), chunk.data.size());
+    }
+}
+
+bool SaveLoadSystem::ReadChunks(BinaryReader& reader, uint32_t systemCount, uint32_t formatVersion, std::vector<SaveChunk>& chunks) const {
+    // A chunk header is at least a name length, a size, a checksum and, from format 6, a
+    // schema version
+    bool versioned = formatVersion >= FirstSchemaVersionedFormat;
+    if (!reader.CanHold(systemCount, sizeof(uint32_t) * (versioned ? 4 : 3))) {
+        return false;
+    }
+    
+    chunks.clear();
+    chunks.reserve(systemCount);
+    
+    for (uint32_t i = 0; i < systemCount; ++i) {
+        SaveChunk chunk;
+        reader.Read(chunk.systemName);
+        reader.Read(chunk.size);
+        reader.Read(chunk.checksum);
+        if (versioned) {
+            reader.Read(chunk.schemaVersion);
+        }
+        if (reader.HasFailed() || chunk.size > reader.GetRemaining()) {
+            return false;
+        }
+        
+        chunk.data = reader.GetPosition();
+        reader.Skip(chunk.size);
+        chunks.push_back(chunk);
+    }
+    
+    // Checksums are verified in parallel, one chunk per thread
+    std::vector<uint8_t> valid(chunks.size(), 0);
+    RunTasks(chunks.size(), m_parallelSerialization, [&](size_t index) {
+        valid[index] = ComputeCrc32c(chunks[index].data, chunks[index].size) == chunks[index].checksum;
+    });
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (!valid[i]) {
+            LOG(Error, "Checksum mismatch in chunk {0}", String(chunks[i].systemName.c_str()));
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SaveLoadSystem::LoadLegacyBinary(BinaryReader& reader) {
+    uint32_t systemCount = 0;
+    reader.Read(systemCount);
+    
+    for (uint32_t i = 0; i < systemCount && !reader.HasFailed(); ++i) {
+        std::string systemName;
+        reader.Read(systemName);
+        
+        auto system = GetSystemByName(systemName);
+        if (!system) {
+            // Legacy chunks carry no size, so there is no way to skip an unknown system
+            LOG(Error, "Unknown system in legacy save: {0}", String(systemName.c_str()));
+            return false;
+        }
+        system->Deserialize(reader);
+        LOG(Info, "Loaded system: {0}", String(systemName.c_str()));
+    }
+    return !reader.HasFailed();
+}
+
+bool SaveLoadSystem::LoadJson(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        LOG(Error, "Failed to open JSON save file: {0}", String(filename.c_str()));
+        return false;
+    }
+    
+    // A streaming check first, so malformed files are rejected before any system
+    // state is touched. Neither pass holds more than one record in memory.
+    if (!ValidateJson(file)) {
+        LOG(Error, "JSON save file is malformed: {0}", String(filename.c_str()));
+        return false;
+    }
+    file.clear();
+    file.seekg(0, std::ios::beg);
+    
+    RPGSystem* current = nullptr;
+    JsonSaveHandlers handlers;
+    handlers.onSectionBegin = [this, &current](const std::string& section) {
+        current = GetSystemByName(section);
+        if (current) {
+            current->BeginJsonLoad();
+        } else {
+            LOG(Warning, "System not found for JSON deserialization: {0}", String(section.c_str()));
+        }
+    };
+    handlers.onField = [&current](const std::string&, const std::string& field, const nlohmann::json& value) {
+        if (current) {
+            current->DeserializeJsonField(field, value);
+        }
+    };
+    handlers.onSectionEnd = [&current](const std::string& section) {
+        if (current) {
+            current->EndJsonLoad();
+            LOG(Info, "Loaded system from JSON: {0}", String(section.c_str()));
+        }
+        current = nullptr;
+    };
+    
+    std::string error;
+    if (!ReadJsonSave(file, handlers, error)) {
+        LOG(Error, "Failed to parse JSON save file {0}: {1}", String(filename.c_str()), String(error.c_str()));
+        return false;
+    }
+    return true;
+}
+
+bool SaveLoadSystem::ReadFileContents(const std::string& filename, std::vector<uint8_t>& data) const {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::streamoff size = file.tellg();
+    if (size < 0) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(size));
+    file.seekg(0, std::ios::beg);
+    if (size > 0) {
+        file.read(reinterpret_cast<char*>(data.data()), size);
+    }
+    return file.good();
+}
+
+void SaveLoadSystem::RegisterSerializableSystem(const std::string& systemName) {
+    m_serializableSystems.insert(systemName);
+    LOG(Info, "Registered system for serialization: {0}", String(systemName.c_str()));
+}
+
+std::vector<std::string> SaveLoadSystem::GetSerializableSystems() const {
+    std::vector<std::string> systemNames(m_serializableSystems.begin(), m_serializableSystems.end());
+    std::sort(systemNames.begin(), systemNames.end());
+    return systemNames;
+}
+
+void SaveLoadSystem::RegisterChunkUpgrade(const std::string& systemName, uint32_t fromVersion, ChunkUpgrade upgrade,
+    ChunkUpgrade deltaUpgrade) {
+    m_chunkUpgrades[{ systemName, fromVersion }] = { std::move(upgrade), std::move(deltaUpgrade) };
+}
+
+bool SaveLoadSystem::UpgradeChunk(const std::string& systemName, uint32_t fromVersion, uint32_t toVersion, bool delta,
+    const uint8_t* data, size_t size, const StringTable* strings, std::vector<uint8_t>& upgraded) const {
+    if (fromVersion > toVersion) {
+        LOG(Error, "Chunk for system {0} has schema {1}, newer than the supported schema {2}", String(systemName.c_str()),
+            fromVersion, toVersion);
+        return false;
+    }
+    
+    upgraded.assign(data, data + size);
+    for (uint32_t version = fromVersion; version < toVersion; ++version) {
+        auto it = m_chunkUpgrades.find({ systemName, version });
+        const ChunkUpgrade* upgrade = nullptr;
+        if (it != m_chunkUpgrades.end()) {
+            upgrade = delta ? &it->second.deltaUpgrade : &it->second.upgrade;
+        }
+        if (!upgrade || !*upgrade) {
+            LOG(Error, "No {0}upgrade registered for system {1} from schema {2}", String(delta ? "delta " : ""),
+                String(systemName.c_str()), version);
+            return false;
+        }
+        
+        // Only the stored payload uses the save's string table; upgraded ones are inline
+        BinaryReader reader(upgraded.data(), upgraded.size());
+        reader.SetStringTable(version == fromVersion ? strings : nullptr);
+        BinaryWriter writer;
+        if (!(*upgrade)(reader, writer) || reader.HasFailed()) {
+            LOG(Error, "Failed to upgrade chunk for system {0} from schema {1}", String(systemName.c_str()), version);
+            return false;
+        }
+        upgraded = writer.GetBuffer();
+    }
+    if (fromVersion < toVersion) {
+        LOG(Info, "Upgraded chunk for system {0} from schema {1} to {2}", String(systemName.c_str()), fromVersion, toVersion);
+    }
+    return true;
+}
+
+void SaveLoadSystem::RegisterTextUpgrade(const std::string& fromVersion, const std::string& toVersion, TextUpgrade upgrade) {
+    m_textUpgrades[fromVersion] = { toVersion, std::move(upgrade) };
+}
+
+bool SaveLoadSystem::UpgradeText(TextReader& reader, std::string version) const {
+    // Every step must lead somewhere new, or the chain of upgrades has a loop
+    for (size_t steps = 0; version != TextSaveVersion; ++steps) {
+        auto it = m_textUpgrades.find(version);
+        if (it == m_textUpgrades.end() || steps == m_textUpgrades.size()) {
+            LOG(Error, "Text save version {0} is not supported, expected {1}", String(version.c_str()), String(TextSaveVersion));
+            return false;
+        }
+        
+        TextWriter writer;
+        it->second.second(reader, writer);
+        reader.LoadFromString(writer.GetBuffer());
+        LOG(Info, "Upgraded text save from version {0} to {1}", String(version.c_str()), String(it->second.first.c_str()));
+        version = it->second.first;
+    }
+    return true;
+}
+
+// Default binary serialization
+void SaveLoadSystem::Serialize(BinaryWriter& writer) const {
+    // Save system's own data (if any)
+    writer.Write(static_cast<uint32_t>(m_serializableSystems.size()));
+    
+    for (const auto& systemName : m_serializableSystems) {
+        writer.Write(systemName);
+    }
+}
+
+// Default binary deserialization
+void SaveLoadSystem::Deserialize(BinaryReader& reader) {
+    // Load system's own data (if any)
+    uint32_t systemCount = 0;
+    reader.Read(systemCount);
+    
+    m_serializableSystems.clear();
+    for (uint32_t i = 0; i < systemCount && !reader.HasFailed(); ++i) {
+        std::string systemName;
+        reader.Read(systemName);
+        m_serializableSystems.insert(systemName);
+    }
+}
+
+// Text serialization
+void SaveLoadSystem::SerializeToText(TextWriter& writer) const {
+    // Create sorted list of system names
+    std::vector<std::string> systems(m_serializableSystems.begin(), m_serializableSystems.end());
+    std::sort(systems.begin(), systems.end());
+    
     // Write the number of systems
     writer.Write("systemCount", static_cast<int>(systems.size()));
     
     // Write each system name
     for (size_t i = 0; i < systems.size(); ++i) {
-        writer.Write("system" + std::to_string(i), systems[i]);
+        writer.WriteIndexed("system", i, systems[i]);
     }
 }
 
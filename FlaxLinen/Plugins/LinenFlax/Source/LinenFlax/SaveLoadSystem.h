@@ -2,12 +2,42 @@
 #pragma once
 
 #include "RPGSystem.h"
+#include "EventSystem.h"
 #include "Serialization.h"
+#include "JsonSerialization.h"
+#include "SaveFileIO.h"
+#include "SaveSlotInfo.h"
+#include "SaveStore.h"
+#include "AutosaveScheduler.h"
 #include <string>
 #include <unordered_set>
 #include <functional>
 #include <unordered_map>
+#include <map>
 #include <memory>
+#include <vector>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <atomic>
+#include <cstdio>
+
+// Fired on the game thread once a background save has been written
+class SaveCompletedEvent : public EventType<SaveCompletedEvent> {
+public:
+    std::string filename;
+    bool success = false;
+};
+
+// Fired on the game thread as each deferred system of a partial load is applied
+class SystemLoadedEvent : public EventType<SystemLoadedEvent> {
+public:
+    std::string filename;
+    std::string systemName;
+    bool success = false;
+};
 
 class SaveLoadSystem : public RPGSystem {
 public:
@@ -15,20 +45,122 @@ public:
     // Delete copy constructor and assignment operator
     SaveLoadSystem(const SaveLoadSystem&) = delete;
     SaveLoadSystem& operator=(const SaveLoadSystem&) = delete;
-
+    
     // RPGSystem interface
     void Initialize() override;
     void Shutdown() override;
     void Update(float deltaTime) override;
-
+    
     std::string GetName() const override { return "SaveLoadSystem"; }
     
     // Save/Load functionality
     bool SaveGame(const std::string& filename, SerializationFormat format = SerializationFormat::Binary);
     bool LoadGame(const std::string& filename, SerializationFormat format = SerializationFormat::Binary);
     
+    // Partial loading of binary saves, so the first frame only waits for what it needs.
+    // Systems in 'immediate' are restored before this returns; only their chunks and the
+    // string table are read. Chunks of the 'deferred' systems are read and decoded on a
+    // background thread, highest priority first, and applied from Update() in that order
+    // with a SystemLoadedEvent each. Systems in neither list keep their current state.
+    bool LoadGamePartial(const std::string& filename, const std::vector<std::string>& immediate,
+        const std::vector<std::string>& deferred);
+    bool IsLoadInProgress() const { return m_deferredRemaining > 0; }
+    
+    // Waits for the deferred systems of the last partial load and applies them now.
+    // Saves call this first, so they never capture a half-loaded game.
+    void FinishDeferredLoads();
+    
+    // Snapshots system state on the calling thread, then encodes and writes the file on a
+    // background thread. A request for a file that is still queued replaces the queued
+    // snapshot and shares its future. SaveCompletedEvent is published from Update().
+    std::shared_future<bool> SaveGameAsync(const std::string& filename, SerializationFormat format = SerializationFormat::Binary);
+    bool IsSaveInProgress() const;
+    void WaitForPendingSaves();
+    
+    // Incremental binary saves. The first save to a file (and every compaction) writes a
+    // full base snapshot; later saves append a delta record holding only what systems
+    // report as dirty. LoadGame replays the delta records on top of the base.
+    bool SaveGameIncremental(const std::string& filename);
+    std::shared_future<bool> SaveGameIncrementalAsync(const std::string& filename);
+    
+    // Number of delta records appended before they are compacted into a new base
+    void SetDeltaCompactionThreshold(uint32_t recordCount) { m_deltaCompactionThreshold = recordCount; }
+    
+    // Delta records go to a write-ahead journal next to the base save. When disabled,
+    // every incremental save writes a full base instead.
+    void SetJournalEnabled(bool enabled) { m_journalEnabled = enabled; }
+    
+    // Journal appends are fsynced in batches of this many records, and whenever the
+    // background save queue drains. FlushJournal() forces outstanding records to disk.
+    void SetJournalSyncBatchSize(uint32_t recordCount) { m_journal.SetSyncBatchSize(recordCount); }
+    bool FlushJournal() { return m_journal.Sync(); }
+    
+    // Save menu support. Binary saves start with a fixed-size SaveSlotInfo header, so
+    // slots can be listed without loading them. The thumbnail (any encoded image) is
+    // stored in every binary save made after it is set.
+    std::vector<SaveSlotInfo> ListSaveSlots(const std::string& directory, bool parallel = true) const { return ScanSaveSlots(directory, parallel); }
+    void SetSaveThumbnail(std::vector<uint8_t> image) { m_thumbnail = std::move(image); }
+    
+    // Save slots kept together in one log-structured store file (see SaveStore). Slot
+    // saves go through the background save thread like SaveGameAsync, write only the
+    // pieces of data no slot in the store holds yet, and compact the store from the
+    // save thread once enough of it is dead.
+    bool OpenSaveStore(const std::string& filename) { return m_store.Open(filename); }
+    bool SaveGameToSlot(const std::string& slot);
+    std::shared_future<bool> SaveGameToSlotAsync(const std::string& slot);
+    bool LoadGameFromSlot(const std::string& slot);
+    bool DeleteSaveSlot(const std::string& slot);
+    std::vector<SaveSlotInfo> ListStoreSlots() const { return m_store.ListSlots(); }
+    void SetStoreCompactionThreshold(double deadRatio, uint64_t minFileSize) { m_store.SetCompactionThreshold(deadRatio, minFileSize); }
+    
+    // Built-in autosaves, off until enabled in the settings (see AutosaveScheduler).
+    // Day and hour changes, quest completions and the real-time interval request them;
+    // Update() starts one background save for all pending requests on a quiet frame.
+    // Autosaves rotate through slots of the save store when one is open, and through
+    // binary save files otherwise.
+    void SetAutosaveSettings(const AutosaveSettings& settings) { m_autosave.SetSettings(settings); }
+    const AutosaveSettings& GetAutosaveSettings() const { return m_autosave.GetSettings(); }
+    void RequestAutosave() { m_autosave.Request(AutosaveScheduler::Manual); }
+    
+    // Real time played, accumulated in Update() and restored from binary saves
+    double GetPlaytime() const { return m_playtime; }
+    void SetPlaytime(double seconds) { m_playtime = seconds; }
+    
+    // Binary saves encode each system on its own worker thread, and loads verify and
+    // decode chunks in parallel, one dependency level at a time
+    void SetParallelSerialization(bool enabled) { m_parallelSerialization = enabled; }
+    
     // System registration for save/load
     void RegisterSerializableSystem(const std::string& systemName);
+    std::vector<std::string> GetSerializableSystems() const; // Sorted by name
+    
+    // The system a save chunk with this name belongs to, or nullptr
+    RPGSystem* GetSystemByName(const std::string& systemName);
+    
+    // Schema migration. Chunks carry the schema version of the system that wrote them,
+    // and a chunk older than its system is upgraded one version at a time as it is
+    // loaded, so systems only ever read their current layout. Only chunks that are
+    // actually loaded get upgraded. After loading an upgraded chunk, the next
+    // incremental save writes a new base instead of a delta, which puts the upgraded
+    // data on disk. An upgrade reads a payload of 'fromVersion' and writes the same state
+    // in the layout of 'fromVersion + 1'; like Deserialize it may run on a worker thread.
+    // 'deltaUpgrade' does the same for SerializeDelta payloads; without it, replaying a
+    // journal stops at the first delta record holding such a chunk.
+    using ChunkUpgrade = std::function<bool(BinaryReader& reader, BinaryWriter& writer)>;
+    void RegisterChunkUpgrade(const std::string& systemName, uint32_t fromVersion, ChunkUpgrade upgrade,
+        ChunkUpgrade deltaUpgrade = nullptr);
+    
+    // Runs the registered upgrades on a chunk payload of 'fromVersion' until it reaches
+    // 'toVersion'. 'strings' decodes the original payload; the upgraded one holds its
+    // strings inline. Returns false if an upgrade is missing or fails.
+    bool UpgradeChunk(const std::string& systemName, uint32_t fromVersion, uint32_t toVersion, bool delta,
+        const uint8_t* data, size_t size, const StringTable* strings, std::vector<uint8_t>& upgraded) const;
+    
+    // Text saves store the version of their key layout. Older ones are rewritten key by
+    // key from version to version until they reach the current layout, before any
+    // system reads them; saves newer than this build are rejected.
+    using TextUpgrade = std::function<void(const TextReader& reader, TextWriter& writer)>;
+    void RegisterTextUpgrade(const std::string& fromVersion, const std::string& toVersion, TextUpgrade upgrade);
     
     // Default serialization methods
     virtual void Serialize(BinaryWriter& writer) const override;
@@ -44,7 +176,7 @@ public:
         static SaveLoadSystem* instance = new SaveLoadSystem();
         return instance;
     }
-
+    
     // Cleanup method
     static void Destroy() {
         static SaveLoadSystem* instance = GetInstance();
@@ -57,15 +189,191 @@ public:
 private:
     SaveLoadSystem() {};
     
+    // Delta records appended next to a base save, tagged with the base's generation
+    static constexpr uint32_t DeltaRecordMagic = 0x4C444E4C; // "LNDL"
+    
+    // Key layout of the text format written by this build
+    static constexpr const char* TextSaveVersion = "1.1.0";
+    
+    enum class SnapshotKind {
+        Full,  // Standalone save
+        Base,  // Full save that starts a new delta chain
+        Delta, // Changes appended to an existing base
+        Slot   // Slot in the save store, named by 'filename'
+    };
+    
+    // In-memory copy of everything a save file needs, captured on the game thread
+    using SnapshotChunk = SaveStoreChunk;
+    using FrozenChunk = std::function<void(BinaryWriter&)>;
+    
+    struct SaveSnapshot {
+        std::string filename;
+        SerializationFormat format = SerializationFormat::Binary;
+        SnapshotKind kind = SnapshotKind::Full;
+        uint32_t generation = 0;           // Base generation, shared by its delta records
+        uint32_t sequence = 0;             // Delta record index within the generation
+        std::vector<SnapshotChunk> chunks; // Binary format
+        
+        // Frozen system state (from SnapshotState) per chunk, serialized into the chunk
+        // by CompleteSnapshot on the save thread. Empty for chunks captured directly.
+        std::vector<FrozenChunk> frozenChunks;
+        std::unique_ptr<StringTableBuilder> strings; // Pooled strings, encoded into chunk 0
+        int64_t stringBytesSaved = 0;
+        
+        SaveSlotInfo slotInfo;             // Binary format header
+        std::vector<uint8_t> thumbnail;    // Binary format
+        TextWriter text;                   // Text format
+        JsonWriter json;                   // JSON format
+    };
+    
+    struct SaveJob {
+        std::unique_ptr<SaveSnapshot> snapshot;
+        std::shared_ptr<std::promise<bool>> promise;
+        std::shared_future<bool> future;
+    };
+    
+    // A verified chunk inside a loaded save file
+    struct SaveChunk {
+        std::string systemName;
+        uint32_t size = 0;
+        uint32_t checksum = 0;
+        uint32_t schemaVersion = 1;
+        const uint8_t* data = nullptr;
+    };
+    
+    // Delta records read from a journal, each a list of chunks pointing into 'data'
+    struct DeltaJournal {
+        std::string filename;
+        std::vector<uint8_t> data;
+        std::vector<std::vector<SaveChunk>> records;
+    };
+    
+    // Where a chunk sits in a save file, found without reading its payload
+    struct ChunkLocation {
+        std::string systemName;
+        uint32_t size = 0;
+        uint32_t checksum = 0;
+        uint32_t schemaVersion = 1;
+        long offset = 0;
+    };
+    
+    // A deferred chunk decoded by the load thread, waiting to be applied
+    struct DecodedChunk {
+        std::string systemName;
+        RPGSystem* system = nullptr;
+        bool success = false;
+        bool upgraded = false;       // From an older schema; 'data' then holds inline strings
+        std::function<void()> apply; // From DecodeDeferred
+        std::vector<uint8_t> data;   // Deserialized on the game thread if there is no 'apply'
+    };
+    
+    struct ChunkUpgradeStep {
+        ChunkUpgrade upgrade;
+        ChunkUpgrade deltaUpgrade;
+    };
+    
     // Track which systems need serialization
     std::unordered_set<std::string> m_serializableSystems;
     
-    // Helper to get the correct system pointer based on name
-    RPGSystem* GetSystemByName(const std::string& systemName);
+    // Registered migrations, by system and schema version / by text version
+    std::map<std::pair<std::string, uint32_t>, ChunkUpgradeStep> m_chunkUpgrades;
+    std::unordered_map<std::string, std::pair<std::string, TextUpgrade>> m_textUpgrades;
+    
+    // Rewrites a loaded text save of 'version' to TextSaveVersion
+    bool UpgradeText(TextReader& reader, std::string version) const;
     
     // Helper functions for file extension management
     std::string GetExtensionForFormat(SerializationFormat format) const;
+    const char* GetFormatName(SerializationFormat format) const;
     SerializationFormat GetFormatFromFilename(const std::string& filename) const;
     std::string EnsureCorrectExtension(const std::string& filename, SerializationFormat format) const;
+    
+    // Two-phase save helpers
+    std::unique_ptr<SaveSnapshot> CaptureSnapshot(const std::string& saveFilename, SerializationFormat format);
+    std::unique_ptr<SaveSnapshot> CaptureIncrementalSnapshot(const std::string& saveFilename);
+    std::unique_ptr<SaveSnapshot> CaptureSlotSnapshot(const std::string& slot);
+    void CompleteSnapshot(SaveSnapshot& snapshot);
+    bool WriteSnapshot(SaveSnapshot& snapshot);
+    bool WriteDeltaRecord(const SaveSnapshot& snapshot);
+    std::shared_future<bool> QueueSnapshot(std::unique_ptr<SaveSnapshot> snapshot);
+    
+    // Delta chain helpers
+    std::string GetDeltaFilename(const std::string& saveFilename) const;
+    uint32_t ReplayDeltaRecords(const std::string& saveFilename, uint32_t generation, uint32_t formatVersion);
+    
+    // Reads the records of 'generation' from a save's journal, verified and in order, up to
+    // the first torn or missing one. Applying returns how many records were applied to
+    // 'systems' (all if null), up to the first that can't be upgraded or decoded.
+    void ReadDeltaRecords(const std::string& saveFilename, uint32_t generation, uint32_t formatVersion, DeltaJournal& journal);
+    uint32_t ApplyDeltaRecords(const DeltaJournal& journal, const std::unordered_set<std::string>* systems = nullptr);
+    uint32_t NewGeneration();
+    
+    // State of the delta chain currently being appended to
+    std::string m_incrementalFile;
+    uint32_t m_incrementalGeneration = 0;
+    uint32_t m_deltaRecordCount = 0;
+    uint32_t m_deltaCompactionThreshold = 16;
+    uint32_t m_lastGeneration = 0;
+    bool m_journalEnabled = true;
+    SaveJournal m_journal;
+    
+    // Set when the loaded game came from chunks of an older format or schema, so the next
+    // incremental save writes a current base rather than extending the old chain
+    bool m_needsNewBase = false;
+    
+    bool m_parallelSerialization = true;
+    
+    SaveStore m_store;
+    
+    AutosaveScheduler m_autosave;
+    bool m_autosaveSubscribed = false;
+    void StartAutosave(uint32_t reasons);
+    
+    // Save slot metadata
+    std::vector<uint8_t> m_thumbnail;
+    double m_playtime = 0.0;
+    
+    // Background save worker
+    void SaveThreadMain();
+    void StopSaveThread();
+    void PublishCompletedSaves();
+    
+    std::thread m_saveThread;
+    mutable std::mutex m_saveMutex;
+    std::condition_variable m_saveCondition;
+    std::condition_variable m_saveIdleCondition;
+    std::deque<SaveJob> m_pendingSaves;
+    std::vector<std::pair<std::string, bool>> m_completedSaves;
+    bool m_saveInFlight = false;
+    bool m_stopSaveThread = false;
+    
+    // Partial load helpers
+    bool ReadChunkDirectory(std::FILE* file, const SaveSlotInfo& info, std::vector<ChunkLocation>& chunks) const;
+    bool ReadChunkPayload(std::FILE* file, const ChunkLocation& chunk, std::vector<uint8_t>& data) const;
+    void LoadThreadMain(std::string filename, std::vector<ChunkLocation> chunks, std::vector<RPGSystem*> systems);
+    void ApplyDeferredLoads();
+    void CancelDeferredLoads();
+    
+    // Deferred systems of the last partial load
+    std::thread m_loadThread;
+    std::mutex m_loadMutex;
+    std::condition_variable m_loadCondition;
+    std::deque<DecodedChunk> m_decodedChunks;
+    std::atomic<bool> m_cancelLoad{false};
+    size_t m_deferredRemaining = 0;              // Not yet applied, game thread only
+    std::shared_ptr<const StringTable> m_deferredStrings;
+    std::string m_deferredFilename;
+    DeltaJournal m_deferredDeltas;               // Records the deferred systems still need
+    
+    // Chunk helpers
+    void CaptureSlotInfo(SaveSnapshot& snapshot);
+    int64_t SerializeChunks(const std::vector<std::string>& systemNames, bool delta, std::vector<SnapshotChunk>& chunks,
+        StringTableBuilder* strings = nullptr, std::vector<FrozenChunk>* frozen = nullptr);
+    bool DeserializeChunks(const std::vector<SaveChunk>& chunks, const StringTable* strings = nullptr);
+    void WriteChunk(BinaryWriter& writer, const SnapshotChunk& chunk) const;
+    bool ReadChunks(BinaryReader& reader, uint32_t systemCount, uint32_t formatVersion, std::vector<SaveChunk>& chunks) const;
+    bool LoadLegacyBinary(BinaryReader& reader);
+    bool LoadJson(const std::string& filename);
+    bool ReadFileContents(const std::string& filename, std::vector<uint8_t>& data) const;
 };
 // ^ SaveLoadSystem.h
\ No newline at end of file
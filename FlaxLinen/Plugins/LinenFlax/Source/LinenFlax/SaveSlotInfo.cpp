@@ -0,0 +1,211 @@
+// v SaveSlotInfo.cpp
+#include "SaveSlotInfo.h"
+#include "Checksum.h"
+#include "Engine/Core/Log.h"
+#include <filesystem>
+#include <system_error>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <cstdio>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// The header checksum is stored at this offset and computed with the field zeroed
+constexpr size_t HeaderChecksumOffset = 12;
+
+// Below this many files the thread start-up costs more than it saves
+constexpr size_t MinFilesPerThread = 32;
+
+size_t ReadFilePrefix(const std::string& filename, uint8_t* buffer, size_t size) {
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file) {
+        return 0;
+    }
+    size_t read = std::fread(buffer, 1, size, file);
+    std::fclose(file);
+    return read;
+}
+
+uint32_t ComputeHeaderChecksum(const uint8_t* header, size_t size) {
+    static const uint8_t zero[sizeof(uint32_t)] = {};
+    uint32_t crc = ComputeCrc32c(header, HeaderChecksumOffset);
+    crc = ComputeCrc32c(zero, sizeof(zero), crc);
+    return ComputeCrc32c(header + HeaderChecksumOffset + sizeof(uint32_t),
+        size - HeaderChecksumOffset - sizeof(uint32_t), crc);
+}
+
+} // namespace
+
+void WriteSaveSlotHeader(BinaryWriter& writer, const SaveSlotInfo& info) {
+    BinaryWriter header;
+    header.Write(SaveFileMagic);
+    header.Write(SaveFormatVersion);
+    header.Write(SaveSlotHeaderSize);
+    header.Write(0u); // Checksum, filled in below
+    header.Write(info.generation);
+    header.Write(info.chunkCount);
+    header.WriteValue(info.timestamp);
+    header.Write(info.gameMinute);
+    header.Write(info.gameHour);
+    header.Write(info.gameDay);
+    header.Write(info.gameMonth);
+    header.Write(info.gameYear);
+    header.Write(info.characterLevel);
+    header.Write(info.playtimeSeconds);
+    header.Write(info.thumbnailOffset);
+    header.Write(info.thumbnailSize);
+    for (uint32_t size : info.chunkSizes) {
+        header.Write(size);
+    }
+    
+    // Reserved for later fields
+    std::vector<uint8_t> bytes = header.GetBuffer();
+    bytes.resize(SaveSlotHeaderSize, 0);
+    
+    uint32_t checksum = LittleEndian(ComputeHeaderChecksum(bytes.data(), bytes.size()));
+    std::memcpy(&bytes[HeaderChecksumOffset], &checksum, sizeof(checksum));
+    writer.Write(bytes.data(), bytes.size());
+}
+
+bool ReadSaveSlotHeader(const uint8_t* data, size_t size, SaveSlotInfo& info) {
+    BinaryReader reader(data, size);
+    
+    uint32_t magic = 0;
+    reader.Read(magic);
+    reader.Read(info.formatVersion);
+    if (reader.HasFailed() || magic != SaveFileMagic) {
+        return false;
+    }
+    
+    info.hasMetadata = false;
+    if (info.formatVersion < 4) {
+        // Format 2 and 3: version, [generation,] chunk count
+        if (info.formatVersion >= 3) {
+            reader.Read(info.generation);
+        }
+        reader.Read(info.chunkCount);
+        info.headerSize = static_cast<uint32_t>(size - reader.GetRemaining());
+        return !reader.HasFailed();
+    }
+    
+    uint32_t checksum = 0;
+    reader.Read(info.headerSize);
+    reader.Read(checksum);
+    if (reader.HasFailed() || info.headerSize < SaveSlotHeaderSize || info.headerSize > size) {
+        return false;
+    }
+    if (ComputeHeaderChecksum(data, info.headerSize) != checksum) {
+        return false;
+    }
+    
+    reader.Read(info.generation);
+    reader.Read(info.chunkCount);
+    reader.ReadValue(info.timestamp);
+    reader.Read(info.gameMinute);
+    reader.Read(info.gameHour);
+    reader.Read(info.gameDay);
+    reader.Read(info.gameMonth);
+    reader.Read(info.gameYear);
+    reader.Read(info.characterLevel);
+    reader.Read(info.playtimeSeconds);
+    reader.Read(info.thumbnailOffset);
+    reader.Read(info.thumbnailSize);
+    for (uint32_t& chunkSize : info.chunkSizes) {
+        reader.Read(chunkSize);
+    }
+    
+    info.hasMetadata = !reader.HasFailed();
+    return info.hasMetadata;
+}
+
+bool ReadSaveSlotInfo(const std::string& filename, SaveSlotInfo& info) {
+    uint8_t header[SaveSlotHeaderSize];
+    size_t size = ReadFilePrefix(filename, header, sizeof(header));
+    if (!ReadSaveSlotHeader(header, size, info)) {
+        return false;
+    }
+    info.filename = filename;
+    return true;
+}
+
+bool ReadSaveThumbnail(const std::string& filename, std::vector<uint8_t>& image) {
+    image.clear();
+    
+    SaveSlotInfo info;
+    if (!ReadSaveSlotInfo(filename, info) || info.thumbnailOffset == 0 || info.thumbnailSize == 0) {
+        return false;
+    }
+    
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    image.resize(info.thumbnailSize);
+    bool read = std::fseek(file, static_cast<long>(info.thumbnailOffset), SEEK_SET) == 0 &&
+        std::fread(image.data(), 1, image.size(), file) == image.size();
+    std::fclose(file);
+    
+    if (!read) {
+        LOG(Warning, "Save file thumbnail is truncated: {0}", String(filename.c_str()));
+        image.clear();
+    }
+    return read;
+}
+
+std::vector<SaveSlotInfo> ScanSaveSlots(const std::string& directory, bool parallel) {
+    std::vector<std::string> filenames;
+    std::error_code error;
+    for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (it->path().extension() == ".bin" && it->is_regular_file(error)) {
+            filenames.push_back(it->path().string());
+        }
+    }
+    if (error) {
+        LOG(Warning, "Failed to list save directory: {0}", String(directory.c_str()));
+    }
+    
+    std::vector<SaveSlotInfo> slots(filenames.size());
+    std::vector<uint8_t> valid(filenames.size(), 0);
+    std::atomic<size_t> next{0};
+    auto scan = [&]() {
+        for (size_t i = next++; i < filenames.size(); i = next++) {
+            valid[i] = ReadSaveSlotInfo(filenames[i], slots[i]) ? 1 : 0;
+        }
+    };
+    
+    size_t threadCount = 1;
+    if (parallel) {
+        size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        threadCount = std::min(hardwareThreads, filenames.size() / MinFilesPerThread + 1);
+    }
+    
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back(scan);
+    }
+    scan();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    // Drop files that aren't saves, e.g. pre-chunk saves with no magic
+    size_t count = 0;
+    for (size_t i = 0; i < slots.size(); ++i) {
+        if (valid[i]) {
+            slots[count++] = std::move(slots[i]);
+        }
+    }
+    slots.resize(count);
+    
+    std::sort(slots.begin(), slots.end(), [](const SaveSlotInfo& a, const SaveSlotInfo& b) {
+        if (a.timestamp != b.timestamp) {
+            return a.timestamp > b.timestamp;
+        }
+        return a.filename < b.filename;
+    });
+    return slots;
+}
+// ^ SaveSlotInfo.cpp
\ No newline at end of file
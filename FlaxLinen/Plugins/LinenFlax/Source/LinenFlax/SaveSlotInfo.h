@@ -0,0 +1,72 @@
+// v SaveSlotInfo.h
+#pragma once
+
+#include "Serialization.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Binary save layout: slot header, then one checksummed chunk per system, then an
+// optional thumbnail image
+constexpr uint32_t SaveFileMagic = 0x56534E4C; // "LNSV"
+constexpr uint32_t SaveFormatVersion = 6;
+
+// From format 5 the first chunk holds every distinct string in the save, and the
+// system chunks refer to strings by index
+constexpr const char* StringTableChunkName = "StringTable";
+
+// From format 6 each chunk header also holds the schema version its payload was written
+// with (see LinenSystem::GetSchemaVersion). Chunks of older saves are schema 1.
+constexpr uint32_t FirstSchemaVersionedFormat = 6;
+
+// Size of the fixed header at the front of format 4 saves
+constexpr uint32_t SaveSlotHeaderSize = 160;
+
+// Everything a save menu needs about a slot. Stored in the fixed-size header of a
+// binary save, so listing saves never has to read or parse the system chunks.
+struct SaveSlotInfo {
+    static constexpr uint32_t MaxChunkSizes = 16;
+    
+    std::string filename;              // Filled in by the scanner, not stored in the header
+    uint32_t formatVersion = 0;
+    uint32_t headerSize = 0;
+    uint32_t generation = 0;
+    int64_t timestamp = 0;             // Seconds since the Unix epoch when the save was made
+    
+    // In-game date and character level at the time of the save
+    int32_t gameMinute = 0;
+    int32_t gameHour = 0;
+    int32_t gameDay = 0;
+    int32_t gameMonth = 0;
+    int32_t gameYear = 0;
+    int32_t characterLevel = 0;
+    
+    double playtimeSeconds = 0.0;
+    uint32_t thumbnailOffset = 0;      // Byte offset of the thumbnail image, 0 if there is none
+    uint32_t thumbnailSize = 0;
+    uint32_t chunkCount = 0;
+    uint32_t chunkSizes[MaxChunkSizes] = {}; // Payload sizes of the first chunks, in file order
+    
+    // False for saves written before format 4; only the version, generation and chunk
+    // count are known for those
+    bool hasMetadata = false;
+};
+
+// Writes exactly SaveSlotHeaderSize bytes, including the file magic and a header checksum
+void WriteSaveSlotHeader(BinaryWriter& writer, const SaveSlotInfo& info);
+
+// Decodes the header at the start of a save file. Also accepts the shorter headers of
+// format 2 and 3 saves. Returns false if the data is not a save or the header is corrupt.
+bool ReadSaveSlotHeader(const uint8_t* data, size_t size, SaveSlotInfo& info);
+
+// Reads only the header of a save file
+bool ReadSaveSlotInfo(const std::string& filename, SaveSlotInfo& info);
+
+// Reads the thumbnail stored in a save file, if it has one
+bool ReadSaveThumbnail(const std::string& filename, std::vector<uint8_t>& image);
+
+// Lists the binary saves in a directory, newest first. Only the headers are read,
+// spread over several threads when 'parallel' is set.
+std::vector<SaveSlotInfo> ScanSaveSlots(const std::string& directory, bool parallel = true);
+// ^ SaveSlotInfo.h
\ No newline at end of file
@@ -0,0 +1,690 @@
+// v SaveStore.cpp
+#include "SaveStore.h"
+#include "SaveFileIO.h"
+#include "Checksum.h"
+#include "Engine/Core/Log.h"
+#include <filesystem>
+#include <system_error>
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t StoreFileMagic = 0x53534E4C;   // "LNSS"
+constexpr uint32_t StoreFormatVersion = 2;
+constexpr uint32_t StoreRecordMagic = 0x52534E4C; // "LNSR"
+constexpr uint64_t StoreFileHeaderSize = sizeof(uint32_t) * 2;
+
+// Record header: magic, checksum, type, meta size, data size. The checksum covers the
+// header fields after it and the meta block; blob records carry their own data checksum.
+constexpr uint64_t RecordHeaderSize = sizeof(uint32_t) * 4 + sizeof(uint8_t);
+constexpr uint64_t RecordChecksumStart = sizeof(uint32_t) * 2;
+
+// Meta blocks hold names, piece hashes and a slot header; a manifest of 16 MB covers
+// about 10 GB of system data
+constexpr uint32_t MaxMetaSize = 16 * 1024 * 1024;
+
+// Content-defined pieces: a boundary falls where the rolling hash of the last 64 bytes
+// matches the mask, so an insertion only changes the pieces around it instead of
+// shifting every piece after it. About 10 KB per piece on average.
+constexpr size_t MinPieceSize = 2 * 1024;
+constexpr size_t MaxPieceSize = 64 * 1024;
+constexpr uint64_t PieceBoundaryMask = ((1ull << 13) - 1) << (64 - 13);
+
+// Copy buffer for compaction
+constexpr size_t CopyBlockSize = 1024 * 1024;
+
+constexpr std::array<uint64_t, 256> MakeGearTable() {
+    // splitmix64, so the table is the same everywhere and boundaries stay stable
+    std::array<uint64_t, 256> table = {};
+    uint64_t state = 0;
+    for (size_t i = 0; i < table.size(); ++i) {
+        state += 0x9E3779B97F4A7C15ull;
+        uint64_t value = state;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        table[i] = value ^ (value >> 31);
+    }
+    return table;
+}
+
+constexpr std::array<uint64_t, 256> GearTable = MakeGearTable();
+
+// Length of the piece starting at 'data'
+size_t FindPieceEnd(const uint8_t* data, size_t size) {
+    if (size <= MinPieceSize) {
+        return size;
+    }
+    size_t limit = std::min(size, MaxPieceSize);
+    uint64_t hash = 0;
+    for (size_t i = MinPieceSize; i < limit; ++i) {
+        hash = (hash << 1) + GearTable[data[i]];
+        if ((hash & PieceBoundaryMask) == 0) {
+            return i + 1;
+        }
+    }
+    return limit;
+}
+
+void WriteContentHash(BinaryWriter& out, const ContentHash& hash) {
+    out.WriteValue(hash.low);
+    out.WriteValue(hash.high);
+}
+
+void ReadContentHash(BinaryReader& in, ContentHash& hash) {
+    in.ReadValue(hash.low);
+    in.ReadValue(hash.high);
+}
+
+void EncodeRecord(BinaryWriter& out, uint8_t type, const std::vector<uint8_t>& meta, const uint8_t* data, uint32_t dataSize) {
+    BinaryWriter header;
+    header.Write(StoreRecordMagic);
+    header.Write(0u); // Checksum, filled in below
+    header.WriteValue(type);
+    header.Write(static_cast<uint32_t>(meta.size()));
+    header.Write(dataSize);
+    
+    std::vector<uint8_t> bytes = header.GetBuffer();
+    uint32_t checksum = ComputeCrc32c(bytes.data() + RecordChecksumStart, bytes.size() - RecordChecksumStart);
+    checksum = LittleEndian(ComputeCrc32c(meta.data(), meta.size(), checksum));
+    std::memcpy(&bytes[sizeof(uint32_t)], &checksum, sizeof(checksum));
+    
+    out.Write(bytes.data(), bytes.size());
+    if (!meta.empty()) {
+        out.Write(meta.data(), meta.size());
+    }
+    if (dataSize > 0) {
+        out.Write(data, dataSize);
+    }
+}
+
+bool CopyFileRange(std::FILE* from, uint64_t offset, uint64_t size, std::FILE* to, std::vector<uint8_t>& buffer) {
+    if (!SeekFile(from, static_cast<int64_t>(offset), SEEK_SET)) {
+        return false;
+    }
+    while (size > 0) {
+        size_t block = static_cast<size_t>(std::min<uint64_t>(size, buffer.size()));
+        if (std::fread(buffer.data(), 1, block, from) != block || std::fwrite(buffer.data(), 1, block, to) != block) {
+            return false;
+        }
+        size -= block;
+    }
+    return true;
+}
+
+} // namespace
+
+bool SaveStore::Open(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_file && m_filename == filename) {
+        return true;
+    }
+    
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    m_filename = filename;
+    if (!OpenLocked() || !ScanLocked()) {
+        if (m_file) {
+            std::fclose(m_file);
+            m_file = nullptr;
+        }
+        m_slots.clear();
+        m_blobs.clear();
+        return false;
+    }
+    
+    LOG(Info, "Opened save store {0}: {1} slots, {2} pieces, {3} of {4} bytes live", String(filename.c_str()),
+        static_cast<int>(m_slots.size()), static_cast<int>(m_blobs.size()), m_liveBytes, m_fileSize);
+    return true;
+}
+
+void SaveStore::Close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_file) {
+        SyncFile(m_file);
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    m_slots.clear();
+    m_blobs.clear();
+    m_fileSize = 0;
+    m_liveBytes = 0;
+}
+
+bool SaveStore::IsOpen() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_file != nullptr;
+}
+
+bool SaveStore::OpenLocked() {
+    m_file = std::fopen(m_filename.c_str(), "r+b");
+    if (!m_file) {
+        m_file = std::fopen(m_filename.c_str(), "w+b");
+    }
+    if (!m_file || !SeekFile(m_file, 0, SEEK_END)) {
+        LOG(Error, "Failed to open save store: {0}", String(m_filename.c_str()));
+        return false;
+    }
+    
+    if (TellFile(m_file) == 0) {
+        // New store: just the file header
+        BinaryWriter header;
+        header.Write(StoreFileMagic);
+        header.Write(StoreFormatVersion);
+        if (std::fwrite(header.GetBuffer().data(), 1, header.GetSize(), m_file) != header.GetSize() || !SyncFile(m_file)) {
+            LOG(Error, "Failed to create save store: {0}", String(m_filename.c_str()));
+            return false;
+        }
+        SyncDirectory(fs::path(m_filename).parent_path().string());
+    }
+    return true;
+}
+
+bool SaveStore::ScanLocked() {
+    m_slots.clear();
+    m_blobs.clear();
+    m_fileSize = 0;
+    m_liveBytes = 0;
+    
+    if (!SeekFile(m_file, 0, SEEK_END)) {
+        return false;
+    }
+    int64_t fileSize = TellFile(m_file);
+    uint8_t fileHeader[StoreFileHeaderSize];
+    if (fileSize < static_cast<int64_t>(StoreFileHeaderSize) || !ReadAtLocked(0, fileHeader, sizeof(fileHeader))) {
+        LOG(Error, "Save store header is truncated: {0}", String(m_filename.c_str()));
+        return false;
+    }
+    BinaryReader headerReader(fileHeader, sizeof(fileHeader));
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    headerReader.Read(magic);
+    headerReader.Read(version);
+    if (magic != StoreFileMagic || version != StoreFormatVersion) {
+        // Version 1 stores kept whole systems per slot; they are not converted
+        LOG(Error, "Not a supported save store: {0}", String(m_filename.c_str()));
+        return false;
+    }
+    
+    uint64_t end = static_cast<uint64_t>(fileSize);
+    uint64_t offset = StoreFileHeaderSize;
+    std::vector<uint8_t> meta;
+    while (offset < end) {
+        uint8_t header[RecordHeaderSize];
+        if (end - offset < RecordHeaderSize || !ReadAtLocked(offset, header, sizeof(header))) {
+            break;
+        }
+        BinaryReader reader(header, sizeof(header));
+        uint32_t recordMagic = 0;
+        uint32_t checksum = 0;
+        uint8_t type = 0;
+        uint32_t metaSize = 0;
+        uint32_t dataSize = 0;
+        reader.Read(recordMagic);
+        reader.Read(checksum);
+        reader.ReadValue(type);
+        reader.Read(metaSize);
+        reader.Read(dataSize);
+        if (recordMagic != StoreRecordMagic || metaSize > MaxMetaSize ||
+            end - offset - RecordHeaderSize < static_cast<uint64_t>(metaSize) + dataSize) {
+            break;
+        }
+        
+        meta.resize(metaSize);
+        if (metaSize > 0 && !ReadAtLocked(offset + RecordHeaderSize, meta.data(), metaSize)) {
+            break;
+        }
+        uint32_t computed = ComputeCrc32c(header + RecordChecksumStart, sizeof(header) - RecordChecksumStart);
+        if (ComputeCrc32c(meta.data(), meta.size(), computed) != checksum) {
+            break;
+        }
+        
+        RecordRef ref;
+        ref.offset = offset;
+        ref.length = RecordHeaderSize + metaSize + dataSize;
+        ref.dataOffset = offset + RecordHeaderSize + metaSize;
+        ref.dataSize = dataSize;
+        
+        BinaryReader metaReader(meta.data(), meta.size());
+        if (type == static_cast<uint8_t>(RecordType::Blob)) {
+            ContentHash hash;
+            ReadContentHash(metaReader, hash);
+            metaReader.Read(ref.dataChecksum);
+            if (!metaReader.HasFailed()) {
+                AddBlobLocked(hash, ref);
+            }
+        } else if (type == static_cast<uint8_t>(RecordType::Commit)) {
+            std::string slot;
+            SlotEntry entry;
+            entry.commit = ref;
+            uint32_t systemCount = 0;
+            metaReader.Read(slot);
+            metaReader.Read(systemCount);
+            bool complete = metaReader.CanHold(systemCount, sizeof(uint32_t) * 2);
+            for (uint32_t i = 0; i < systemCount && complete; ++i) {
+                SystemManifest system;
+                uint32_t pieceCount = 0;
+                metaReader.Read(system.systemName);
+                metaReader.Read(pieceCount);
+                complete = metaReader.CanHold(pieceCount, sizeof(uint64_t) * 2);
+                for (uint32_t piece = 0; piece < pieceCount && complete; ++piece) {
+                    ContentHash hash;
+                    ReadContentHash(metaReader, hash);
+                    complete = m_blobs.count(hash) != 0;
+                    system.pieces.push_back(hash);
+                }
+                complete = complete && !metaReader.HasFailed();
+                entry.systems.push_back(std::move(system));
+            }
+            
+            uint32_t headerSize = static_cast<uint32_t>(metaReader.GetRemaining());
+            complete = complete && ReadSaveSlotHeader(metaReader.GetPosition(), headerSize, entry.info);
+            if (complete && entry.info.formatVersion >= FirstSchemaVersionedFormat) {
+                // Schema versions follow the header, one per system
+                metaReader.Skip(entry.info.headerSize);
+                for (auto& system : entry.systems) {
+                    metaReader.Read(system.schemaVersion);
+                }
+                complete = !metaReader.HasFailed();
+            }
+            if (!complete) {
+                LOG(Warning, "Skipping unreadable commit of save slot {0}", String(slot.c_str()));
+            } else {
+                entry.info.filename = slot;
+                ReplaceSlotLocked(slot, std::move(entry));
+            }
+        } else if (type == static_cast<uint8_t>(RecordType::Delete)) {
+            std::string slot;
+            metaReader.Read(slot);
+            RemoveSlotLocked(slot);
+        } else {
+            break;
+        }
+        offset += ref.length;
+    }
+    
+    // Blobs whose commit never made it to disk
+    for (auto it = m_blobs.begin(); it != m_blobs.end();) {
+        if (it->second.refCount == 0) {
+            m_liveBytes -= it->second.record.length;
+            it = m_blobs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    
+    // A torn append at the end; cut it off so new records follow the good ones
+    if (offset < end) {
+        LOG(Warning, "Discarding {0} bytes of incomplete records at the end of {1}",
+            end - offset, String(m_filename.c_str()));
+        std::fclose(m_file);
+        m_file = nullptr;
+        std::error_code error;
+        fs::resize_file(m_filename, offset, error);
+        if (error || !OpenLocked()) {
+            return false;
+        }
+    }
+    
+    m_fileSize = offset;
+    return true;
+}
+
+bool SaveStore::WriteSlot(const std::string& slot, const SaveSlotInfo& info, const std::vector<SaveStoreChunk>& chunks) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_file) {
+        return false;
+    }
+    
+    // Indexed as it will read back from the commit record
+    SlotEntry entry;
+    entry.info = info;
+    entry.info.filename = slot;
+    entry.info.formatVersion = SaveFormatVersion;
+    entry.info.headerSize = SaveSlotHeaderSize;
+    entry.info.hasMetadata = true;
+    
+    // Pieces this write adds, also deduplicated among themselves
+    std::vector<std::pair<ContentHash, RecordRef>> added;
+    std::unordered_map<ContentHash, size_t, ContentHashHasher> addedIndex;
+    BinaryWriter records;
+    size_t pieceCount = 0;
+    for (const auto& chunk : chunks) {
+        SystemManifest system;
+        system.systemName = chunk.systemName;
+        system.schemaVersion = chunk.schemaVersion;
+        
+        const uint8_t* data = chunk.data.data();
+        size_t remaining = chunk.data.size();
+        while (remaining > 0) {
+            size_t pieceSize = FindPieceEnd(data, remaining);
+            ContentHash hash = ComputeContentHash(data, pieceSize);
+            system.pieces.push_back(hash);
+            pieceCount++;
+            
+            if (m_blobs.count(hash) == 0 && addedIndex.count(hash) == 0) {
+                RecordRef ref;
+                ref.offset = m_fileSize + records.GetSize();
+                ref.dataSize = static_cast<uint32_t>(pieceSize);
+                ref.dataChecksum = ComputeCrc32c(data, pieceSize);
+                
+                BinaryWriter meta;
+                WriteContentHash(meta, hash);
+                meta.Write(ref.dataChecksum);
+                EncodeRecord(records, static_cast<uint8_t>(RecordType::Blob), meta.GetBuffer(), data, ref.dataSize);
+                
+                ref.length = m_fileSize + records.GetSize() - ref.offset;
+                ref.dataOffset = m_fileSize + records.GetSize() - pieceSize;
+                addedIndex.emplace(hash, added.size());
+                added.emplace_back(hash, ref);
+            }
+            data += pieceSize;
+            remaining -= pieceSize;
+        }
+        entry.systems.push_back(std::move(system));
+    }
+    
+    BinaryWriter meta;
+    meta.Write(slot);
+    meta.Write(static_cast<uint32_t>(entry.systems.size()));
+    for (const auto& system : entry.systems) {
+        meta.Write(system.systemName);
+        meta.Write(static_cast<uint32_t>(system.pieces.size()));
+        for (const auto& hash : system.pieces) {
+            WriteContentHash(meta, hash);
+        }
+    }
+    WriteSaveSlotHeader(meta, entry.info);
+    for (const auto& system : entry.systems) {
+        meta.Write(system.schemaVersion);
+    }
+    if (meta.GetSize() > MaxMetaSize) {
+        LOG(Error, "Save slot {0} is too large for the save store", String(slot.c_str()));
+        return false;
+    }
+    entry.commit.offset = m_fileSize + records.GetSize();
+    EncodeRecord(records, static_cast<uint8_t>(RecordType::Commit), meta.GetBuffer(), nullptr, 0);
+    entry.commit.length = m_fileSize + records.GetSize() - entry.commit.offset;
+    
+    if (!AppendLocked(records.GetBuffer())) {
+        LOG(Error, "Failed to write save slot {0} to {1}", String(slot.c_str()), String(m_filename.c_str()));
+        return false;
+    }
+    
+    for (const auto& blob : added) {
+        AddBlobLocked(blob.first, blob.second);
+    }
+    ReplaceSlotLocked(slot, std::move(entry));
+    
+    LOG(Info, "Saved slot {0}: {1} of {2} pieces written, {3} bytes", String(slot.c_str()),
+        static_cast<int>(added.size()), static_cast<int>(pieceCount), static_cast<int>(records.GetSize()));
+    return true;
+}
+
+bool SaveStore::ReadSlot(const std::string& slot, std::vector<SaveStoreChunk>& chunks, SaveSlotInfo* info) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    chunks.clear();
+    
+    auto it = m_slots.find(slot);
+    if (!m_file || it == m_slots.end()) {
+        return false;
+    }
+    
+    chunks.resize(it->second.systems.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const auto& system = it->second.systems[i];
+        chunks[i].systemName = system.systemName;
+        chunks[i].schemaVersion = system.schemaVersion;
+        
+        // Every piece of a live slot is in the index
+        size_t size = 0;
+        for (const auto& hash : system.pieces) {
+            size += m_blobs.at(hash).record.dataSize;
+        }
+        chunks[i].data.resize(size);
+        
+        uint8_t* out = chunks[i].data.data();
+        for (const auto& hash : system.pieces) {
+            const RecordRef& piece = m_blobs.at(hash).record;
+            if (!ReadAtLocked(piece.dataOffset, out, piece.dataSize) ||
+                ComputeCrc32c(out, piece.dataSize) != piece.dataChecksum) {
+                LOG(Error, "Checksum mismatch in save slot {0}, system {1}", String(slot.c_str()), String(system.systemName.c_str()));
+                chunks.clear();
+                return false;
+            }
+            out += piece.dataSize;
+        }
+    }
+    
+    if (info) {
+        *info = it->second.info;
+    }
+    return true;
+}
+
+bool SaveStore::DeleteSlot(const std::string& slot) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_slots.find(slot);
+    if (!m_file || it == m_slots.end()) {
+        return false;
+    }
+    
+    BinaryWriter meta;
+    meta.Write(slot);
+    BinaryWriter record;
+    EncodeRecord(record, static_cast<uint8_t>(RecordType::Delete), meta.GetBuffer(), nullptr, 0);
+    if (!AppendLocked(record.GetBuffer())) {
+        LOG(Error, "Failed to delete save slot {0} from {1}", String(slot.c_str()), String(m_filename.c_str()));
+        return false;
+    }
+    
+    RemoveSlotLocked(slot);
+    return true;
+}
+
+bool SaveStore::HasSlot(const std::string& slot) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slots.count(slot) != 0;
+}
+
+std::vector<SaveSlotInfo> SaveStore::ListSlots() const {
+    std::vector<SaveSlotInfo> slots;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        slots.reserve(m_slots.size());
+        for (const auto& slot : m_slots) {
+            slots.push_back(slot.second.info);
+        }
+    }
+    
+    std::sort(slots.begin(), slots.end(), [](const SaveSlotInfo& a, const SaveSlotInfo& b) {
+        if (a.timestamp != b.timestamp) {
+            return a.timestamp > b.timestamp;
+        }
+        return a.filename < b.filename;
+    });
+    return slots;
+}
+
+void SaveStore::SetCompactionThreshold(double deadRatio, uint64_t minFileSize) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_compactionRatio = deadRatio;
+    m_compactionMinSize = minFileSize;
+}
+
+bool SaveStore::NeedsCompaction() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_file || m_compacting || m_fileSize < m_compactionMinSize) {
+        return false;
+    }
+    uint64_t deadBytes = m_fileSize - StoreFileHeaderSize - m_liveBytes;
+    return static_cast<double>(deadBytes) > m_compactionRatio * static_cast<double>(m_fileSize);
+}
+
+bool SaveStore::Compact() {
+    // Live records as of now, in file order
+    std::vector<std::pair<uint64_t, uint64_t>> ranges;
+    uint64_t snapshotEnd = 0;
+    uint64_t sizeBefore = 0;
+    std::string filename;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_file || m_compacting) {
+            return false;
+        }
+        m_compacting = true;
+        std::fflush(m_file);
+        // File order keeps every blob ahead of the commits that refer to it
+        for (const auto& blob : m_blobs) {
+            ranges.emplace_back(blob.second.record.offset, blob.second.record.length);
+        }
+        for (const auto& slot : m_slots) {
+            ranges.emplace_back(slot.second.commit.offset, slot.second.commit.length);
+        }
+        snapshotEnd = m_fileSize;
+        sizeBefore = m_fileSize;
+        filename = m_filename;
+    }
+    std::sort(ranges.begin(), ranges.end());
+    
+    // Copying happens without the lock; slots written meanwhile are appended past
+    // 'snapshotEnd' and copied over below
+    std::string tempFilename = filename + ".compact";
+    std::FILE* source = std::fopen(filename.c_str(), "rb");
+    std::FILE* target = std::fopen(tempFilename.c_str(), "wb");
+    std::vector<uint8_t> buffer(CopyBlockSize);
+    bool copied = source && target;
+    if (copied) {
+        BinaryWriter header;
+        header.Write(StoreFileMagic);
+        header.Write(StoreFormatVersion);
+        copied = std::fwrite(header.GetBuffer().data(), 1, header.GetSize(), target) == header.GetSize();
+    }
+    for (size_t i = 0; i < ranges.size() && copied; ++i) {
+        copied = CopyFileRange(source, ranges[i].first, ranges[i].second, target, buffer);
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_compacting = false;
+    if (copied && m_fileSize > snapshotEnd) {
+        std::fflush(m_file);
+        copied = CopyFileRange(source, snapshotEnd, m_fileSize - snapshotEnd, target, buffer);
+    }
+    if (source) {
+        std::fclose(source);
+    }
+    bool synced = copied && SyncFile(target);
+    if (target) {
+        std::fclose(target);
+    }
+    
+    std::error_code error;
+    if (!synced || !m_file) {
+        LOG(Error, "Failed to compact save store: {0}", String(filename.c_str()));
+        fs::remove(tempFilename, error);
+        return false;
+    }
+    
+    // The old file stays in place until the rename, so a crash loses nothing
+    std::fclose(m_file);
+    m_file = nullptr;
+    fs::rename(tempFilename, filename, error);
+    if (error) {
+        LOG(Error, "Failed to replace save store {0}: {1}", String(filename.c_str()), String(error.message().c_str()));
+        fs::remove(tempFilename, error);
+    } else {
+        SyncDirectory(fs::path(filename).parent_path().string());
+    }
+    
+    if (!OpenLocked() || !ScanLocked()) {
+        if (m_file) {
+            std::fclose(m_file);
+            m_file = nullptr;
+        }
+        m_slots.clear();
+        m_blobs.clear();
+        return false;
+    }
+    
+    LOG(Info, "Compacted save store {0}: {1} -> {2} bytes", String(filename.c_str()), sizeBefore, m_fileSize);
+    return !error;
+}
+
+uint64_t SaveStore::GetFileSize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_fileSize;
+}
+
+uint64_t SaveStore::GetLiveBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_liveBytes;
+}
+
+size_t SaveStore::GetBlobCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_blobs.size();
+}
+
+bool SaveStore::AppendLocked(const std::vector<uint8_t>& records) {
+    if (!SeekFile(m_file, static_cast<int64_t>(m_fileSize), SEEK_SET) ||
+        std::fwrite(records.data(), 1, records.size(), m_file) != records.size() || !SyncFile(m_file)) {
+        // Whatever made it to disk is an incomplete tail, cut off on the next Open
+        return false;
+    }
+    m_fileSize += records.size();
+    return true;
+}
+
+bool SaveStore::ReadAtLocked(uint64_t offset, void* data, size_t size) const {
+    if (size == 0) {
+        return true;
+    }
+    return SeekFile(m_file, static_cast<int64_t>(offset), SEEK_SET) && std::fread(data, 1, size, m_file) == size;
+}
+
+void SaveStore::AddBlobLocked(const ContentHash& hash, const RecordRef& record) {
+    // The first copy stays; a later one is only there if the first had been dropped
+    if (m_blobs.emplace(hash, BlobEntry{ record, 0 }).second) {
+        m_liveBytes += record.length;
+    }
+}
+
+void SaveStore::ReplaceSlotLocked(const std::string& slot, SlotEntry&& entry) {
+    // References go up before the old slot lets go, so shared pieces survive
+    for (const auto& system : entry.systems) {
+        for (const auto& hash : system.pieces) {
+            m_blobs[hash].refCount++;
+        }
+    }
+    m_liveBytes += entry.commit.length;
+    RemoveSlotLocked(slot);
+    m_slots[slot] = std::move(entry);
+}
+
+void SaveStore::RemoveSlotLocked(const std::string& slot) {
+    auto it = m_slots.find(slot);
+    if (it == m_slots.end()) {
+        return;
+    }
+    ReleaseReferencesLocked(it->second);
+    m_liveBytes -= it->second.commit.length;
+    m_slots.erase(it);
+}
+
+void SaveStore::ReleaseReferencesLocked(const SlotEntry& entry) {
+    for (const auto& system : entry.systems) {
+        for (const auto& hash : system.pieces) {
+            auto blob = m_blobs.find(hash);
+            if (blob != m_blobs.end() && --blob->second.refCount == 0) {
+                m_liveBytes -= blob->second.record.length;
+                m_blobs.erase(blob);
+            }
+        }
+    }
+}
+// ^ SaveStore.cpp
@@ -0,0 +1,126 @@
+// v SaveStore.h
+#pragma once
+
+#include "SaveSlotInfo.h"
+#include "Checksum.h"
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include <mutex>
+#include <cstdio>
+#include <cstdint>
+
+// One system's data in a save slot
+struct SaveStoreChunk {
+    std::string systemName;
+    std::vector<uint8_t> data;
+    uint32_t schemaVersion = 1; // Of 'data', see LinenSystem::GetSchemaVersion
+};
+
+// Many save slots in one append-only file, so autosaves and quicksaves don't each need
+// a complete standalone file. System data is cut into content-defined pieces, and each
+// piece is stored once as a blob record keyed by its ContentHash, whichever slots use
+// it. Writing a slot appends the blobs the store doesn't have yet, then a commit record:
+// the slot's manifest of piece hashes per system, plus its SaveSlotInfo header and the
+// schema version of each system's data. Blobs
+// are reference counted by the manifests of live slots; once a slot is replaced or
+// deleted, blobs nothing else refers to are dead and compaction reclaims them.
+//
+// The index of slots and blobs lives in memory and is rebuilt on Open by reading only
+// the record headers. A torn record at the end of the file is cut off. Compact()
+// rewrites the live records to a new file while reads and writes carry on. Thread safe.
+class SaveStore {
+public:
+    SaveStore() = default;
+    ~SaveStore() { Close(); }
+    
+    SaveStore(const SaveStore&) = delete;
+    SaveStore& operator=(const SaveStore&) = delete;
+    
+    // Opens or creates the store file and indexes its records
+    bool Open(const std::string& filename);
+    void Close();
+    bool IsOpen() const;
+    
+    // Replaces the contents of a slot. Only pieces the store doesn't hold yet are written.
+    bool WriteSlot(const std::string& slot, const SaveSlotInfo& info, const std::vector<SaveStoreChunk>& chunks);
+    
+    // Reads every system of a slot, verifying the checksum of each piece
+    bool ReadSlot(const std::string& slot, std::vector<SaveStoreChunk>& chunks, SaveSlotInfo* info = nullptr) const;
+    
+    bool DeleteSlot(const std::string& slot);
+    bool HasSlot(const std::string& slot) const;
+    
+    // Committed slots, newest first, straight from the index. SaveSlotInfo::filename
+    // holds the slot name.
+    std::vector<SaveSlotInfo> ListSlots() const;
+    
+    // Compaction is due once superseded and deleted records take up more than
+    // 'deadRatio' of a store file of at least 'minFileSize' bytes
+    void SetCompactionThreshold(double deadRatio, uint64_t minFileSize);
+    bool NeedsCompaction() const;
+    bool Compact();
+    
+    uint64_t GetFileSize() const;
+    uint64_t GetLiveBytes() const;
+    size_t GetBlobCount() const;
+
+private:
+    enum class RecordType : uint8_t {
+        Blob = 1,   // One piece of system data
+        Commit = 2, // Slot manifest and header
+        Delete = 3  // Slot removal
+    };
+    
+    // Where a record sits in the file
+    struct RecordRef {
+        uint64_t offset = 0;      // Start of the record
+        uint64_t length = 0;      // Whole record, header included
+        uint64_t dataOffset = 0;  // Piece data of a blob record
+        uint32_t dataSize = 0;
+        uint32_t dataChecksum = 0;
+    };
+    
+    struct BlobEntry {
+        RecordRef record;
+        uint32_t refCount = 0;    // Piece references from live slot manifests
+    };
+    
+    struct SystemManifest {
+        std::string systemName;
+        std::vector<ContentHash> pieces;
+        uint32_t schemaVersion = 1;
+    };
+    
+    struct SlotEntry {
+        SaveSlotInfo info;
+        RecordRef commit;
+        std::vector<SystemManifest> systems;
+    };
+    
+    bool OpenLocked();
+    bool ScanLocked();
+    bool AppendLocked(const std::vector<uint8_t>& records);
+    bool ReadAtLocked(uint64_t offset, void* data, size_t size) const;
+    
+    // Index updates shared by writes and the scan on Open. Blobs start out unreferenced;
+    // one whose count drops back to zero leaves the index and its bytes become dead.
+    void AddBlobLocked(const ContentHash& hash, const RecordRef& record);
+    void ReplaceSlotLocked(const std::string& slot, SlotEntry&& entry);
+    void RemoveSlotLocked(const std::string& slot);
+    void ReleaseReferencesLocked(const SlotEntry& entry);
+    
+    mutable std::mutex m_mutex;
+    std::FILE* m_file = nullptr;
+    std::string m_filename;
+    uint64_t m_fileSize = 0;
+    uint64_t m_liveBytes = 0;
+    std::unordered_map<std::string, SlotEntry> m_slots;
+    std::unordered_map<ContentHash, BlobEntry, ContentHashHasher> m_blobs;
+    
+    double m_compactionRatio = 0.5;
+    uint64_t m_compactionMinSize = 4 * 1024 * 1024;
+    bool m_compacting = false;
+};
+// ^ SaveStore.h
@@ -7,28 +7,77 @@
 #include <fstream>
 #include <cstdint>
 #include <sstream>
+#include <cstring>
+#include <type_traits>
+#include <string_view>
+#include <charconv>
+#include <algorithm>
+#include "StringTable.h"
 
 enum class SerializationFormat {
     Binary,
-    Text
+    Text,
+    Json
 };
 
+// Binary saves are little-endian
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool IsBigEndianHost = true;
+#else
+constexpr bool IsBigEndianHost = false;
+#endif
+
+// Values stored as their raw bytes, so arrays of them can be copied as one block
+template<typename T>
+constexpr bool IsTriviallySerializable = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+// Converts between host and save byte order. Does nothing on little-endian hosts.
+template<typename T>
+inline T LittleEndian(T value) {
+    if constexpr (IsBigEndianHost && sizeof(T) > 1) {
+        uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        std::reverse(bytes, bytes + sizeof(T));
+        std::memcpy(&value, bytes, sizeof(T));
+    }
+    return value;
+}
+
 class BinaryWriter {
 public:
-    BinaryWriter(const std::string& filename) : m_stream(filename, std::ios::binary | std::ios::out) {}
-    ~BinaryWriter() { m_stream.close(); }
+    // File-backed writer, optionally appending to an existing file
+    BinaryWriter(const std::string& filename, bool append = false)
+        : m_stream(filename, std::ios::binary | std::ios::out | (append ? std::ios::app : std::ios::trunc))
+        , m_toFile(true) {}
+    
+    // Memory-backed writer, used to build chunks before they are checksummed
+    BinaryWriter() : m_toFile(false) {}
+    
+    ~BinaryWriter() { if (m_toFile) m_stream.close(); }
     
-    bool IsValid() const { return m_stream.good(); }
+    bool IsValid() const { return !m_toFile || m_stream.good(); }
     
     // Write primitives
-    void Write(bool value) { Write(&value, sizeof(bool)); }
-    void Write(int32_t value) { Write(&value, sizeof(int32_t)); }
-    void Write(uint32_t value) { Write(&value, sizeof(uint32_t)); }
-    void Write(float value) { Write(&value, sizeof(float)); }
-    void Write(double value) { Write(&value, sizeof(double)); }
+    void Write(bool value) { WriteValue(value); }
+    void Write(int32_t value) { WriteValue(value); }
+    void Write(uint32_t value) { WriteValue(value); }
+    void Write(float value) { WriteValue(value); }
+    void Write(double value) { WriteValue(value); }
     
-    // Write string
+    // Write any arithmetic or enum value
+    template<typename T>
+    void WriteValue(T value) {
+        static_assert(IsTriviallySerializable<T>, "WriteValue needs an arithmetic or enum type");
+        value = LittleEndian(value);
+        Write(&value, sizeof(T));
+    }
+    
+    // Write string, inline or as an index into the attached string table
     void Write(const std::string& value) {
+        if (m_strings) {
+            WriteVarint(InternString(value));
+            return;
+        }
         uint32_t length = static_cast<uint32_t>(value.length());
         Write(length);
         if (length > 0) {
@@ -36,63 +85,264 @@ public:
         }
     }
     
+    void WriteVarint(uint32_t value) {
+        uint8_t bytes[5];
+        Write(bytes, EncodeVarint(value, bytes));
+    }
+    
+    // Strings written after this go to 'table' and only their index is stored. The table
+    // must outlive the writer.
+    void SetStringTable(StringTableBuilder* table) { m_strings = table; }
+    
+    // Bytes the string table saved in this writer's output, before counting the table itself
+    int64_t GetStringBytesSaved() const { return m_stringBytesSaved; }
+    
     // Write raw data
     void Write(const void* data, size_t size) {
-        m_stream.write(static_cast<const char*>(data), size);
+        if (m_toFile) {
+            m_stream.write(static_cast<const char*>(data), size);
+        } else if (size > 0) {
+            size_t offset = m_buffer.size();
+            m_buffer.resize(offset + size);
+            std::memcpy(m_buffer.data() + offset, data, size);
+        }
     }
     
-    // Write container helpers
+    // Write container helpers. Arrays of arithmetic or enum values are copied as one
+    // block after the count.
     template<typename T>
     void WriteVector(const std::vector<T>& vec) {
         uint32_t size = static_cast<uint32_t>(vec.size());
         Write(size);
-        for (const auto& item : vec) {
-            Write(item);
+        if constexpr (IsTriviallySerializable<T> && !std::is_same_v<T, bool>) {
+            if constexpr (IsBigEndianHost) {
+                std::vector<T> swapped(vec.size());
+                std::transform(vec.begin(), vec.end(), swapped.begin(), LittleEndian<T>);
+                Write(swapped.data(), swapped.size() * sizeof(T));
+            } else if (size > 0) {
+                Write(vec.data(), vec.size() * sizeof(T));
+            }
+        } else {
+            // Strings and bools are encoded into one block as well
+            EncodeBlock(vec.size(), [&](std::vector<uint8_t>& out) {
+                for (const auto& item : vec) {
+                    Encode(out, static_cast<const T&>(item));
+                }
+            });
         }
     }
     
-    // Write map
-    template<typename K, typename V>
-    void WriteMap(const std::unordered_map<K, V>& map) {
+    // Write map (std::unordered_map or SnapshotMap). Entries are encoded into one block,
+    // directly into the buffer of a memory-backed writer or through one stream write for a file.
+    template<typename Map>
+    void WriteMap(const Map& map) {
         uint32_t size = static_cast<uint32_t>(map.size());
         Write(size);
-        for (const auto& pair : map) {
-            Write(pair.first);
-            Write(pair.second);
-        }
+        EncodeBlock(map.size(), [&](std::vector<uint8_t>& out) {
+            for (const auto& pair : map) {
+                Encode(out, pair.first);
+                Encode(out, pair.second);
+            }
+        });
     }
     
+    // Memory-backed writer contents
+    const std::vector<uint8_t>& GetBuffer() const { return m_buffer; }
+    size_t GetSize() const { return m_buffer.size(); }
+    
 private:
+    uint32_t InternString(const std::string& value) {
+        uint32_t index = m_strings->Intern(value);
+        m_stringBytesSaved += static_cast<int64_t>(sizeof(uint32_t) + value.size()) - static_cast<int64_t>(GetVarintSize(index));
+        return index;
+    }
+    
+    template<typename T>
+    void Encode(std::vector<uint8_t>& out, const T& value) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            if (m_strings) {
+                uint8_t index[5];
+                out.insert(out.end(), index, index + EncodeVarint(InternString(value), index));
+                return;
+            }
+            Encode(out, static_cast<uint32_t>(value.size()));
+            out.insert(out.end(), value.begin(), value.end());
+        } else {
+            static_assert(IsTriviallySerializable<T>, "Unsupported container element type");
+            T stored = LittleEndian(value);
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&stored);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+    }
+    
+    template<typename Func>
+    void EncodeBlock(size_t count, Func&& encode) {
+        if (count == 0) {
+            return;
+        }
+        if (!m_toFile) {
+            encode(m_buffer);
+            return;
+        }
+        m_staging.clear();
+        encode(m_staging);
+        Write(m_staging.data(), m_staging.size());
+    }
+    
     std::ofstream m_stream;
+    std::vector<uint8_t> m_buffer;
+    std::vector<uint8_t> m_staging; // Container blocks on their way to the file
+    bool m_toFile;
+    
+    StringTableBuilder* m_strings = nullptr;
+    int64_t m_stringBytesSaved = 0;
 };
 
+// Reads are bounded by the bytes left in the source: a length prefix larger than
+// what remains marks the reader as failed instead of allocating for it, so a
+// truncated or corrupt save can't trigger huge allocations.
 class BinaryReader {
 public:
-    BinaryReader(const std::string& filename) : m_stream(filename, std::ios::binary | std::ios::in) {}
-    ~BinaryReader() { m_stream.close(); }
+    // File-backed reader
+    BinaryReader(const std::string& filename) : m_stream(filename, std::ios::binary | std::ios::in), m_fromFile(true) {
+        if (m_stream.is_open()) {
+            m_stream.seekg(0, std::ios::end);
+            std::streamoff end = m_stream.tellg();
+            m_stream.seekg(0, std::ios::beg);
+            m_remaining = end > 0 ? static_cast<size_t>(end) : 0;
+        }
+    }
+    
+    // Memory-backed reader over a buffer owned by the caller
+    BinaryReader(const void* data, size_t size)
+        : m_fromFile(false)
+        , m_data(static_cast<const uint8_t*>(data))
+        , m_remaining(size) {}
     
-    bool IsValid() const { return m_stream.good() && !m_stream.eof(); }
+    ~BinaryReader() { if (m_fromFile) m_stream.close(); }
+    
+    bool IsValid() const {
+        if (m_failed) return false;
+        return !m_fromFile || (m_stream.good() && !m_stream.eof());
+    }
+    
+    // True once any read ran past the end of the data
+    bool HasFailed() const { return m_failed; }
+    size_t GetRemaining() const { return m_remaining; }
+    
+    // Current read position of a memory-backed reader
+    const uint8_t* GetPosition() const { return m_data; }
     
     // Read primitives
-    void Read(bool& value) { Read(&value, sizeof(bool)); }
-    void Read(int32_t& value) { Read(&value, sizeof(int32_t)); }
-    void Read(uint32_t& value) { Read(&value, sizeof(uint32_t)); }
-    void Read(float& value) { Read(&value, sizeof(float)); }
-    void Read(double& value) { Read(&value, sizeof(double)); }
+    void Read(bool& value) { ReadValue(value); }
+    void Read(int32_t& value) { ReadValue(value); }
+    void Read(uint32_t& value) { ReadValue(value); }
+    void Read(float& value) { ReadValue(value); }
+    void Read(double& value) { ReadValue(value); }
+    
+    // Read any arithmetic or enum value
+    template<typename T>
+    void ReadValue(T& value) {
+        static_assert(IsTriviallySerializable<T>, "ReadValue needs an arithmetic or enum type");
+        Read(&value, sizeof(T));
+        value = LittleEndian(value);
+    }
     
     // Read string
     void Read(std::string& value) {
+        if (m_strings) {
+            std::string_view stored;
+            if (ReadStringView(stored)) {
+                value.assign(stored.data(), stored.size());
+            } else {
+                value.clear();
+            }
+            return;
+        }
         uint32_t length = 0;
         Read(length);
+        if (length > m_remaining) {
+            Fail();
+            value.clear();
+            return;
+        }
         value.resize(length);
         if (length > 0) {
             Read(&value[0], length);
         }
     }
     
+    // Reads a string without copying it. The view points into the attached string table,
+    // or into the buffer of a memory-backed reader; file-backed readers without a table
+    // can't hand out views.
+    bool ReadStringView(std::string_view& value) {
+        if (m_strings) {
+            uint32_t index = 0;
+            ReadVarint(index);
+            if (m_failed || !m_strings->Get(index, value)) {
+                Fail();
+                return false;
+            }
+            return true;
+        }
+        uint32_t length = 0;
+        Read(length);
+        if (m_fromFile || length > m_remaining) {
+            Fail();
+            return false;
+        }
+        value = std::string_view(reinterpret_cast<const char*>(m_data), length);
+        Skip(length);
+        return true;
+    }
+    
+    void ReadVarint(uint32_t& value) {
+        value = 0;
+        for (uint32_t shift = 0; shift < 35; shift += 7) {
+            uint8_t byte = 0;
+            Read(&byte, 1);
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0 || m_failed) {
+                return;
+            }
+        }
+        Fail();
+    }
+    
+    // Strings are read as indices into 'table', which must outlive the reader
+    void SetStringTable(const StringTable* table) { m_strings = table; }
+    
+    // Smallest number of bytes one encoded string can take
+    size_t GetMinStringSize() const { return m_strings ? 1 : sizeof(uint32_t); }
+    
     // Read raw data
     void Read(void* data, size_t size) {
-        m_stream.read(static_cast<char*>(data), size);
+        if (size > m_remaining) {
+            Fail();
+            std::memset(data, 0, size);
+            return;
+        }
+        if (m_fromFile) {
+            m_stream.read(static_cast<char*>(data), size);
+        } else {
+            std::memcpy(data, m_data, size);
+            m_data += size;
+        }
+        m_remaining -= size;
+    }
+    
+    // Skip over data without reading it
+    void Skip(size_t size) {
+        if (size > m_remaining) {
+            Fail();
+            return;
+        }
+        if (m_fromFile) {
+            m_stream.seekg(static_cast<std::streamoff>(size), std::ios::cur);
+        } else {
+            m_data += size;
+        }
+        m_remaining -= size;
     }
     
     // Read container helpers
@@ -100,203 +350,526 @@ public:
     void ReadVector(std::vector<T>& vec) {
         uint32_t size = 0;
         Read(size);
+        vec.clear();
+        if (!CanHold(size, GetMinEncodedSize<T>())) {
+            Fail();
+            return;
+        }
         vec.resize(size);
-        for (uint32_t i = 0; i < size; ++i) {
-            Read(vec[i]);
+        if constexpr (IsTriviallySerializable<T> && !std::is_same_v<T, bool>) {
+            // CanHold has checked the whole block is present
+            if (size > 0) {
+                Read(vec.data(), size * sizeof(T));
+            }
+            if constexpr (IsBigEndianHost) {
+                std::transform(vec.begin(), vec.end(), vec.begin(), LittleEndian<T>);
+            }
+        } else {
+            for (uint32_t i = 0; i < size && !m_failed; ++i) {
+                T item{};
+                ReadElement(item);
+                vec[i] = item;
+            }
         }
     }
     
-    // Read map
-    template<typename K, typename V>
-    void ReadMap(std::unordered_map<K, V>& map) {
+    // Read map (std::unordered_map or SnapshotMap). Maps of fixed-size keys and values
+    // are read as one block.
+    template<typename Map>
+    void ReadMap(Map& map) {
+        using K = typename Map::key_type;
+        using V = typename Map::mapped_type;
         uint32_t size = 0;
         Read(size);
         map.clear();
-        K key;
-        V value;
-        for (uint32_t i = 0; i < size; ++i) {
-            Read(key);
-            Read(value);
-            map[key] = value;
+        if (!CanHold(size, GetMinEncodedSize<K>() + GetMinEncodedSize<V>())) {
+            Fail();
+            return;
+        }
+        map.reserve(size);
+        if constexpr (IsTriviallySerializable<K> && IsTriviallySerializable<V>) {
+            constexpr size_t entrySize = sizeof(K) + sizeof(V);
+            std::vector<uint8_t> block(size * entrySize);
+            Read(block.data(), block.size());
+            for (uint32_t i = 0; i < size && !m_failed; ++i) {
+                K key;
+                V value;
+                std::memcpy(&key, &block[i * entrySize], sizeof(K));
+                std::memcpy(&value, &block[i * entrySize + sizeof(K)], sizeof(V));
+                map[LittleEndian(key)] = LittleEndian(value);
+            }
+        } else {
+            K key{};
+            V value{};
+            for (uint32_t i = 0; i < size && !m_failed; ++i) {
+                ReadElement(key);
+                ReadElement(value);
+                map[key] = value;
+            }
         }
     }
     
+    // True if 'count' elements of at least 'minElementSize' bytes each can still
+    // be present. Use before reserving space for a length-prefixed collection.
+    bool CanHold(uint32_t count, size_t minElementSize) const {
+        return minElementSize == 0 || count <= m_remaining / minElementSize;
+    }
+    
+    // Marks the data as corrupt, e.g. when a decoded count can't be right
+    void Fail() {
+        m_failed = true;
+        m_remaining = 0;
+    }
+    
 private:
+    template<typename T>
+    void ReadElement(T& value) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            Read(value);
+        } else {
+            ReadValue(value);
+        }
+    }
+    
+    // Smallest number of bytes one encoded element can take
+    template<typename T>
+    size_t GetMinEncodedSize() const {
+        if constexpr (std::is_same<T, std::string>::value) {
+            return GetMinStringSize(); // Length prefix or table index
+        } else {
+            return sizeof(T);
+        }
+    }
+    
     std::ifstream m_stream;
+    bool m_fromFile;
+    const uint8_t* m_data = nullptr;
+    size_t m_remaining = 0;
+    bool m_failed = false;
+    const StringTable* m_strings = nullptr;
 };
 
-// Simple text-based serialization
+// Sorted view over a hash map, for output that doesn't depend on hash order
+template<typename Map>
+std::vector<const typename Map::value_type*> SortedByKey(const Map& map) {
+    std::vector<const typename Map::value_type*> entries;
+    entries.reserve(map.size());
+    for (const auto& entry : map) {
+        entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+    return entries;
+}
+
+// Simple text-based serialization. Lines are appended to one buffer in the order they
+// are written, so the same state always produces the same bytes. Numbers are formatted
+// with std::to_chars; floats use the shortest form that reads back to the same value.
 class TextWriter {
 public:
     TextWriter() {}
     
-    // Generic value writing template
-    template<typename T>
-    void Write(const std::string& key, const T& value) {
-        std::stringstream ss;
-        ss << value;
-        m_data[key] = ss.str();
-    }
+    void Reserve(size_t bytes) { m_buffer.reserve(bytes); }
     
-    // Specialization for strings (to avoid the to_string error)
-    void Write(const std::string& key, const std::string& value) {
-        m_data[key] = value;
+    template<typename T>
+    void Write(std::string_view key, const T& value) {
+        BeginLine(key);
+        AppendValue(value);
+        m_buffer.push_back('\n');
     }
     
-    // Specialization for string literals
-    void Write(const std::string& key, const char* value) {
-        m_data[key] = value;
+    // Writes "<name><index>=value" without building the key string
+    template<typename T>
+    void WriteIndexed(std::string_view name, size_t index, const T& value) {
+        m_buffer.append(m_prefix);
+        m_buffer.append(name);
+        AppendValue(index);
+        m_buffer.push_back('=');
+        AppendValue(value);
+        m_buffer.push_back('\n');
     }
     
     // Write vector as comma-separated values
     template<typename T>
-    void WriteVector(const std::string& key, const std::vector<T>& vec) {
-        std::stringstream ss;
+    void WriteVector(std::string_view key, const std::vector<T>& vec) {
+        BeginLine(key);
         for (size_t i = 0; i < vec.size(); ++i) {
-            ss << vec[i];
-            if (i < vec.size() - 1) {
-                ss << ",";
+            if (i > 0) {
+                m_buffer.push_back(',');
             }
+            AppendValue(vec[i]);
         }
-        m_data[key] = ss.str();
+        m_buffer.push_back('\n');
     }
     
-    // Write map as key-value pairs
+    // Write map as key-value pairs, sorted by key
     template<typename V>
-    void WriteMap(const std::string& key, const std::unordered_map<std::string, V>& map) {
-        std::stringstream ss;
-        size_t index = 0;
-        for (const auto& pair : map) {
-            ss << pair.first << "=" << pair.second;
-            if (index < map.size() - 1) {
-                ss << ";";
+    void WriteMap(std::string_view key, const std::unordered_map<std::string, V>& map) {
+        BeginLine(key);
+        bool first = true;
+        for (const auto* pair : SortedByKey(map)) {
+            if (!first) {
+                m_buffer.push_back(';');
             }
-            index++;
+            m_buffer.append(pair->first);
+            m_buffer.push_back('=');
+            AppendValue(pair->second);
+            first = false;
+        }
+        m_buffer.push_back('\n');
+    }
+    
+    // Prefixes every key written until the matching EndScope() with "<name><index>_",
+    // e.g. BeginScope("quest", 3) turns "id" into "quest3_id". Scopes nest.
+    void BeginScope(std::string_view name, size_t index) {
+        m_scopes.push_back(m_prefix.size());
+        m_prefix.append(name);
+        AppendNumber(m_prefix, index);
+        m_prefix.push_back('_');
+    }
+    
+    void EndScope() {
+        if (!m_scopes.empty()) {
+            m_prefix.resize(m_scopes.back());
+            m_scopes.pop_back();
         }
-        m_data[key] = ss.str();
     }
     
-    bool SaveToFile(const std::string& filename) {
-        std::ofstream file(filename);
+    // Everything written so far, one key=value per line
+    const std::string& GetBuffer() const { return m_buffer; }
+    
+    bool SaveToFile(const std::string& filename) const {
+        std::ofstream file(filename, std::ios::binary);
         if (!file.is_open()) {
             return false;
         }
         
-        // Write in a simple key=value format
-        for (const auto& pair : m_data) {
-            file << pair.first << "=" << pair.second << std::endl;
-        }
-        file.close();
-        return true;
+        file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        return file.good();
     }
     
 private:
-    std::unordered_map<std::string, std::string> m_data;
+    void BeginLine(std::string_view key) {
+        m_buffer.append(m_prefix);
+        m_buffer.append(key);
+        m_buffer.push_back('=');
+    }
+    
+    template<typename T>
+    static void AppendNumber(std::string& out, T value) {
+        char digits[64];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    }
+    
+    template<typename T>
+    void AppendValue(const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            m_buffer.push_back(value ? '1' : '0');
+        } else if constexpr (std::is_same_v<T, char>) {
+            m_buffer.push_back(value);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            AppendNumber(m_buffer, value);
+        } else if constexpr (std::is_enum_v<T>) {
+            AppendNumber(m_buffer, static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            m_buffer.append(std::string_view(value));
+        } else {
+            // Anything else falls back to its stream operator
+            std::ostringstream ss;
+            ss << value;
+            m_buffer.append(ss.str());
+        }
+    }
+    
+    std::string m_buffer;
+    std::string m_prefix;
+    std::vector<size_t> m_scopes;
 };
 
+// Text reader for the key=value format. The file is read into one buffer and every key
+// and value is a string_view into it, indexed in an open-addressing hash table. Values
+// are parsed on demand with std::from_chars. Later duplicates of a key win.
 class TextReader {
 public:
     TextReader() {}
     
     bool LoadFromFile(const std::string& filename) {
-        std::ifstream file(filename);
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
         if (!file.is_open()) {
             return false;
         }
         
-        std::string line;
-        while (std::getline(file, line)) {
-            size_t pos = line.find('=');
-            if (pos != std::string::npos) {
-                std::string key = line.substr(0, pos);
-                std::string value = line.substr(pos + 1);
-                m_data[key] = value;
-            }
+        std::streamoff size = file.tellg();
+        if (size < 0) {
+            return false;
         }
-        file.close();
+        std::string text(static_cast<size_t>(size), '\0');
+        file.seekg(0, std::ios::beg);
+        if (size > 0 && !file.read(&text[0], size)) {
+            return false;
+        }
+        
+        LoadFromString(std::move(text));
         return true;
     }
     
-    template<typename T>
-    bool Read(const std::string& key, T& value) {
-        auto it = m_data.find(key);
-        if (it == m_data.end()) {
-            return false;
+    // Takes ownership of already loaded text and indexes it
+    void LoadFromString(std::string text) {
+        m_text = std::move(text);
+        BuildIndex();
+    }
+    
+    size_t GetKeyCount() const { return m_count; }
+    
+    // Mirrors TextWriter::BeginScope: prefixes keys read until EndScope() with "<name><index>_"
+    void BeginScope(std::string_view name, size_t index) {
+        m_scopes.push_back(m_prefix.size());
+        m_prefix.append(name);
+        AppendNumber(m_prefix, index);
+        m_prefix.push_back('_');
+    }
+    
+    void EndScope() {
+        if (!m_scopes.empty()) {
+            m_prefix.resize(m_scopes.back());
+            m_scopes.pop_back();
         }
-        
-        std::stringstream ss(it->second);
-        ss >> value;
-        return !ss.fail();
     }
     
-    // Specialization for strings
-    bool Read(const std::string& key, std::string& value) {
-        auto it = m_data.find(key);
-        if (it == m_data.end()) {
-            return false;
+    // Raw value lookup, valid as long as the reader is
+    bool Find(std::string_view key, std::string_view& value) const {
+        if (m_prefix.empty()) {
+            return FindExact(key, value);
         }
         
-        value = it->second;
-        return true;
+        m_keyScratch.assign(m_prefix);
+        m_keyScratch.append(key);
+        return FindExact(m_keyScratch, value);
+    }
+    
+    // Calls visit(key, value) for every key, in no particular order. Scopes don't apply.
+    template<typename Visitor>
+    void ForEach(Visitor&& visit) const {
+        for (const Slot& slot : m_slots) {
+            if (slot.used) {
+                visit(slot.key, slot.value);
+            }
+        }
+    }
+    
+    template<typename T>
+    bool Read(std::string_view key, T& value) const {
+        std::string_view text;
+        return Find(key, text) && ParseValue(text, value);
+    }
+    
+    // Reads "<name><index>", the counterpart of TextWriter::WriteIndexed
+    template<typename T>
+    bool ReadIndexed(std::string_view name, size_t index, T& value) const {
+        m_keyScratch.assign(m_prefix);
+        m_keyScratch.append(name);
+        AppendNumber(m_keyScratch, index);
+        std::string_view text;
+        return FindExact(m_keyScratch, text) && ParseValue(text, value);
     }
     
     // Read vector from comma-separated values
     template<typename T>
-    bool ReadVector(const std::string& key, std::vector<T>& vec) {
-        auto it = m_data.find(key);
-        if (it == m_data.end()) {
+    bool ReadVector(std::string_view key, std::vector<T>& vec) const {
+        std::string_view text;
+        if (!Find(key, text)) {
             return false;
         }
         
-        std::string value = it->second;
-        std::stringstream ss(value);
-        std::string item;
         vec.clear();
-        
-        while (std::getline(ss, item, ',')) {
-            T val;
-            std::stringstream itemSS(item);
-            itemSS >> val;
-            if (!itemSS.fail()) {
-                vec.push_back(val);
+        while (!text.empty()) {
+            size_t comma = text.find(',');
+            std::string_view item = text.substr(0, comma);
+            T val{};
+            if (ParseValue(item, val)) {
+                vec.push_back(std::move(val));
             }
+            if (comma == std::string_view::npos) {
+                break;
+            }
+            text.remove_prefix(comma + 1);
         }
-        
         return true;
     }
     
     // Read map from key-value pairs
     template<typename V>
-    bool ReadMap(const std::string& key, std::unordered_map<std::string, V>& map) {
-        auto it = m_data.find(key);
-        if (it == m_data.end()) {
+    bool ReadMap(std::string_view key, std::unordered_map<std::string, V>& map) const {
+        std::string_view text;
+        if (!Find(key, text)) {
             return false;
         }
         
-        std::string value = it->second;
-        std::stringstream ss(value);
-        std::string pair;
         map.clear();
-        
-        while (std::getline(ss, pair, ';')) {
+        while (!text.empty()) {
+            size_t separator = text.find(';');
+            std::string_view pair = text.substr(0, separator);
             size_t pos = pair.find('=');
-            if (pos != std::string::npos) {
-                std::string mapKey = pair.substr(0, pos);
-                std::string mapValue = pair.substr(pos + 1);
-                
-                V val;
-                std::stringstream valSS(mapValue);
-                valSS >> val;
-                if (!valSS.fail()) {
-                    map[mapKey] = val;
+            if (pos != std::string_view::npos) {
+                V val{};
+                if (ParseValue(pair.substr(pos + 1), val)) {
+                    map[std::string(pair.substr(0, pos))] = std::move(val);
                 }
             }
+            if (separator == std::string_view::npos) {
+                break;
+            }
+            text.remove_prefix(separator + 1);
         }
-        
         return true;
     }
     
 private:
-    std::unordered_map<std::string, std::string> m_data;
+    struct Slot {
+        std::string_view key;
+        std::string_view value;
+        uint32_t hash = 0;
+        bool used = false;
+    };
+    
+    static uint32_t HashKey(std::string_view key) {
+        // FNV-1a
+        uint32_t hash = 2166136261u;
+        for (char c : key) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+        }
+        return hash;
+    }
+    
+    void BuildIndex() {
+        m_slots.clear();
+        m_count = 0;
+        
+        // Size the table once from the line count, kept at most half full
+        size_t lines = static_cast<size_t>(std::count(m_text.begin(), m_text.end(), '\n')) + 1;
+        size_t capacity = 16;
+        while (capacity < lines * 2) {
+            capacity <<= 1;
+        }
+        m_slots.resize(capacity);
+        m_mask = capacity - 1;
+        
+        std::string_view text(m_text);
+        while (!text.empty()) {
+            size_t end = text.find('\n');
+            std::string_view line = text.substr(0, end);
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+            
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            size_t pos = line.find('=');
+            if (pos != std::string_view::npos) {
+                Insert(line.substr(0, pos), line.substr(pos + 1));
+            }
+        }
+    }
+    
+    void Insert(std::string_view key, std::string_view value) {
+        uint32_t hash = HashKey(key);
+        for (size_t i = hash & m_mask;; i = (i + 1) & m_mask) {
+            Slot& slot = m_slots[i];
+            if (!slot.used) {
+                slot.key = key;
+                slot.value = value;
+                slot.hash = hash;
+                slot.used = true;
+                m_count++;
+                return;
+            }
+            if (slot.hash == hash && slot.key == key) {
+                slot.value = value;
+                return;
+            }
+        }
+    }
+    
+    bool FindExact(std::string_view key, std::string_view& value) const {
+        if (m_slots.empty()) {
+            return false;
+        }
+        
+        uint32_t hash = HashKey(key);
+        for (size_t i = hash & m_mask;; i = (i + 1) & m_mask) {
+            const Slot& slot = m_slots[i];
+            if (!slot.used) {
+                return false;
+            }
+            if (slot.hash == hash && slot.key == key) {
+                value = slot.value;
+                return true;
+            }
+        }
+    }
+    
+    template<typename T>
+    static void AppendNumber(std::string& out, T value) {
+        char digits[32];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    }
+    
+    template<typename T>
+    static bool ParseNumber(std::string_view text, T& value) {
+        const char* first = text.data();
+        const char* last = first + text.size();
+        if (first != last && *first == '+') {
+            ++first;
+        }
+        auto result = std::from_chars(first, last, value);
+        return result.ec == std::errc() && result.ptr != first;
+    }
+    
+    template<typename T>
+    static bool ParseValue(std::string_view text, T& value) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            value.assign(text.data(), text.size());
+            return true;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            if (text == "1" || text == "true") {
+                value = true;
+                return true;
+            }
+            if (text == "0" || text == "false") {
+                value = false;
+                return true;
+            }
+            return false;
+        } else if constexpr (std::is_same_v<T, char>) {
+            if (text.empty()) {
+                return false;
+            }
+            value = text.front();
+            return true;
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            return ParseNumber(text, value);
+        } else if constexpr (std::is_enum_v<T>) {
+            std::underlying_type_t<T> raw{};
+            if (!ParseNumber(text, raw)) {
+                return false;
+            }
+            value = static_cast<T>(raw);
+            return true;
+        } else {
+            // Anything else falls back to its stream operator
+            std::istringstream ss{std::string(text)};
+            ss >> value;
+            return !ss.fail();
+        }
+    }
+    
+    std::string m_text;
+    std::vector<Slot> m_slots;
+    size_t m_mask = 0;
+    size_t m_count = 0;
+    
+    std::string m_prefix;
+    std::vector<size_t> m_scopes;
+    mutable std::string m_keyScratch;
 };
 // ^ Serialization.h
\ No newline at end of file
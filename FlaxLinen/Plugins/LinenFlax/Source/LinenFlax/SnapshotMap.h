@@ -0,0 +1,251 @@
+// v SnapshotMap.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <utility>
+#include <iterator>
+#include <unordered_map>
+#include <cstddef>
+
+template<typename V, size_t PageSize>
+class SnapshotMap;
+
+namespace SnapshotMapDetail {
+
+template<typename V>
+using Entry = std::pair<std::string, V>;
+
+template<typename V>
+using Page = std::vector<Entry<V>>;
+
+// One pointer per page; shared between a map and the snapshots taken from it
+template<typename V>
+using Directory = std::vector<std::shared_ptr<Page<V>>>;
+
+// Walks entries in storage order
+template<typename V, size_t PageSize>
+class ConstIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Entry<V>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+    
+    ConstIterator() = default;
+    ConstIterator(const Directory<V>* pages, size_t index) : m_pages(pages), m_index(index) {}
+    
+    reference operator*() const { return (*(*m_pages)[m_index / PageSize])[m_index % PageSize]; }
+    pointer operator->() const { return &**this; }
+    ConstIterator& operator++() { ++m_index; return *this; }
+    ConstIterator operator++(int) { ConstIterator previous = *this; ++m_index; return previous; }
+    bool operator==(const ConstIterator& other) const { return m_index == other.m_index; }
+    bool operator!=(const ConstIterator& other) const { return m_index != other.m_index; }
+    
+    size_t GetIndex() const { return m_index; }
+
+private:
+    const Directory<V>* m_pages = nullptr;
+    size_t m_index = 0;
+};
+
+} // namespace SnapshotMapDetail
+
+// Frozen, read-only state of a SnapshotMap at the time Snapshot() was called. Cheap to
+// copy and safe to read on any thread while the map keeps changing.
+template<typename V, size_t PageSize = 64>
+class SnapshotMapView {
+public:
+    using key_type = std::string;
+    using mapped_type = V;
+    using value_type = SnapshotMapDetail::Entry<V>;
+    using const_iterator = SnapshotMapDetail::ConstIterator<V, PageSize>;
+    
+    SnapshotMapView() = default;
+    
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const_iterator begin() const { return const_iterator(m_pages.get(), 0); }
+    const_iterator end() const { return const_iterator(m_pages.get(), m_size); }
+
+private:
+    friend class SnapshotMap<V, PageSize>;
+    SnapshotMapView(std::shared_ptr<const SnapshotMapDetail::Directory<V>> pages, size_t size)
+        : m_pages(std::move(pages)), m_size(size) {}
+    
+    std::shared_ptr<const SnapshotMapDetail::Directory<V>> m_pages;
+    size_t m_size = 0;
+};
+
+// String-keyed map with O(1) copy-on-write snapshots, so a save can serialize a frozen
+// view on another thread while the game keeps changing the map.
+//
+// Entries live in pages of 'PageSize' entries. Snapshot() only takes a reference to the
+// page directory. The first change after that copies the directory (one pointer per
+// page) and every page it then touches is copied once, leaving the snapshot's pages as
+// they were. Without an outstanding snapshot, changes happen in place.
+//
+// Reading works like std::unordered_map, but iteration is in storage order and only
+// const access is handed out: Edit() and operator[] give a mutable reference, valid until
+// the next Snapshot() or erase(). erase() moves the last entry into the hole. The map
+// itself is not thread safe; only its snapshots are.
+template<typename V, size_t PageSize = 64>
+class SnapshotMap {
+public:
+    using key_type = std::string;
+    using mapped_type = V;
+    using value_type = SnapshotMapDetail::Entry<V>;
+    using const_iterator = SnapshotMapDetail::ConstIterator<V, PageSize>;
+    using iterator = const_iterator;
+    using View = SnapshotMapView<V, PageSize>;
+    
+    SnapshotMap() = default;
+    SnapshotMap(const SnapshotMap& other) : m_pages(other.m_pages), m_size(other.m_size), m_index(other.m_index) {}
+    SnapshotMap(SnapshotMap&& other) noexcept = default;
+    SnapshotMap& operator=(const SnapshotMap& other) {
+        // Copies share pages like snapshots do
+        m_pages = other.m_pages;
+        m_size = other.m_size;
+        m_index = other.m_index;
+        return *this;
+    }
+    SnapshotMap& operator=(SnapshotMap&& other) noexcept = default;
+    
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const_iterator begin() const { return const_iterator(m_pages.get(), 0); }
+    const_iterator end() const { return const_iterator(m_pages.get(), m_size); }
+    
+    const_iterator find(const std::string& key) const {
+        auto it = m_index.find(key);
+        return it == m_index.end() ? end() : const_iterator(m_pages.get(), it->second);
+    }
+    size_t count(const std::string& key) const { return m_index.count(key); }
+    
+    // Entries by storage index (see const_iterator::GetIndex), 0 .. size() - 1. An
+    // entry keeps its index until it or the last entry is erased.
+    const value_type& GetEntry(size_t index) const { return (*(*m_pages)[index / PageSize])[index % PageSize]; }
+    V& EditAt(size_t index) { return MutableEntry(index).second; }
+    
+    void reserve(size_t count) {
+        m_index.reserve(count);
+        MutableDirectory().reserve((count + PageSize - 1) / PageSize);
+    }
+    
+    void clear() {
+        m_pages.reset();
+        m_size = 0;
+        m_index.clear();
+    }
+    
+    // Mutable access to an entry, added with a default value if missing
+    V& operator[](const std::string& key) {
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            return MutableEntry(it->second).second;
+        }
+        return Append(key, V{});
+    }
+    
+    // Adds an entry if the key is missing; otherwise leaves the map as it is and returns false
+    bool insert(const std::string& key, V value) {
+        if (m_index.count(key) > 0) {
+            return false;
+        }
+        Append(key, std::move(value));
+        return true;
+    }
+    
+    // Mutable access to an existing entry, or nullptr
+    V* Edit(const std::string& key) {
+        auto it = m_index.find(key);
+        return it == m_index.end() ? nullptr : &MutableEntry(it->second).second;
+    }
+    
+    size_t erase(const std::string& key) {
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            return 0;
+        }
+        size_t index = it->second;
+        size_t last = m_size - 1;
+        m_index.erase(it);
+        if (index != last) {
+            value_type& hole = MutableEntry(index);
+            hole = std::move(MutableEntry(last));
+            m_index[hole.first] = index;
+        }
+        
+        Directory& pages = MutableDirectory();
+        MutablePage(last / PageSize).pop_back();
+        if (last % PageSize == 0) {
+            pages.pop_back();
+        }
+        m_size--;
+        return 1;
+    }
+    
+    View Snapshot() const { return View(m_pages, m_size); }
+
+private:
+    using Page = SnapshotMapDetail::Page<V>;
+    using Directory = SnapshotMapDetail::Directory<V>;
+    
+    // Another holder (a snapshot) is still reading this. A holder on another thread may
+    // let go at any moment; that only costs an unneeded copy. Once we see the last
+    // reference, the fence orders its earlier reads before our writes.
+    template<typename T>
+    static bool IsShared(const std::shared_ptr<T>& pointer) {
+        if (pointer.use_count() > 1) {
+            return true;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return false;
+    }
+    
+    Directory& MutableDirectory() {
+        if (!m_pages) {
+            m_pages = std::make_shared<Directory>();
+        } else if (IsShared(m_pages)) {
+            m_pages = std::make_shared<Directory>(*m_pages);
+        }
+        return *m_pages;
+    }
+    
+    Page& MutablePage(size_t pageIndex) {
+        std::shared_ptr<Page>& page = MutableDirectory()[pageIndex];
+        if (IsShared(page)) {
+            auto copy = std::make_shared<Page>();
+            copy->reserve(PageSize);
+            copy->assign(page->begin(), page->end());
+            page = std::move(copy);
+        }
+        return *page;
+    }
+    
+    value_type& MutableEntry(size_t index) {
+        return MutablePage(index / PageSize)[index % PageSize];
+    }
+    
+    V& Append(const std::string& key, V value) {
+        size_t pageIndex = m_size / PageSize;
+        Directory& pages = MutableDirectory();
+        if (pageIndex == pages.size()) {
+            // Pages never grow past their reserve, so entries don't move within a page
+            pages.push_back(std::make_shared<Page>());
+            pages.back()->reserve(PageSize);
+        }
+        Page& page = MutablePage(pageIndex);
+        page.emplace_back(key, std::move(value));
+        m_index.emplace(key, m_size++);
+        return page.back().second;
+    }
+    
+    std::shared_ptr<Directory> m_pages;
+    size_t m_size = 0;
+    std::unordered_map<std::string, size_t> m_index; // Key to storage position, live map only
+};
+// ^ SnapshotMap.h
\ No newline at end of file
@@ -0,0 +1,107 @@
+// v StringTable.cpp
+#include "StringTable.h"
+#include <algorithm>
+
+namespace {
+
+bool DecodeVarint(const uint8_t*& data, const uint8_t* end, uint32_t& value) {
+    value = 0;
+    for (uint32_t shift = 0; shift < 35 && data < end; shift += 7) {
+        uint8_t byte = *data++;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+uint32_t StringTableBuilder::Intern(std::string_view value) {
+    size_t hash = std::hash<std::string_view>()(value);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    if ((m_strings.size() + 1) * 2 > m_slots.size()) {
+        Grow();
+    }
+    
+    size_t mask = m_slots.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        uint32_t entry = m_slots[slot];
+        if (entry == 0) {
+            uint32_t index = static_cast<uint32_t>(m_strings.size());
+            m_strings.emplace_back(value);
+            m_hashes.push_back(hash);
+            m_slots[slot] = index + 1;
+            return index;
+        }
+        if (m_hashes[entry - 1] == hash && m_strings[entry - 1] == value) {
+            return entry - 1;
+        }
+    }
+}
+
+void StringTableBuilder::Grow() {
+    std::vector<uint32_t> slots(m_slots.empty() ? 256 : m_slots.size() * 2, 0);
+    size_t mask = slots.size() - 1;
+    for (uint32_t index = 0; index < m_hashes.size(); ++index) {
+        size_t slot = m_hashes[index] & mask;
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = index + 1;
+    }
+    m_slots.swap(slots);
+}
+
+size_t StringTableBuilder::GetCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_strings.size();
+}
+
+std::vector<uint8_t> StringTableBuilder::Encode() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    size_t size = GetVarintSize(static_cast<uint32_t>(m_strings.size()));
+    for (const auto& value : m_strings) {
+        size += GetVarintSize(static_cast<uint32_t>(value.size())) + value.size();
+    }
+    
+    std::vector<uint8_t> data(size);
+    uint8_t* out = data.data();
+    out += EncodeVarint(static_cast<uint32_t>(m_strings.size()), out);
+    for (const auto& value : m_strings) {
+        out += EncodeVarint(static_cast<uint32_t>(value.size()), out);
+        std::copy(value.begin(), value.end(), out);
+        out += value.size();
+    }
+    return data;
+}
+
+bool StringTable::Decode(const uint8_t* data, size_t size) {
+    m_data.clear();
+    m_entries.clear();
+    
+    const uint8_t* end = data + size;
+    uint32_t count = 0;
+    // Every entry takes at least its one-byte length
+    if (!DecodeVarint(data, end, count) || count > static_cast<size_t>(end - data)) {
+        return false;
+    }
+    
+    m_entries.reserve(count);
+    m_data.reserve(size);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t length = 0;
+        if (!DecodeVarint(data, end, length) || length > static_cast<size_t>(end - data)) {
+            m_entries.clear();
+            return false;
+        }
+        m_entries.push_back({ static_cast<uint32_t>(m_data.size()), length });
+        m_data.append(reinterpret_cast<const char*>(data), length);
+        data += length;
+    }
+    return true;
+}
+// ^ StringTable.cpp
\ No newline at end of file
@@ -0,0 +1,88 @@
+// v StringTable.h
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+// LEB128 variable-length encoding: 7 bits per byte, high bit set on all but the last
+inline size_t GetVarintSize(uint32_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+inline size_t EncodeVarint(uint32_t value, uint8_t* out) {
+    size_t size = 0;
+    while (value >= 0x80) {
+        out[size++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[size++] = static_cast<uint8_t>(value);
+    return size;
+}
+
+// Collects the distinct strings of a binary save while its chunks are written.
+// Writers attached with BinaryWriter::SetStringTable store each string as a varint
+// index into this table. Thread safe, so chunks can be serialized in parallel.
+class StringTableBuilder {
+public:
+    StringTableBuilder() = default;
+    StringTableBuilder(const StringTableBuilder&) = delete;
+    StringTableBuilder& operator=(const StringTableBuilder&) = delete;
+    
+    // Returns the index of 'value', adding it if needed
+    uint32_t Intern(std::string_view value);
+    
+    size_t GetCount() const;
+    
+    // Table chunk payload: varint count, then a varint length and the bytes of each string
+    std::vector<uint8_t> Encode() const;
+
+private:
+    void Grow();
+    
+    mutable std::mutex m_mutex;
+    std::deque<std::string> m_strings;
+    std::vector<size_t> m_hashes;      // Hash of each string, by index
+    
+    // Open-addressed index: string index + 1 per slot, 0 for empty. Kept at most half
+    // full, so lookups rarely probe more than a slot or two.
+    std::vector<uint32_t> m_slots;
+};
+
+// String table read back from a save. All strings share one buffer and are handed out
+// as views into it.
+class StringTable {
+public:
+    // Decodes a chunk written by StringTableBuilder::Encode
+    bool Decode(const uint8_t* data, size_t size);
+    
+    bool Get(uint32_t index, std::string_view& value) const {
+        if (index >= m_entries.size()) {
+            return false;
+        }
+        value = std::string_view(m_data.data() + m_entries[index].offset, m_entries[index].length);
+        return true;
+    }
+    
+    size_t GetCount() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        uint32_t offset;
+        uint32_t length;
+    };
+    
+    std::string m_data;
+    std::vector<Entry> m_entries;
+};
+// ^ StringTable.h
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "TimeSystem.h"
 #include "LinenFlax.h"
 #include "Engine/Core/Log.h"
+#include "json.hpp"
 #include <sstream>
 #include <iomanip>
 
@@ -22,6 +23,8 @@ void TimeSystem::Initialize() {
     m_day = 1;
     m_month = 1;
     m_year = 1;
+    m_clockDirty = true;
+    m_configDirty = true;
     
     LOG(Info, "Time System Initialized. Starting at {0} on day {1}/{2}/{3}", 
         String(GetFormattedTime().c_str()), m_day, m_month, m_year);
@@ -51,6 +54,7 @@ void TimeSystem::UpdateGameTime(float deltaTime) {
     
     // Add to accumulated time
     m_accumulatedTime += scaledDelta;
+    m_clockDirty = true;
     
     // One minute passes every 60 seconds
     const float secondsPerMinute = 1.0f; // Adjust this for faster/slower time
@@ -175,12 +179,14 @@ void TimeSystem::SetTimeScale(float scale) {
         m_timeScale = scale;
         LOG(Info, "Time scale set to {0}x", m_timeScale);
     }
+    m_configDirty = true;
 }
 
 void TimeSystem::SetHour(int hour) {
     if (hour >= 0 && hour < 24) {
         int oldHour = m_hour;
         m_hour = hour;
+        m_clockDirty = true;
         
         HourChangedEvent event;
         event.previousHour = oldHour;
@@ -199,6 +205,7 @@ void TimeSystem::SetDay(int day) {
     if (day > 0 && day <= m_daysPerMonth) {
         int oldDay = m_day;
         m_day = day;
+        m_clockDirty = true;
         
         DayChangedEvent event;
         event.previousDay = oldDay;
@@ -216,6 +223,7 @@ void TimeSystem::SetMonth(int month) {
     if (month > 0 && month <= m_monthsPerYear) {
         std::string oldSeason = GetCurrentSeason();
         m_month = month;
+        m_clockDirty = true;
         std::string newSeason = GetCurrentSeason();
         
         if (oldSeason != newSeason) {
@@ -235,6 +243,7 @@ void TimeSystem::SetMonth(int month) {
 void TimeSystem::SetYear(int year) {
     if (year > 0) {
         m_year = year;
+        m_clockDirty = true;
         LOG(Info, "Year set to {0}", m_year);
     } else {
         LOG(Warning, "Invalid year {0}. Must be greater than 0", year);
@@ -294,6 +303,15 @@ bool TimeSystem::IsDaytime() const {
     return m_hour >= m_dayHour && m_hour < m_duskHour;
 }
 
+int64_t TimeSystem::GetTotalMinutes() const {
+    return ToTotalMinutes(m_year, m_month, m_day, m_hour, m_minute);
+}
+
+int64_t TimeSystem::ToTotalMinutes(int year, int month, int day, int hour, int minute) const {
+    int64_t days = (static_cast<int64_t>(year - 1) * m_monthsPerYear + (month - 1)) * m_daysPerMonth + (day - 1);
+    return (days * 24 + hour) * 60 + minute;
+}
+
 void TimeSystem::AdvanceTimeSeconds(int seconds) {
     if (seconds <= 0) {
         LOG(Warning, "Cannot advance by negative or zero seconds");
@@ -316,6 +334,7 @@ void TimeSystem::AdvanceTimeSeconds(int seconds) {
         
         // Update seconds and accumulate time
         m_accumulatedTime += remainingSeconds;
+        m_clockDirty = true;
         
         // Handle minute change
         if (m_accumulatedTime >= 60.0f) {
@@ -348,6 +367,7 @@ void TimeSystem::AdvanceTimeMinutes(int minutes) {
     
     // Update minute
     m_minute += minutes;
+    m_clockDirty = true;
     
     // Handle hour change
     if (m_minute >= 60) {
@@ -428,6 +448,7 @@ void TimeSystem::AdvanceTimeHours(int hours) {
     
     // Update hour
     m_hour += hours;
+    m_clockDirty = true;
     
     // Handle day change
     if (m_hour >= 24) {
@@ -498,6 +519,7 @@ void TimeSystem::AdvanceDays(int days) {
     
     // Update day
     m_day += days;
+    m_clockDirty = true;
     
     // Handle month change
     if (m_day > m_daysPerMonth) {
@@ -540,6 +562,7 @@ void TimeSystem::DebugSetTime(int hour, int minute) {
         int oldHour = m_hour;
         m_hour = hour;
         m_minute = minute;
+        m_clockDirty = true;
         
         HourChangedEvent event;
         event.previousHour = oldHour;
@@ -555,120 +578,88 @@ void TimeSystem::DebugSetTime(int hour, int minute) {
 }
 
 void TimeSystem::Serialize(BinaryWriter& writer) const {
-    writer.Write(m_timeScale);
-    writer.Write(m_accumulatedTime);
-    writer.Write(static_cast<int32_t>(m_minute));
-    writer.Write(static_cast<int32_t>(m_hour));
-    writer.Write(static_cast<int32_t>(m_day));
-    writer.Write(static_cast<int32_t>(m_month));
-    writer.Write(static_cast<int32_t>(m_year));
-    
-    // System config values
-    writer.Write(static_cast<int32_t>(m_dawnHour));
-    writer.Write(static_cast<int32_t>(m_dayHour));
-    writer.Write(static_cast<int32_t>(m_duskHour));
-    writer.Write(static_cast<int32_t>(m_nightHour));
-    writer.Write(static_cast<int32_t>(m_daysPerMonth));
-    writer.Write(static_cast<int32_t>(m_monthsPerYear));
-    
-    // Seasons
-    writer.Write(static_cast<uint32_t>(m_seasons.size()));
-    for (const auto& season : m_seasons) {
-        writer.Write(season);
-    }
-    
+    FieldSerializer::WriteBinary(writer, *this);
     LOG(Info, "TimeSystem serialized");
 }
 
 void TimeSystem::Deserialize(BinaryReader& reader) {
-    reader.Read(m_timeScale);
-    reader.Read(m_accumulatedTime);
-    
-    int32_t value;
-    
-    reader.Read(value); m_minute = value;
-    reader.Read(value); m_hour = value;
-    reader.Read(value); m_day = value;
-    reader.Read(value); m_month = value;
-    reader.Read(value); m_year = value;
-    
-    // System config values
-    reader.Read(value); m_dawnHour = value;
-    reader.Read(value); m_dayHour = value;
-    reader.Read(value); m_duskHour = value;
-    reader.Read(value); m_nightHour = value;
-    reader.Read(value); m_daysPerMonth = value;
-    reader.Read(value); m_monthsPerYear = value;
+    FieldSerializer::ReadBinary(reader, *this);
     
-    // Seasons
-    uint32_t seasonCount;
-    reader.Read(seasonCount);
-    
-    m_seasons.clear();
-    for (uint32_t i = 0; i < seasonCount; ++i) {
-        std::string season;
-        reader.Read(season);
-        m_seasons.push_back(season);
+    // Season lookups divide by the season count, never leave it empty
+    if (m_seasons.empty()) {
+        m_seasons = {"Spring", "Summer", "Fall", "Winter"};
     }
+    ClearDirty();
     
     LOG(Info, "TimeSystem deserialized: Current time {0} on {1}", 
         String(GetFormattedTime().c_str()), String(GetFormattedDate().c_str()));
 }
 
-void TimeSystem::SerializeToText(TextWriter& writer) const {
-    writer.Write("timeScale", m_timeScale);
-    writer.Write("accumulatedTime", m_accumulatedTime);
-    writer.Write("minute", m_minute);
-    writer.Write("hour", m_hour);
-    writer.Write("day", m_day);
-    writer.Write("month", m_month);
-    writer.Write("year", m_year);
-    
-    // System config values
-    writer.Write("dawnHour", m_dawnHour);
-    writer.Write("dayHour", m_dayHour);
-    writer.Write("duskHour", m_duskHour);
-    writer.Write("nightHour", m_nightHour);
-    writer.Write("daysPerMonth", m_daysPerMonth);
-    writer.Write("monthsPerYear", m_monthsPerYear);
-    
-    // Seasons
-    writer.Write("seasonCount", static_cast<int>(m_seasons.size()));
-    for (size_t i = 0; i < m_seasons.size(); ++i) {
-        writer.Write("season" + std::to_string(i), m_seasons[i]);
+void TimeSystem::SerializeDelta(BinaryWriter& writer) const {
+    uint32_t blocks = (m_clockDirty ? static_cast<uint32_t>(ClockBlock) : 0u) | (m_configDirty ? static_cast<uint32_t>(ConfigBlock) : 0u);
+    writer.Write(blocks);
+    
+    if (blocks & ClockBlock) {
+        FieldSerializer::WriteBinary<ClockBlock>(writer, *this);
+    }
+    if (blocks & ConfigBlock) {
+        FieldSerializer::WriteBinary<ConfigBlock>(writer, *this);
     }
+}
+
+void TimeSystem::DeserializeDelta(BinaryReader& reader) {
+    uint32_t blocks = 0;
+    reader.Read(blocks);
     
+    if (blocks & ClockBlock) {
+        FieldSerializer::ReadBinary<ClockBlock>(reader, *this);
+    }
+    if (blocks & ConfigBlock) {
+        // An empty season list keeps the current seasons
+        std::vector<std::string> seasons = m_seasons;
+        FieldSerializer::ReadBinary<ConfigBlock>(reader, *this);
+        if (m_seasons.empty()) {
+            m_seasons = std::move(seasons);
+        }
+    }
+}
+
+void TimeSystem::SerializeToText(TextWriter& writer) const {
+    FieldSerializer::WriteText(writer, *this);
     LOG(Info, "TimeSystem serialized to text");
 }
 
 void TimeSystem::DeserializeFromText(TextReader& reader) {
-    reader.Read("timeScale", m_timeScale);
-    reader.Read("accumulatedTime", m_accumulatedTime);
-    reader.Read("minute", m_minute);
-    reader.Read("hour", m_hour);
-    reader.Read("day", m_day);
-    reader.Read("month", m_month);
-    reader.Read("year", m_year);
-    
-    // System config values
-    reader.Read("dawnHour", m_dawnHour);
-    reader.Read("dayHour", m_dayHour);
-    reader.Read("duskHour", m_duskHour);
-    reader.Read("nightHour", m_nightHour);
-    reader.Read("daysPerMonth", m_daysPerMonth);
-    reader.Read("monthsPerYear", m_monthsPerYear);
-    
-    // Seasons
-    int seasonCount = 0;
-    reader.Read("seasonCount", seasonCount);
-    
-    m_seasons.clear();
-    for (int i = 0; i < seasonCount; ++i) {
-        std::string season;
-        reader.Read("season" + std::to_string(i), season);
-        m_seasons.push_back(season);
+    FieldSerializer::ReadText(reader, *this);
+    
+    if (m_seasons.empty()) {
+        m_seasons = {"Spring", "Summer", "Fall", "Winter"};
     }
+    ClearDirty();
     
     LOG(Info, "TimeSystem deserialized from text: Current time {0} on {1}",
         String(GetFormattedTime().c_str()), String(GetFormattedDate().c_str()));
+}
+
+void TimeSystem::SerializeToJson(JsonWriter& writer) const {
+    FieldSerializer::WriteJson(writer, *this);
+}
+
+void TimeSystem::BeginJsonLoad() {
+    FieldSerializer::ClearContainers(*this);
+}
+
+void TimeSystem::DeserializeJsonField(const std::string& field, const nlohmann::json& value) {
+    FieldSerializer::ReadJsonField(*this, field, value);
+}
+
+void TimeSystem::EndJsonLoad() {
+    // Season lookups divide by the season count, never leave it empty
+    if (m_seasons.empty()) {
+        m_seasons = {"Spring", "Summer", "Fall", "Winter"};
+    }
+    ClearDirty();
+    
+    LOG(Info, "TimeSystem deserialized from JSON: Current time {0} on {1}",
+        String(GetFormattedTime().c_str()), String(GetFormattedDate().c_str()));
 }
\ No newline at end of file
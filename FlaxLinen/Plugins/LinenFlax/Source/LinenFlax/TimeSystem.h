@@ -3,7 +3,7 @@
 
 #include "RPGSystem.h"
 #include "EventSystem.h"
-#include "Serialization.h"
+#include "Reflection.h"
 #include <chrono>
 #include <string>
 #include <vector>
@@ -74,6 +74,35 @@ public:
     void Deserialize(BinaryReader& reader) override;
     void SerializeToText(TextWriter& writer) const;
     void DeserializeFromText(TextReader& reader);
+    void SerializeToJson(JsonWriter& writer) const override;
+    void BeginJsonLoad() override;
+    void DeserializeJsonField(const std::string& field, const nlohmann::json& value) override;
+    void EndJsonLoad() override;
+    
+    // Incremental saves track the clock and the calendar configuration as separate blocks
+    bool IsDirty() const override { return m_clockDirty || m_configDirty; }
+    void ClearDirty() override { m_clockDirty = false; m_configDirty = false; }
+    void SerializeDelta(BinaryWriter& writer) const override;
+    void DeserializeDelta(BinaryReader& reader) override;
+    
+    // Serialized fields, in save order. The groups are the delta blocks each field belongs to.
+    static constexpr auto Fields() {
+        return std::make_tuple(
+            MakeField<ConfigBlock>("timeScale", &TimeSystem::m_timeScale),
+            MakeField<ClockBlock>("accumulatedTime", &TimeSystem::m_accumulatedTime),
+            MakeField<ClockBlock>("minute", &TimeSystem::m_minute),
+            MakeField<ClockBlock>("hour", &TimeSystem::m_hour),
+            MakeField<ClockBlock>("day", &TimeSystem::m_day),
+            MakeField<ClockBlock>("month", &TimeSystem::m_month),
+            MakeField<ClockBlock>("year", &TimeSystem::m_year),
+            MakeField<ConfigBlock>("dawnHour", &TimeSystem::m_dawnHour),
+            MakeField<ConfigBlock>("dayHour", &TimeSystem::m_dayHour),
+            MakeField<ConfigBlock>("duskHour", &TimeSystem::m_duskHour),
+            MakeField<ConfigBlock>("nightHour", &TimeSystem::m_nightHour),
+            MakeField<ConfigBlock>("daysPerMonth", &TimeSystem::m_daysPerMonth),
+            MakeField<ConfigBlock>("monthsPerYear", &TimeSystem::m_monthsPerYear),
+            MakeField<ConfigBlock>("seasons", &TimeSystem::m_seasons));
+    }
     
     // Game time setters
     void SetTimeScale(float scale);
@@ -101,6 +130,11 @@ public:
     std::string GetFormattedDate() const; // Returns DD/MM/YYYY format
     bool IsDaytime() const;
     
+    // Minutes since 00:00 on day 1 of month 1, year 1, for scheduling against (see
+    // QuestTimers). Dates are counted on the current calendar.
+    int64_t GetTotalMinutes() const;
+    int64_t ToTotalMinutes(int year, int month, int day, int hour, int minute) const;
+    
     // Season info
     const std::vector<std::string>& GetSeasons() const { return m_seasons; }
     
@@ -137,6 +171,14 @@ private:
     // Define seasons (usually 4)
     std::vector<std::string> m_seasons = {"Spring", "Summer", "Fall", "Winter"};
     
+    // Delta blocks changed since the last incremental save
+    enum DeltaBlock : uint32_t {
+        ClockBlock = 1 << 0,  // Current time and date
+        ConfigBlock = 1 << 1  // Time scale, hour thresholds, calendar and seasons
+    };
+    bool m_clockDirty = true;
+    bool m_configDirty = true;
+    
     // Helper methods
     void UpdateGameTime(float deltaTime);
     void CheckForTimeEvents();
@@ -0,0 +1,710 @@
+// v LinenSaveTool.cpp
+// Command line tool for Linen saves outside the game. Inspects, validates and converts
+// save files, and measures what loading and saving them costs. The plugin's own systems
+// and serializers do the work, built against the engine stand-ins in Shim/.
+//
+//   linen-save-tool [--verbose] [--serial] <command> <arguments>
+//
+//   info <save>                    Header, chunk table and size of every system
+//   dump <save> [--system <name>]  Contents of every system (or one), as JSON
+//   validate <save>                Structure, checksums and a decode of every chunk
+//   convert <input> <output>       Between .bin, .txt and .json, picked by extension
+//   bench <save> [--iterations <n>] [--format bin|txt|json] [--csv]
+//                                  Repeated load/save cycles: time, throughput and
+//                                  heap allocations per load and per save
+//
+// Exit code 0 on success, 1 when the save is invalid or the command failed, 2 for
+// wrong usage.
+
+#include "LinenFlax.h"
+#include "LinenSystemIncludes.h"
+#include "Checksum.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Heap allocations on any thread, counted by the global operator new below
+std::atomic<uint64_t> allocationCount{ 0 };
+std::atomic<uint64_t> allocatedBytes{ 0 };
+
+void* CountedAllocate(size_t size, size_t alignment) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    size = size > 0 ? size : 1;
+    if (alignment <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    // aligned_alloc takes whole multiples of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+void* CountedAllocateOrThrow(size_t size, size_t alignment) {
+    if (void* memory = CountedAllocate(size, alignment)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+// Every replaceable form is defined, so each allocation is counted and each is freed by
+// the matching delete. Both malloc and aligned_alloc memory go back through free.
+void* operator new(size_t size) { return CountedAllocateOrThrow(size, 0); }
+void* operator new[](size_t size) { return CountedAllocateOrThrow(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment) { return CountedAllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return CountedAllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct AllocationSample {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+    
+    static AllocationSample Now() {
+        return { allocationCount.load(std::memory_order_relaxed), allocatedBytes.load(std::memory_order_relaxed) };
+    }
+    
+    AllocationSample Since() const {
+        AllocationSample now = Now();
+        return { now.count - count, now.bytes - bytes };
+    }
+};
+
+bool FormatFromPath(const std::string& path, SerializationFormat& format) {
+    std::string extension = fs::path(path).extension().string();
+    if (extension == ".bin") {
+        format = SerializationFormat::Binary;
+    } else if (extension == ".txt") {
+        format = SerializationFormat::Text;
+    } else if (extension == ".json") {
+        format = SerializationFormat::Json;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool FormatFromName(const std::string& name, SerializationFormat& format) {
+    return FormatFromPath("save." + name, format);
+}
+
+const char* FormatName(SerializationFormat format) {
+    switch (format) {
+        case SerializationFormat::Binary: return "binary";
+        case SerializationFormat::Text: return "text";
+        default: return "JSON";
+    }
+}
+
+std::string FormatBytes(uint64_t bytes) {
+    char text[32];
+    if (bytes < 1024) {
+        std::snprintf(text, sizeof(text), "%llu B", static_cast<unsigned long long>(bytes));
+    } else if (bytes < 1024 * 1024) {
+        std::snprintf(text, sizeof(text), "%.1f KB", bytes / 1024.0);
+    } else {
+        std::snprintf(text, sizeof(text), "%.2f MB", bytes / (1024.0 * 1024.0));
+    }
+    return text;
+}
+
+std::string FormatTimestamp(int64_t seconds) {
+    std::time_t time = static_cast<std::time_t>(seconds);
+    std::tm utc = {};
+    if (!gmtime_r(&time, &utc)) {
+        return std::to_string(seconds);
+    }
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S UTC", &utc);
+    return text;
+}
+
+bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    std::streamsize size = file.tellg();
+    file.seekg(0);
+    data.resize(static_cast<size_t>(size));
+    return size == 0 || file.read(reinterpret_cast<char*>(data.data()), size).good();
+}
+
+// One system chunk as found in a binary save
+struct ChunkEntry {
+    std::string systemName;
+    uint32_t size = 0;
+    uint32_t checksum = 0;
+    uint32_t schemaVersion = 1;
+    size_t offset = 0;          // Of the payload, from the start of the file
+    bool checksumValid = false;
+};
+
+// The layout of a binary save, read without touching any system
+struct BinarySave {
+    std::vector<uint8_t> data;
+    bool legacy = false;        // Written before chunking: no header, chunk table or checksums
+    SaveSlotInfo info;
+    std::vector<ChunkEntry> chunks;
+    size_t chunksEnd = 0;
+    std::vector<std::string> problems;
+    
+    const uint8_t* Payload(const ChunkEntry& chunk) const { return data.data() + chunk.offset; }
+};
+
+// Reads the header and chunk table and verifies the checksums. Everything that doesn't
+// add up goes to 'problems'; returns false if the file can't be read that far at all.
+bool ReadBinarySave(const std::string& path, BinarySave& save) {
+    if (!ReadWholeFile(path, save.data)) {
+        save.problems.push_back("cannot read the file");
+        return false;
+    }
+    
+    uint32_t magic = 0;
+    if (save.data.size() >= sizeof(magic)) {
+        std::memcpy(&magic, save.data.data(), sizeof(magic));
+    }
+    if (LittleEndian(magic) != SaveFileMagic) {
+        save.legacy = true;
+        return true;
+    }
+    
+    if (!ReadSaveSlotHeader(save.data.data(), save.data.size(), save.info)) {
+        save.problems.push_back("header is truncated or its checksum doesn't match");
+        return false;
+    }
+    if (save.info.formatVersion > SaveFormatVersion) {
+        save.problems.push_back("format version " + std::to_string(save.info.formatVersion) +
+            " is newer than this tool (" + std::to_string(SaveFormatVersion) + ")");
+        return false;
+    }
+    
+    BinaryReader reader(save.data.data(), save.data.size());
+    reader.Skip(save.info.headerSize);
+    for (uint32_t i = 0; i < save.info.chunkCount; ++i) {
+        ChunkEntry chunk;
+        reader.Read(chunk.systemName);
+        reader.Read(chunk.size);
+        reader.Read(chunk.checksum);
+        if (save.info.formatVersion >= FirstSchemaVersionedFormat) {
+            reader.Read(chunk.schemaVersion);
+        }
+        if (reader.HasFailed() || chunk.size > reader.GetRemaining()) {
+            save.problems.push_back("chunk " + std::to_string(i) + " of " + std::to_string(save.info.chunkCount) +
+                " is truncated");
+            break;
+        }
+        chunk.offset = static_cast<size_t>(reader.GetPosition() - save.data.data());
+        chunk.checksumValid = ComputeCrc32c(reader.GetPosition(), chunk.size) == chunk.checksum;
+        if (!chunk.checksumValid) {
+            save.problems.push_back("checksum mismatch in chunk " + chunk.systemName);
+        }
+        reader.Skip(chunk.size);
+        save.chunks.push_back(std::move(chunk));
+    }
+    save.chunksEnd = save.data.size() - reader.GetRemaining();
+    
+    // The header repeats the first chunk sizes so save menus can show them
+    if (save.info.hasMetadata) {
+        for (size_t i = 0; i < save.chunks.size() && i < SaveSlotInfo::MaxChunkSizes; ++i) {
+            if (save.info.chunkSizes[i] != save.chunks[i].size) {
+                save.problems.push_back("header lists " + std::to_string(save.info.chunkSizes[i]) + " bytes for chunk " +
+                    save.chunks[i].systemName + ", which holds " + std::to_string(save.chunks[i].size));
+            }
+        }
+    }
+    
+    size_t end = save.chunksEnd;
+    if (save.info.thumbnailSize > 0) {
+        uint64_t thumbnailEnd = static_cast<uint64_t>(save.info.thumbnailOffset) + save.info.thumbnailSize;
+        if (save.info.thumbnailOffset < save.chunksEnd || thumbnailEnd > save.data.size()) {
+            save.problems.push_back("thumbnail lies outside the file or overlaps the chunks");
+        } else {
+            end = static_cast<size_t>(thumbnailEnd);
+        }
+    }
+    if (save.chunks.size() == save.info.chunkCount && end < save.data.size()) {
+        save.problems.push_back(std::to_string(save.data.size() - end) + " unexpected bytes at the end of the file");
+    }
+    return true;
+}
+
+// Deserializes every intact chunk into its system, checking each one is read exactly
+void DecodeChunks(SaveLoadSystem& saveLoad, BinarySave& save) {
+    if (save.chunks.empty()) {
+        return;
+    }
+    
+    size_t first = 0;
+    StringTable strings;
+    bool pooledStrings = save.info.formatVersion >= 5;
+    if (pooledStrings) {
+        if (save.chunks.empty() || save.chunks[0].systemName != StringTableChunkName) {
+            save.problems.push_back("string table chunk is missing");
+            return;
+        }
+        const ChunkEntry& table = save.chunks[0];
+        if (!table.checksumValid || !strings.Decode(save.Payload(table), table.size)) {
+            save.problems.push_back("string table can't be decoded");
+            return;
+        }
+        first = 1;
+    }
+    
+    for (size_t i = first; i < save.chunks.size(); ++i) {
+        const ChunkEntry& chunk = save.chunks[i];
+        if (!chunk.checksumValid) {
+            continue;
+        }
+        RPGSystem* system = saveLoad.GetSystemByName(chunk.systemName);
+        if (!system) {
+            save.problems.push_back("chunk of unknown system " + chunk.systemName);
+            continue;
+        }
+        
+        // Older schemas are upgraded the way a load would
+        const StringTable* table = pooledStrings ? &strings : nullptr;
+        std::vector<uint8_t> upgraded;
+        bool upgrade = chunk.schemaVersion != system->GetSchemaVersion();
+        if (upgrade && !saveLoad.UpgradeChunk(chunk.systemName, chunk.schemaVersion, system->GetSchemaVersion(), false,
+            save.Payload(chunk), chunk.size, table, upgraded)) {
+            save.problems.push_back(chunk.systemName + " can't be upgraded from schema " + std::to_string(chunk.schemaVersion));
+            continue;
+        }
+        
+        BinaryReader reader(upgrade ? upgraded.data() : save.Payload(chunk), upgrade ? upgraded.size() : chunk.size);
+        reader.SetStringTable(upgrade ? nullptr : table);
+        try {
+            system->Deserialize(reader);
+        } catch (const std::exception& e) {
+            save.problems.push_back(chunk.systemName + " failed to decode: " + e.what());
+            continue;
+        }
+        if (reader.HasFailed()) {
+            save.problems.push_back(chunk.systemName + " failed to decode: data ends early or is out of range");
+        } else if (reader.GetRemaining() > 0) {
+            save.problems.push_back(chunk.systemName + " left " + std::to_string(reader.GetRemaining()) + " bytes unread");
+        }
+    }
+}
+
+class SaveTool {
+public:
+    SaveTool() : m_plugin(SpawnParams{}) {
+        m_plugin.Initialize();
+        m_saveLoad = m_plugin.GetSystem<SaveLoadSystem>();
+    }
+    
+    ~SaveTool() {
+        m_plugin.Deinitialize();
+    }
+    
+    void SetParallel(bool parallel) { m_saveLoad->SetParallelSerialization(parallel); }
+    
+    int Info(const std::string& path);
+    int Dump(const std::string& path, const std::string& systemName);
+    int Validate(const std::string& path);
+    int Convert(const std::string& input, const std::string& output);
+    int Bench(const std::string& path, int iterations, SerializationFormat saveFormat, bool csv);
+
+private:
+    bool Load(const std::string& path, SerializationFormat format);
+    
+    LinenFlax m_plugin;
+    SaveLoadSystem* m_saveLoad = nullptr;
+};
+
+bool SaveTool::Load(const std::string& path, SerializationFormat format) {
+    if (!fs::exists(path)) {
+        std::fprintf(stderr, "%s: no such file\n", path.c_str());
+        return false;
+    }
+    if (!m_saveLoad->LoadGame(path, format)) {
+        std::fprintf(stderr, "%s: failed to load\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+int SaveTool::Info(const std::string& path) {
+    SerializationFormat format;
+    if (!FormatFromPath(path, format)) {
+        std::fprintf(stderr, "%s: unknown save extension\n", path.c_str());
+        return 2;
+    }
+    std::error_code error;
+    uint64_t fileSize = fs::file_size(path, error);
+    if (error) {
+        std::fprintf(stderr, "%s: no such file\n", path.c_str());
+        return 1;
+    }
+    std::printf("File:     %s (%s, %s)\n", path.c_str(), FormatName(format), FormatBytes(fileSize).c_str());
+    
+    if (format != SerializationFormat::Binary) {
+        // Text and JSON saves have no per-system sections of known size, so report what
+        // each system takes once loaded and encoded in binary
+        if (!Load(path, format)) {
+            return 1;
+        }
+        std::printf("\n%-32s %12s\n", "System", "Binary size");
+        for (const auto& systemName : m_saveLoad->GetSerializableSystems()) {
+            BinaryWriter writer;
+            if (RPGSystem* system = m_saveLoad->GetSystemByName(systemName)) {
+                system->Serialize(writer);
+            }
+            std::printf("%-32s %12s\n", systemName.c_str(), FormatBytes(writer.GetSize()).c_str());
+        }
+        return 0;
+    }
+    
+    BinarySave save;
+    bool readable = ReadBinarySave(path, save);
+    if (save.legacy) {
+        std::printf("Format:   legacy (before chunked saves), no header or checksums\n");
+        return 0;
+    }
+    if (readable) {
+        const SaveSlotInfo& info = save.info;
+        std::printf("Format:   version %u, header %u bytes, generation %u\n", info.formatVersion, info.headerSize, info.generation);
+        if (info.hasMetadata) {
+            std::printf("Saved:    %s, played %.0f s\n", FormatTimestamp(info.timestamp).c_str(), info.playtimeSeconds);
+            std::printf("Game:     day %d/%d/%d %02d:%02d, character level %d\n", info.gameDay, info.gameMonth, info.gameYear,
+                info.gameHour, info.gameMinute, info.characterLevel);
+            if (info.thumbnailSize > 0) {
+                std::printf("Thumbnail: %s at offset %u\n", FormatBytes(info.thumbnailSize).c_str(), info.thumbnailOffset);
+            }
+        }
+        
+        std::printf("\n%-32s %12s %7s %7s  %s\n", "Chunk", "Size", "Share", "Schema", "Checksum");
+        for (const auto& chunk : save.chunks) {
+            std::printf("%-32s %12s %6.1f%% %7u  %08x %s\n", chunk.systemName.c_str(), FormatBytes(chunk.size).c_str(),
+                fileSize > 0 ? 100.0 * chunk.size / fileSize : 0.0, chunk.schemaVersion, chunk.checksum,
+                chunk.checksumValid ? "ok" : "MISMATCH");
+        }
+    }
+    
+    // Incremental saves keep their delta records in a journal next to the base
+    std::string deltaPath = fs::path(path).replace_extension(".delta").string();
+    if (fs::exists(deltaPath)) {
+        std::printf("\nJournal:  %s (%s), replayed on load\n", deltaPath.c_str(), FormatBytes(fs::file_size(deltaPath, error)).c_str());
+    }
+    
+    for (const auto& problem : save.problems) {
+        std::printf("Problem:  %s\n", problem.c_str());
+    }
+    return save.problems.empty() ? 0 : 1;
+}
+
+int SaveTool::Dump(const std::string& path, const std::string& systemName) {
+    SerializationFormat format;
+    if (!FormatFromPath(path, format)) {
+        std::fprintf(stderr, "%s: unknown save extension\n", path.c_str());
+        return 2;
+    }
+    if (!Load(path, format)) {
+        return 1;
+    }
+    
+    std::vector<std::string> systemNames = m_saveLoad->GetSerializableSystems();
+    if (!systemName.empty()) {
+        if (std::find(systemNames.begin(), systemNames.end(), systemName) == systemNames.end()) {
+            std::fprintf(stderr, "Unknown system: %s\n", systemName.c_str());
+            return 2;
+        }
+        systemNames = { systemName };
+    }
+    
+    // Same layout as a JSON save, so a dump can be diffed against one
+    JsonWriter writer;
+    writer.BeginObject();
+    for (const auto& name : systemNames) {
+        if (RPGSystem* system = m_saveLoad->GetSystemByName(name)) {
+            writer.BeginObject(name);
+            system->SerializeToJson(writer);
+            writer.EndObject();
+        }
+    }
+    writer.EndObject();
+    std::fwrite(writer.GetBuffer().data(), 1, writer.GetBuffer().size(), stdout);
+    std::printf("\n");
+    return 0;
+}
+
+int SaveTool::Validate(const std::string& path) {
+    SerializationFormat format;
+    if (!FormatFromPath(path, format)) {
+        std::fprintf(stderr, "%s: unknown save extension\n", path.c_str());
+        return 2;
+    }
+    
+    // What the systems warn about while loading counts as a problem too, e.g. a quest
+    // state out of range, which a text or JSON load resets rather than rejects. Legacy
+    // saves always load with a warning, so theirs are only printed.
+    std::vector<std::string> problems;
+    std::vector<std::string> warnings;
+    ToolLog::captured = &warnings;
+    if (format == SerializationFormat::Binary) {
+        BinarySave save;
+        bool readable = ReadBinarySave(path, save);
+        if (save.legacy) {
+            ToolLog::captured = nullptr;
+        } else if (readable) {
+            DecodeChunks(*m_saveLoad, save);
+        }
+        problems = std::move(save.problems);
+    }
+    
+    // A full load on top: replays the delta journal and checks what the game would
+    if (problems.empty() && !Load(path, format)) {
+        problems.push_back("the game fails to load it (run with --verbose for details)");
+    }
+    ToolLog::captured = nullptr;
+    problems.insert(problems.begin(), warnings.begin(), warnings.end());
+    
+    for (const auto& problem : problems) {
+        std::printf("%s: %s\n", path.c_str(), problem.c_str());
+    }
+    std::printf("%s: %s\n", path.c_str(), problems.empty() ? "valid" : "INVALID");
+    return problems.empty() ? 0 : 1;
+}
+
+int SaveTool::Convert(const std::string& input, const std::string& output) {
+    SerializationFormat inputFormat;
+    SerializationFormat outputFormat;
+    if (!FormatFromPath(input, inputFormat) || !FormatFromPath(output, outputFormat)) {
+        std::fprintf(stderr, "Saves must end in .bin, .txt or .json\n");
+        return 2;
+    }
+    if (!Load(input, inputFormat)) {
+        return 1;
+    }
+    
+    // Only binary saves carry a thumbnail
+    std::vector<uint8_t> thumbnail;
+    if (inputFormat == SerializationFormat::Binary) {
+        ReadSaveThumbnail(input, thumbnail);
+    }
+    m_saveLoad->SetSaveThumbnail(std::move(thumbnail));
+    
+    if (!m_saveLoad->SaveGame(output, outputFormat)) {
+        std::fprintf(stderr, "%s: failed to write\n", output.c_str());
+        return 1;
+    }
+    std::printf("%s (%s) -> %s (%s)\n", input.c_str(), FormatName(inputFormat), output.c_str(), FormatName(outputFormat));
+    return 0;
+}
+
+int SaveTool::Bench(const std::string& path, int iterations, SerializationFormat saveFormat, bool csv) {
+    SerializationFormat loadFormat;
+    if (!FormatFromPath(path, loadFormat)) {
+        std::fprintf(stderr, "%s: unknown save extension\n", path.c_str());
+        return 2;
+    }
+    // Warm up, and make sure the save loads at all
+    if (!Load(path, loadFormat)) {
+        return 1;
+    }
+    
+    std::string extension = saveFormat == SerializationFormat::Binary ? ".bin" : saveFormat == SerializationFormat::Text ? ".txt" : ".json";
+    std::string output = (fs::temp_directory_path() / ("linen-save-tool-bench" + extension)).string();
+    
+    struct Samples {
+        std::vector<double> ms;
+        AllocationSample allocations;
+    };
+    Samples loads;
+    Samples saves;
+    for (int i = 0; i < iterations; ++i) {
+        AllocationSample before = AllocationSample::Now();
+        auto start = Clock::now();
+        bool loaded = m_saveLoad->LoadGame(path, loadFormat);
+        loads.ms.push_back(ElapsedMs(start));
+        AllocationSample used = before.Since();
+        loads.allocations.count += used.count;
+        loads.allocations.bytes += used.bytes;
+        
+        before = AllocationSample::Now();
+        start = Clock::now();
+        bool saved = m_saveLoad->SaveGame(output, saveFormat);
+        saves.ms.push_back(ElapsedMs(start));
+        used = before.Since();
+        saves.allocations.count += used.count;
+        saves.allocations.bytes += used.bytes;
+        
+        if (!loaded || !saved) {
+            std::fprintf(stderr, "Iteration %d failed to %s\n", i, loaded ? "save" : "load");
+            return 1;
+        }
+    }
+    
+    std::error_code error;
+    uint64_t inputSize = fs::file_size(path, error);
+    uint64_t outputSize = fs::file_size(output, error);
+    fs::remove(output, error);
+    
+    auto report = [&](const char* name, Samples& samples, uint64_t bytes, SerializationFormat format) {
+        std::sort(samples.ms.begin(), samples.ms.end());
+        double total = 0.0;
+        for (double ms : samples.ms) {
+            total += ms;
+        }
+        double mean = total / samples.ms.size();
+        double median = samples.ms[samples.ms.size() / 2];
+        double megabytesPerSecond = bytes / (1024.0 * 1024.0) / (median / 1000.0);
+        double allocationsPerRun = static_cast<double>(samples.allocations.count) / iterations;
+        double bytesPerRun = static_cast<double>(samples.allocations.bytes) / iterations;
+        if (csv) {
+            std::printf("%s,%s,%llu,%d,%.3f,%.3f,%.3f,%.3f,%.1f,%.0f,%.0f\n", name, FormatName(format),
+                static_cast<unsigned long long>(bytes), iterations, samples.ms.front(), median, mean, samples.ms.back(),
+                megabytesPerSecond, allocationsPerRun, bytesPerRun);
+        } else {
+            std::printf("%-5s %-7s %10s  min %8.2f  median %8.2f  mean %8.2f  max %8.2f ms  %8.1f MB/s  %10.0f allocs  %10s\n",
+                name, FormatName(format), FormatBytes(bytes).c_str(), samples.ms.front(), median, mean, samples.ms.back(),
+                megabytesPerSecond, allocationsPerRun, FormatBytes(static_cast<uint64_t>(bytesPerRun)).c_str());
+        }
+    };
+    
+    if (csv) {
+        std::printf("operation,format,bytes,iterations,min_ms,median_ms,mean_ms,max_ms,mb_per_s,allocations,allocated_bytes\n");
+    } else {
+        std::printf("%s: %d load/save cycles (throughput from the median, allocations per operation)\n", path.c_str(), iterations);
+    }
+    report("load", loads, inputSize, loadFormat);
+    report("save", saves, outputSize, saveFormat);
+    return 0;
+}
+
+void PrintUsage() {
+    std::fprintf(stderr,
+        "Usage: linen-save-tool [--verbose] [--serial] <command> <arguments>\n"
+        "\n"
+        "  info <save>                    Header, chunk table and size of every system\n"
+        "  dump <save> [--system <name>]  Contents of every system (or one), as JSON\n"
+        "  validate <save>                Structure, checksums and a decode of every chunk\n"
+        "  convert <input> <output>       Between .bin, .txt and .json, picked by extension\n"
+        "  bench <save> [--iterations <n>] [--format bin|txt|json] [--csv]\n"
+        "                                 Load/save cycles with timings, throughput and allocations\n"
+        "\n"
+        "  --verbose  Show the systems' own log output\n"
+        "  --serial   Encode and decode chunks on one thread\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> arguments;
+    bool parallel = true;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--verbose") {
+            ToolLog::verbose = true;
+        } else if (argument == "--serial") {
+            parallel = false;
+        } else if (argument == "--help" || argument == "-h") {
+            PrintUsage();
+            return 0;
+        } else {
+            arguments.push_back(argument);
+        }
+    }
+    if (arguments.size() < 2) {
+        PrintUsage();
+        return 2;
+    }
+    
+    const std::string& command = arguments[0];
+    const std::string& path = arguments[1];
+    
+    // Options after the save path, as name/value pairs
+    std::string systemName;
+    int iterations = 20;
+    SerializationFormat benchFormat = SerializationFormat::Binary;
+    bool csv = false;
+    std::string output;
+    for (size_t i = 2; i < arguments.size(); ++i) {
+        const std::string& option = arguments[i];
+        bool hasValue = i + 1 < arguments.size();
+        if (option == "--system" && hasValue) {
+            systemName = arguments[++i];
+        } else if (option == "--iterations" && hasValue) {
+            iterations = std::max(1, std::atoi(arguments[++i].c_str()));
+        } else if (option == "--format" && hasValue) {
+            if (!FormatFromName(arguments[++i], benchFormat)) {
+                std::fprintf(stderr, "Unknown format: %s\n", arguments[i].c_str());
+                return 2;
+            }
+        } else if (option == "--csv") {
+            csv = true;
+        } else if (command == "convert" && output.empty()) {
+            output = option;
+        } else {
+            std::fprintf(stderr, "Unexpected argument: %s\n", option.c_str());
+            return 2;
+        }
+    }
+    
+    try {
+        SaveTool tool;
+        tool.SetParallel(parallel);
+        if (command == "info") {
+            return tool.Info(path);
+        } else if (command == "dump") {
+            return tool.Dump(path, systemName);
+        } else if (command == "validate") {
+            return tool.Validate(path);
+        } else if (command == "convert" && !output.empty()) {
+            return tool.Convert(path, output);
+        } else if (command == "bench") {
+            return tool.Bench(path, iterations, benchFormat, csv);
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Error: %s\n", e.what());
+        return 1;
+    }
+    
+    PrintUsage();
+    return 2;
+}
+// ^ LinenSaveTool.cpp
\ No newline at end of file
@@ -0,0 +1,82 @@
+// v Log.h
+#pragma once
+
+// Stand-in for the engine's logging, so the plugin sources build into the save tool
+// without the engine. Warnings and errors go to stderr, or to ToolLog::captured, and
+// Info only in verbose mode.
+
+#include <string>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define TEXT(x) x
+
+// Engine string; the plugin only builds these from UTF-8 text
+struct String {
+    std::string value;
+    
+    String() = default;
+    String(const char* text) : value(text ? text : "") {}
+    
+    String& operator+=(const String& other) {
+        value += other.value;
+        return *this;
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& stream, const String& text) {
+    return stream << text.value;
+}
+
+namespace ToolLog {
+
+enum class Level { Info, Warning, Error };
+
+inline bool verbose = false;
+
+// When set, warnings and errors are collected here instead of printed
+inline std::vector<std::string>* captured = nullptr;
+
+template<typename T>
+std::string ToText(const T& value) {
+    std::ostringstream stream;
+    stream << value;
+    return stream.str();
+}
+
+// Replaces {0}, {1}, ... in 'format' with the arguments, like the engine's LOG
+template<typename... Args>
+void Write(Level level, const char* format, const Args&... args) {
+    if (level == Level::Info && !verbose) {
+        return;
+    }
+    
+    std::vector<std::string> values = { ToText(args)... };
+    std::string message;
+    for (const char* c = format; *c; ++c) {
+        const char* close = *c == '{' ? std::strchr(c, '}') : nullptr;
+        size_t index = close ? std::strtoul(c + 1, nullptr, 10) : 0;
+        if (close && index < values.size()) {
+            message += values[index];
+            c = close;
+        } else {
+            message += *c;
+        }
+    }
+    
+    if (level != Level::Info && captured) {
+        captured->push_back(message);
+        return;
+    }
+    
+    static const char* const names[] = { "Info", "Warning", "Error" };
+    std::fprintf(stderr, "[%s] %s\n", names[static_cast<int>(level)], message.c_str());
+}
+
+} // namespace ToolLog
+
+#define LOG(level, format, ...) ::ToolLog::Write(::ToolLog::Level::level, format, ##__VA_ARGS__)
+// ^ Log.h
@@ -0,0 +1,44 @@
+// v GamePlugin.h
+#pragma once
+
+// Stand-in for the engine's plugin base class and scripting macros, so LinenFlax can
+// host the systems inside the save tool
+
+#include "Engine/Core/Log.h"
+
+#define API_CLASS(...)
+#define LINENFLAX_API
+#define DECLARE_SCRIPTING_TYPE(type) public: type(const SpawnParams& params);
+
+struct SpawnParams {};
+
+struct Version {
+    Version() = default;
+    Version(int major, int minor, int build) : Major(major), Minor(minor), Build(build) {}
+    
+    int Major = 0;
+    int Minor = 0;
+    int Build = 0;
+};
+
+struct PluginDescription {
+    String Name;
+    String Category;
+    String Description;
+    String Author;
+    String RepositoryUrl;
+    ::Version Version;
+};
+
+class GamePlugin {
+public:
+    explicit GamePlugin(const SpawnParams&) {}
+    virtual ~GamePlugin() = default;
+    
+    virtual void Initialize() {}
+    virtual void Deinitialize() {}
+
+protected:
+    PluginDescription _description;
+};
+// ^ GamePlugin.h